@@ -25,13 +25,18 @@
 
 
 
+#include <cstdio>
+
 #ifdef TARGET_OS_WIN32
 #include <windows.h>
 #include <sys/stat.h>
 #define PATHSEP '\\'
 #else
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #define PATHSEP '/'
 #endif
 
@@ -138,6 +143,96 @@ bool mkdir(std::string const & filename, bool recurse)
 
 
 
+MappedFile::MappedFile() : _data(NULL), _size(0), _buffer(), _isMapped(false), _isOpen(false)
+{
+
+}
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(std::string const & filename)
+{
+	close();
+
+	#ifndef TARGET_OS_WIN32
+	int fd = ::open(filename.c_str(), O_RDONLY);
+
+	if (fd == -1)
+		return false;
+
+	struct stat stat_data;
+
+	if (fstat(fd, &stat_data) != 0 || S_ISDIR(stat_data.st_mode))
+	{
+		::close(fd);
+		return false;
+	}
+
+	_size   = stat_data.st_size;
+	_isOpen = true;
+
+	// mmap refuses zero-length mappings, but there's nothing to read anyway.
+	if (_size != 0)
+	{
+		void * map = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (map != MAP_FAILED)
+		{
+			_data     = static_cast<char const *>(map);
+			_isMapped = true;
+		}
+	}
+
+	::close(fd);
+
+	if (_isMapped || _size == 0)
+		return true;
+
+	// Not something that can be mapped (a pipe, perhaps). Fall through to
+	// reading it the normal way.
+	_isOpen = false;
+	_size   = 0;
+	#endif
+
+	FILE * file = fopen(filename.c_str(), "rb");
+
+	if (file == NULL)
+		return false;
+
+	char   readBuffer[4096];
+	size_t readSize;
+
+	while ((readSize = fread(readBuffer, 1, sizeof(readBuffer), file)) != 0)
+		_buffer.insert(_buffer.end(), readBuffer, readBuffer + readSize);
+
+	fclose(file);
+
+	_data   = _buffer.empty() ? NULL : &_buffer[0];
+	_size   = _buffer.size();
+	_isOpen = true;
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	#ifndef TARGET_OS_WIN32
+	if (_isMapped)
+		munmap(const_cast<char *>(_data), _size);
+	#endif
+
+	std::vector<char>().swap(_buffer);
+
+	_data     = NULL;
+	_size     = 0;
+	_isMapped = false;
+	_isOpen   = false;
+}
+
+
+
 }
 
 
@@ -24,6 +24,7 @@
 #ifndef IO_H
 #define IO_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,54 @@ bool mkdir(std::string const & filename, bool recurse = false);
 
 
 
+/*
+	Read-only view of an entire file. Where possible, the file is mapped into
+	memory. Otherwise, it is read into an internal buffer in one go.
+*/
+class MappedFile
+{
+	public:
+		MappedFile();
+		~MappedFile();
+
+		bool open(std::string const & filename);
+		void close();
+
+		char const * data() const;
+		size_t size() const;
+
+		bool operator ! () const;
+
+	private:
+		MappedFile(MappedFile const &);
+		MappedFile & operator = (MappedFile const &);
+
+		char const * _data;
+		size_t _size;
+
+		std::vector<char> _buffer;
+
+		bool _isMapped;
+		bool _isOpen;
+};
+
+inline char const * MappedFile::data() const
+{
+	return _data;
+}
+
+inline size_t MappedFile::size() const
+{
+	return _size;
+}
+
+inline bool MappedFile::operator ! () const
+{
+	return !_isOpen;
+}
+
+
+
 }
 
 #endif /* IO_H */
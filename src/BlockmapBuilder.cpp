@@ -0,0 +1,321 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+*/
+
+#include "BlockmapBuilder.hpp"
+
+#include "global_object.hpp"
+#include "options.hpp"
+#include "types.hpp"
+
+#include "LevelObject/LevelObject.hpp"
+
+#include "types/binary.hpp"
+
+#include "../common/foreach.hpp"
+
+#include <map>
+#include <utility>
+
+#if USE_THREADS
+#include <thread>
+#endif
+
+
+
+static long const blockmap_block = 128;
+
+// Linedefs at which they are binned on threads.
+static size_t const blockmap_parallel_lines = 4096;
+
+static const name_t name_v1("v1");
+static const name_t name_v2("v2");
+static const name_t name_x ("x");
+static const name_t name_y ("y");
+
+
+
+// One thread's share of the linedefs.
+struct BlockmapBuilder::Bin
+{
+	BlockmapBuilder const * builder;
+
+	size_t begin, end;
+
+	std::vector<std::vector<size_t> > blocks;
+};
+
+
+
+static void blockmap_put_16(std::string & out, unsigned long value)
+{
+	out += static_cast<char>((value     ) & 0xFF);
+	out += static_cast<char>((value >> 8) & 0xFF);
+}
+
+static long blockmap_get(LevelObject & object, name_t const & name, long value)
+{
+	return object.hasObject(name) ? convert<sword_t, obj_t>(object.getObject(name)).makeInt() : value;
+}
+
+static long blockmap_get_index(LevelObject & object, name_t const & name)
+{
+	return object.hasObject(name) ? convert<uword_t, obj_t>(object.getObject(name)).makeInt() : 0xFFFF;
+}
+
+
+
+BlockmapBuilder::BlockmapBuilder() : _originX(0), _originY(0), _columns(0), _rows(0)
+{
+
+}
+
+void BlockmapBuilder::bin(Bin * bin)
+{
+	BlockmapBuilder const & builder = *bin->builder;
+
+	bin->blocks.resize(builder._columns * builder._rows);
+
+	for (size_t index = bin->begin; index < bin->end; ++index)
+	{
+		Line const & line = builder._lines[index];
+
+		if (!line.valid) continue;
+
+		long left   = (line.x1 < line.x2 ? line.x1 : line.x2) - builder._originX;
+		long right  = (line.x1 > line.x2 ? line.x1 : line.x2) - builder._originX;
+		long bottom = (line.y1 < line.y2 ? line.y1 : line.y2) - builder._originY;
+		long top    = (line.y1 > line.y2 ? line.y1 : line.y2) - builder._originY;
+
+		long dx = line.x2 - line.x1;
+		long dy = line.y2 - line.y1;
+
+		for (long row = bottom / blockmap_block; row <= top / blockmap_block; ++row)
+		{
+			// The side of each corner is (x - x1) * dy - (y - y1) * dx. With
+			// the x and y terms for both edges, all four are differences of
+			// them, and the line touches the block unless all four have the
+			// same sign.
+			long long y0 = row * blockmap_block + builder._originY - line.y1;
+			long long b0 = y0 * dx;
+			long long b1 = b0 + blockmap_block * dx;
+
+			long long bMin = b0 < b1 ? b0 : b1;
+			long long bMax = b0 < b1 ? b1 : b0;
+
+			for (long column = left / blockmap_block; column <= right / blockmap_block; ++column)
+			{
+				long long x0 = column * blockmap_block + builder._originX - line.x1;
+				long long a0 = x0 * dy;
+				long long a1 = a0 + blockmap_block * dy;
+
+				long long aMin = a0 < a1 ? a0 : a1;
+				long long aMax = a0 < a1 ? a1 : a0;
+
+				if (aMin - bMax > 0 || aMax - bMin < 0)
+					continue;
+
+				bin->blocks[row * builder._columns + column].push_back(index);
+			}
+		}
+	}
+}
+
+void BlockmapBuilder::build()
+{
+	std::vector<std::pair<long, long> > vertexes;
+
+	global_object_map_t::iterator vertexIt(global_object_map.find(type_t::type_vertex()));
+
+	if (vertexIt != global_object_map.end())
+	{
+		FOREACH_T(global_object_list_t, it, vertexIt->second)
+		{
+			LevelObject & object = **it;
+
+			if (object.getData().get_dataType() != any_t::OBJMAP_T) continue;
+
+			vertexes.push_back(std::make_pair(blockmap_get(object, name_x, 0), blockmap_get(object, name_y, 0)));
+		}
+	}
+
+	global_object_map_t::iterator linedefIt(global_object_map.find(type_t::type_linedef()));
+
+	if (linedefIt != global_object_map.end())
+	{
+		FOREACH_T(global_object_list_t, it, linedefIt->second)
+		{
+			LevelObject & object = **it;
+
+			if (object.getData().get_dataType() != any_t::OBJMAP_T) continue;
+
+			size_t v1 = blockmap_get_index(object, name_v1);
+			size_t v2 = blockmap_get_index(object, name_v2);
+
+			Line line;
+
+			line.valid = v1 < vertexes.size() && v2 < vertexes.size();
+
+			if (line.valid)
+			{
+				line.x1 = vertexes[v1].first;
+				line.y1 = vertexes[v1].second;
+				line.x2 = vertexes[v2].first;
+				line.y2 = vertexes[v2].second;
+			}
+
+			_lines.push_back(line);
+		}
+	}
+
+	// The blocks cover every linedef, with a margin like other builders.
+	bool found = false;
+	long right = 0, top = 0;
+
+	FOREACH_T_CONST(std::vector<Line>, it, _lines)
+	{
+		if (!it->valid) continue;
+
+		long lineLeft   = it->x1 < it->x2 ? it->x1 : it->x2;
+		long lineRight  = it->x1 > it->x2 ? it->x1 : it->x2;
+		long lineBottom = it->y1 < it->y2 ? it->y1 : it->y2;
+		long lineTop    = it->y1 > it->y2 ? it->y1 : it->y2;
+
+		if (!found || lineLeft   < _originX) _originX = lineLeft;
+		if (!found || lineBottom < _originY) _originY = lineBottom;
+		if (!found || lineRight  > right)    right    = lineRight;
+		if (!found || lineTop    > top)      top      = lineTop;
+
+		found = true;
+	}
+
+	if (!found) return;
+
+	_originX -= 8;
+	_originY -= 8;
+
+	_columns = (right - _originX) / blockmap_block + 1;
+	_rows    = (top   - _originY) / blockmap_block + 1;
+
+	size_t count = 1;
+
+	#if USE_THREADS
+	if (_lines.size() >= blockmap_parallel_lines)
+	{
+		count = option_jobs > 0 ? option_jobs : std::thread::hardware_concurrency();
+
+		if (count < 1)
+			count = 1;
+	}
+	#endif
+
+	std::vector<Bin> bins(count);
+
+	for (size_t index = 0; index < count; ++index)
+	{
+		bins[index].builder = this;
+		bins[index].begin   = _lines.size() *  index      / count;
+		bins[index].end     = _lines.size() * (index + 1) / count;
+	}
+
+	#if USE_THREADS
+	if (count > 1)
+	{
+		std::vector<std::thread> threads;
+
+		// This thread takes the first share.
+		for (size_t index = 1; index < count; ++index)
+			threads.push_back(std::thread(bin, &bins[index]));
+
+		bin(&bins[0]);
+
+		FOREACH_T(std::vector<std::thread>, it, threads)
+			it->join();
+	}
+	else
+	#endif
+		bin(&bins[0]);
+
+	// Each share has the linedefs after the one before, so joining them in
+	// order keeps every block's linedefs in order.
+	_blocks.swap(bins[0].blocks);
+
+	for (size_t index = 1; index < count; ++index)
+	{
+		for (size_t block = 0; block < _blocks.size(); ++block)
+		{
+			std::vector<size_t> const & lines = bins[index].blocks[block];
+
+			_blocks[block].insert(_blocks[block].end(), lines.begin(), lines.end());
+		}
+	}
+}
+
+bool BlockmapBuilder::write(std::string & blockmap) const
+{
+	if (_blocks.empty()) return true;
+
+	std::string offsets, lists;
+
+	// Offsets are in 16-bit words from the start of the lump.
+	size_t offset = 4 + _blocks.size();
+
+	std::map<std::vector<size_t>, size_t> shared;
+
+	FOREACH_T_CONST(std::vector<std::vector<size_t> >, it, _blocks)
+	{
+		std::map<std::vector<size_t>, size_t>::iterator sharedIt(shared.find(*it));
+
+		if (sharedIt != shared.end())
+		{
+			blockmap_put_16(offsets, sharedIt->second);
+			continue;
+		}
+
+		if (offset > 0xFFFF) return false;
+
+		shared[*it] = offset;
+		blockmap_put_16(offsets, offset);
+
+		blockmap_put_16(lists, 0);
+
+		FOREACH_T_CONST(std::vector<size_t>, line, *it)
+			blockmap_put_16(lists, *line);
+
+		blockmap_put_16(lists, 0xFFFF);
+
+		offset += it->size() + 2;
+	}
+
+	blockmap_put_16(blockmap, _originX);
+	blockmap_put_16(blockmap, _originY);
+	blockmap_put_16(blockmap, _columns);
+	blockmap_put_16(blockmap, _rows);
+
+	blockmap += offsets;
+	blockmap += lists;
+
+	return true;
+}
+
+
+
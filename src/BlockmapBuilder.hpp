@@ -0,0 +1,82 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Builds BLOCKMAP for the binary map formats, for --do-blockmap. Each
+	linedef is put in every 128 unit block that it touches. Maps with many
+	linedefs have them spread over --jobs threads.
+
+	Blocks with the same linedefs share a list, to keep the lump small.
+
+	2026/10/17 - Original version.
+*/
+
+#ifndef BLOCKMAPBUILDER_H
+#define BLOCKMAPBUILDER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+
+class BlockmapBuilder
+{
+	public:
+		BlockmapBuilder();
+
+		/*
+			Builds the blockmap from global_object_map, which must have been
+			compacted. Linedefs with invalid vertices are left out.
+		*/
+		void build();
+
+		/*
+			Returns false, and leaves blockmap empty, if the blockmap is too
+			big for the lump's 16-bit offsets.
+		*/
+		bool write(std::string & blockmap) const;
+
+	private:
+		struct Line
+		{
+			long x1, y1, x2, y2;
+
+			bool valid;
+		};
+
+		struct Bin;
+
+		static void bin(Bin * bin);
+
+		std::vector<Line> _lines;
+
+		long _originX, _originY;
+		size_t _columns, _rows;
+
+		// The linedefs in each block, row by row.
+		std::vector<std::vector<size_t> > _blocks;
+};
+
+
+
+#endif /* BLOCKMAPBUILDER_H */
+
+
+
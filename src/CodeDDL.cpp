@@ -0,0 +1,95 @@
+/* Copyright (C) 2011 David Hill
+**
+** This file is part of DH-dlc.
+**
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* CodeDDL.cpp
+**
+** Defines the CodeDDL methods.
+*/
+
+#include "CodeDDL.hpp"
+
+#include "profile.hpp"
+#include "SourceStream.hpp"
+
+#include "exceptions/CompilerException.hpp"
+
+#include "../common/foreach.hpp"
+
+
+
+CodeDDL::CodeDDL(std::string const & data) : _data(data), _statements(), _count(0), _sourceFile(NULL), _sourceLine(0), _isCompiled(false), _isComplete(false)
+{
+	if (ProfileSource::enabled)
+		ProfileSource::locate(_data, _sourceFile, _sourceLine);
+}
+CodeDDL::~CodeDDL()
+{
+	FOREACH_T(std::vector<Statement>, it, _statements)
+		delete it->code;
+}
+
+// Errors are not thrown here, since the statements before them still need
+// to be run first. LevelObject::addData picks up from _count instead.
+void CodeDDL::compile() const
+{
+	if (_isCompiled) return;
+
+	_isCompiled = true;
+
+	SourceStream   ss(_data.data(), _data.size());
+	SourceTokenDDL st;
+
+	try
+	{
+		while (ss)
+		{
+			st.clear();
+			ss >> st;
+
+			++_count;
+
+			if (st.empty()) continue;
+
+			Statement statement;
+			statement.st   = st;
+			statement.line = ss.getLineCount();
+			statement.code = NULL;
+
+			_statements.push_back(statement);
+		}
+	}
+	catch (CompilerException &)
+	{
+		return;
+	}
+
+	_isComplete = true;
+}
+
+CodeDDL const & CodeDDL::getCode(size_t index) const
+{
+	Statement & statement = _statements[index];
+
+	if (!statement.code)
+		statement.code = new CodeDDL(statement.st.getData());
+
+	return *statement.code;
+}
+
+
+
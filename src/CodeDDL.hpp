@@ -0,0 +1,90 @@
+/* Copyright (C) 2011 David Hill
+**
+** This file is part of DH-dlc.
+**
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* CodeDDL.hpp
+**
+** Defines the CodeDDL class.
+**
+** A DDL block split into its statements. The text is only read the first
+** time the block is run, and the block of each statement is itself a
+** CodeDDL, made when first needed. So a block that is run many times (#for
+** bodies, functions, compound objects) is only read once.
+**
+** With --profile-source, a block also knows which file and line it starts
+** on, from the statement it was made in.
+*/
+
+#ifndef HPP_CodeDDL_
+#define HPP_CodeDDL_
+
+#include "SourceToken.hpp"
+
+#include <string>
+#include <vector>
+
+
+
+class CodeDDL
+{
+public:
+	explicit CodeDDL(std::string const & data);
+	~CodeDDL();
+
+	std::string const & getData() const {return _data;}
+
+	friend class LevelObject;
+
+private:
+	struct Statement
+	{
+		SourceTokenDDL st;
+
+		// Line of the source after the statement, for errors.
+		int line;
+
+		CodeDDL * code;
+	};
+
+	CodeDDL(CodeDDL const &);
+
+	void compile() const;
+
+	CodeDDL const & getCode(size_t index) const;
+
+	CodeDDL & operator = (CodeDDL const &);
+
+	std::string _data;
+
+	mutable std::vector<Statement> _statements;
+
+	// Number of tokens read, including empty ones. If reading stopped on
+	// an error, the rest has to come from the text.
+	mutable size_t _count;
+
+	// For --profile-source. NULL if unknown.
+	std::string const * _sourceFile;
+	int                 _sourceLine;
+
+	mutable unsigned _isCompiled : 1;
+	mutable unsigned _isComplete : 1;
+};
+
+
+
+#endif//HPP_CodeDDL_
+
@@ -0,0 +1,416 @@
+/* Copyright (C) 2011 David Hill
+**
+** This file is part of DH-dlc.
+**
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* CodeDHLX.cpp
+**
+** Defines the CodeDHLX methods.
+**
+** Compiling never throws. Errors in the source have to wait until the
+** statement is run, so anything unexpected is left to the scanner as an
+** OP_INTERPRET for the rest of the block.
+*/
+
+#include "CodeDHLX.hpp"
+
+#include "options.hpp"
+
+#include "parsing/parsing.hpp"
+
+#include "../common/foreach.hpp"
+
+
+
+static size_t const npos = size_t(-1);
+
+
+
+// Returns the index after the token that closes the one at index.
+static size_t find_close(std::vector<SourceTokenDHLX> const & tokens, size_t index, size_t end, SourceTokenDHLX::TokenType typeOpen, SourceTokenDHLX::TokenType typeClose)
+{
+	if (index == end || tokens[index].getType() != typeOpen)
+		return npos;
+
+	int depth = 0;
+
+	for (; index != end; ++index)
+	{
+		SourceTokenDHLX::TokenType type(tokens[index].getType());
+
+		if (type == typeOpen) ++depth;
+		else if (type == typeClose) --depth;
+
+		if (!depth) return index + 1;
+	}
+
+	return npos;
+}
+
+// Returns the index after the next semicolon.
+static size_t find_semicolon(std::vector<SourceTokenDHLX> const & tokens, size_t index, size_t end)
+{
+	for (; index != end; ++index)
+	{
+		switch (tokens[index].getType())
+		{
+		case SourceTokenDHLX::TT_OP_SEMICOLON:
+			return index + 1;
+
+		case SourceTokenDHLX::TT_EOF:
+		case SourceTokenDHLX::TT_OP_BRACE_C:
+		case SourceTokenDHLX::TT_OP_BRACE_O:
+			return npos;
+
+		default:
+			break;
+		}
+	}
+
+	return npos;
+}
+
+// Returns the index after a block, the same as LevelObject::skipData.
+static size_t find_statement(std::vector<SourceTokenDHLX> const & tokens, size_t index, size_t end)
+{
+	for (; index != end; ++index)
+	{
+		switch (tokens[index].getType())
+		{
+		case SourceTokenDHLX::TT_OP_BRACE_O:
+			return find_close(tokens, index, end, SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C);
+
+		case SourceTokenDHLX::TT_OP_SEMICOLON:
+			return index + 1;
+
+		case SourceTokenDHLX::TT_EOF:
+			return npos;
+
+		default:
+			break;
+		}
+	}
+
+	return npos;
+}
+
+
+
+CodeDHLX::Name::Name() : name(""), sc(), isDynamic(false)
+{
+
+}
+
+name_t CodeDHLX::Name::get() const
+{
+	if (!isDynamic) return name;
+
+	SourceScannerDHLX nameSC(sc);
+
+	return parse_name(nameSC);
+}
+
+
+
+CodeDHLX::Op::Op(OpCode opIn) : op(opIn), data(), hasType(false), name(), base(), sc(), statement(), code(NULL), bodies()
+{
+
+}
+
+
+
+CodeDHLX::CodeDHLX(SourceScannerDHLX const & sc) : _ops()
+{
+	std::vector<SourceTokenDHLX> tokens;
+
+	SourceScannerDHLX in(sc);
+
+	for (SourceTokenDHLX st(in.get()); st.getType() != SourceTokenDHLX::TT_EOF; st = in.get())
+		tokens.push_back(st);
+
+	SourceScannerDHLX all(tokens);
+
+	compile(tokens, all, 0, tokens.size());
+}
+CodeDHLX::CodeDHLX(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end) : _ops()
+{
+	compile(tokens, all, begin, end);
+}
+CodeDHLX::~CodeDHLX()
+{
+	FOREACH_T(std::vector<Op>, it, _ops)
+	{
+		delete it->code;
+
+		for (size_t index = 0; index < it->bodies.size(); ++index)
+			delete it->bodies[index].second;
+	}
+}
+
+// Follows LevelObject::addData(SourceScannerDHLX).
+void CodeDHLX::compile(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end)
+{
+	// No opening brace means the block is a single statement.
+	if (begin == end || tokens[begin].getType() != SourceTokenDHLX::TT_OP_BRACE_O)
+	{
+		if (compileStatement(tokens, all, begin, end) == npos)
+		{
+			Op op(OP_INTERPRET);
+			op.sc = all.getrange(begin, end);
+			_ops.push_back(op);
+		}
+
+		return;
+	}
+
+	for (size_t index = begin + 1; index == end || tokens[index].getType() != SourceTokenDHLX::TT_OP_BRACE_C;)
+	{
+		size_t next = compileStatement(tokens, all, index, end);
+
+		if (next == npos)
+		{
+			Op op(OP_INTERPRET);
+			op.hasType = true;
+			op.sc      = all.getrange(index, end);
+			_ops.push_back(op);
+
+			return;
+		}
+
+		index = next;
+	}
+}
+
+// Follows parse_name(SourceScannerDHLX).
+size_t CodeDHLX::compileName(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end, Name & name)
+{
+	if (begin == end || tokens[begin].getType() != SourceTokenDHLX::TT_IDENTIFIER)
+		return npos;
+
+	size_t index = begin + 1;
+
+	while (index != end)
+	{
+		SourceTokenDHLX::TokenType type(tokens[index].getType());
+
+		if (type == SourceTokenDHLX::TT_OP_PERIOD)
+		{
+			if (++index == end || tokens[index].getType() != SourceTokenDHLX::TT_IDENTIFIER)
+				return npos;
+
+			++index;
+		}
+		else if (type == SourceTokenDHLX::TT_OP_BRACKET_O)
+		{
+			index = find_close(tokens, index, end, SourceTokenDHLX::TT_OP_BRACKET_O, SourceTokenDHLX::TT_OP_BRACKET_C);
+			name.isDynamic = true;
+		}
+		else if (type == SourceTokenDHLX::TT_OP_CMP_LT)
+		{
+			index = find_close(tokens, index, end, SourceTokenDHLX::TT_OP_CMP_LT, SourceTokenDHLX::TT_OP_CMP_GT);
+			name.isDynamic = true;
+		}
+		else
+			break;
+
+		if (index == npos) return npos;
+	}
+
+	name.sc = all.getrange(begin, index);
+
+	// Static names do not evaluate anything, so they can be made now.
+	if (!name.isDynamic)
+	{
+		SourceScannerDHLX nameSC(name.sc);
+		name.name = parse_name(nameSC);
+	}
+
+	return index;
+}
+
+// Compiles the statement at begin, returning the index after it. Follows
+// LevelObject::addObject(SourceScannerDHLX) and doCommand.
+size_t CodeDHLX::compileStatement(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end)
+{
+	if (begin == end) return npos;
+
+	switch (tokens[begin].getType())
+	{
+	case SourceTokenDHLX::TT_OP_SEMICOLON:
+		return begin + 1;
+
+	case SourceTokenDHLX::TT_OP_HASH:
+	{
+		size_t index = begin + 1;
+
+		if (index == end || tokens[index].getType() != SourceTokenDHLX::TT_IDENTIFIER)
+			return npos;
+
+		std::string command(tokens[index++].getData());
+
+		if (command == command_name_break() || command == command_name_continue())
+		{
+			if (index == end || tokens[index].getType() != SourceTokenDHLX::TT_OP_SEMICOLON)
+				return npos;
+
+			_ops.push_back(Op(command == command_name_break() ? OP_BREAK : OP_CONTINUE));
+
+			return index + 1;
+		}
+
+		if (command == command_name_else())
+		{
+			size_t next = find_statement(tokens, index, end);
+
+			if (next == npos) return npos;
+
+			Op op(OP_ELSE);
+			op.code = new CodeDHLX(tokens, all, index, next);
+			_ops.push_back(op);
+
+			return next;
+		}
+
+		// Where the expression stops is only known once it is parsed, so
+		// the block is compiled when first run.
+		if (command == command_name_if())
+		{
+			size_t next = find_statement(tokens, index, end);
+
+			if (next == npos) return npos;
+
+			Op op(OP_IF);
+			op.sc = all.getrange(index, next);
+			_ops.push_back(op);
+
+			return next;
+		}
+
+		if (command == command_name_while())
+		{
+			size_t cond = find_close(tokens, index, end, SourceTokenDHLX::TT_OP_PARENTHESIS_O, SourceTokenDHLX::TT_OP_PARENTHESIS_C);
+
+			if (cond == npos) return npos;
+
+			size_t next = find_close(tokens, cond, end, SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C);
+
+			if (next == npos) return npos;
+
+			Op op(OP_WHILE);
+			op.sc   = all.getrange(index, cond);
+			op.code = new CodeDHLX(tokens, all, cond, next);
+			_ops.push_back(op);
+
+			return next;
+		}
+
+		size_t next = find_semicolon(tokens, index, end);
+
+		if (next == npos) return npos;
+
+		Op op(command == command_name_return() ? OP_RETURN : OP_COMMAND);
+		op.data = command;
+		op.sc   = all.getrange(index, next);
+		_ops.push_back(op);
+
+		return next;
+	}
+
+	case SourceTokenDHLX::TT_IDENTIFIER:
+	{
+		Op op(OP_DECLARE);
+
+		// Whether it is actually a type is checked when run.
+		op.data    = tokens[begin].getData();
+		op.hasType = begin + 1 != end && tokens[begin + 1].getType() == SourceTokenDHLX::TT_IDENTIFIER;
+
+		size_t index = compileName(tokens, all, op.hasType ? begin + 1 : begin, end, op.name);
+
+		if (index == npos) return npos;
+
+		while (index != end && tokens[index].getType() == SourceTokenDHLX::TT_OP_COLON)
+		{
+			op.base.push_back(Name());
+
+			index = compileName(tokens, all, index + 1, end, op.base.back());
+
+			if (index == npos) return npos;
+		}
+
+		if (index == end) return npos;
+
+		size_t next;
+
+		switch (tokens[index].getType())
+		{
+		case SourceTokenDHLX::TT_OP_BRACE_O:
+			next = find_close(tokens, index, end, SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C);
+
+			if (next == npos) return npos;
+
+			op.op   = OP_BLOCK;
+			op.code = new CodeDHLX(tokens, all, index, next);
+
+			break;
+
+		case SourceTokenDHLX::TT_OP_EQUALS:
+			next = find_semicolon(tokens, index + 1, end);
+
+			if (next == npos) return npos;
+
+			op.op = OP_ASSIGN;
+			op.sc = all.getrange(index + 1, next);
+
+			break;
+
+		case SourceTokenDHLX::TT_OP_SEMICOLON:
+			next = index + 1;
+
+			break;
+
+		default:
+			return npos;
+		}
+
+		op.statement = all.getrange(begin, next);
+		_ops.push_back(op);
+
+		return next;
+	}
+
+	default:
+		return npos;
+	}
+}
+
+// sc is what is left of an OP_IF's tokens after the expression.
+CodeDHLX const & CodeDHLX::getBody(Op const & op, SourceScannerDHLX const & sc) const
+{
+	size_t size = sc.size();
+
+	for (size_t index = 0; index < op.bodies.size(); ++index)
+	{
+		if (op.bodies[index].first == size)
+			return *op.bodies[index].second;
+	}
+
+	op.bodies.push_back(std::make_pair(size, new CodeDHLX(sc)));
+
+	return *op.bodies.back().second;
+}
+
+
+
@@ -0,0 +1,124 @@
+/* Copyright (C) 2011 David Hill
+**
+** This file is part of DH-dlc.
+**
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* CodeDHLX.hpp
+**
+** Defines the CodeDHLX class.
+**
+** A DHLX block compiled into a list of statement ops, so that blocks which
+** are run many times (#while bodies, functions, compound objects) are only
+** split up once. Expressions are kept as token ranges, since how they parse
+** depends on the type they are parsed as. LevelObject::addData(CodeDHLX) is
+** what runs the ops.
+*/
+
+#ifndef HPP_CodeDHLX_
+#define HPP_CodeDHLX_
+
+#include "SourceScanner.hpp"
+#include "types.hpp"
+
+#include "LevelObject/LevelObjectName.hpp"
+
+#include <string>
+#include <vector>
+
+
+
+class CodeDHLX
+{
+public:
+	explicit CodeDHLX(SourceScannerDHLX const & sc);
+	~CodeDHLX();
+
+	friend class LevelObject;
+
+private:
+	enum OpCode
+	{
+		OP_ASSIGN,    // [type] name [: base...] = expression;
+		OP_BLOCK,     // [type] name [: base...] { block }
+		OP_BREAK,     // #break;
+		OP_COMMAND,   // #command ...;
+		OP_CONTINUE,  // #continue;
+		OP_DECLARE,   // [type] name [: base...];
+		OP_ELSE,      // #else block
+		OP_IF,        // #if expression block
+		OP_INTERPRET, // Anything else, left to the scanner.
+		OP_RETURN,    // #return expression;
+		OP_WHILE      // #while (expression) { block }
+	};
+
+	struct Name
+	{
+		Name();
+
+		name_t get() const;
+
+		name_t            name;
+		SourceScannerDHLX sc;
+
+		bool isDynamic;
+	};
+
+	struct Op
+	{
+		explicit Op(OpCode opIn);
+
+		OpCode op;
+
+		// Command name, or the first identifier of an object statement.
+		std::string data;
+
+		// For OP_INTERPRET, whether sc is the rest of a {} block.
+		bool hasType;
+
+		Name              name;
+		std::vector<Name> base;
+
+		// Expression tokens. Includes the ending semicolon, if any.
+		SourceScannerDHLX sc;
+
+		// The whole statement, for when the compiled form does not apply.
+		SourceScannerDHLX statement;
+
+		CodeDHLX * code;
+
+		// For OP_IF, the compiled blocks by number of tokens left after
+		// the expression.
+		mutable std::vector<std::pair<size_t, CodeDHLX *> > bodies;
+	};
+
+	CodeDHLX(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end);
+	CodeDHLX(CodeDHLX const &);
+
+	void compile(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end);
+	size_t compileName(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end, Name & name);
+	size_t compileStatement(std::vector<SourceTokenDHLX> const & tokens, SourceScannerDHLX const & all, size_t begin, size_t end);
+
+	CodeDHLX const & getBody(Op const & op, SourceScannerDHLX const & sc) const;
+
+	CodeDHLX & operator = (CodeDHLX const &);
+
+	std::vector<Op> _ops;
+};
+
+
+
+#endif//HPP_CodeDHLX_
+
@@ -29,6 +29,8 @@
 	2010/02/16 - Added addGlobal to the init list.
 	2010/02/16 - Removed the math functions that operated on LevelObjects.
 	2010/02/28 - Update for lo_type enum.
+	2026/10/17 - LevelObjects are allocated from an Arena.
+	2026/10/17 - LevelObjects are counted for --debug-stats.
 */
 
 #include "LevelObject.hpp"
@@ -36,12 +38,15 @@
 #include "LevelObjectMap.hpp"
 #include "LevelObjectName.hpp"
 
+#include "../arena.hpp"
+#include "../CodeDDL.hpp"
 #include "../compound_objects.hpp"
 #include "../global_object.hpp"
 #include "../math.hpp"
 #include "../options.hpp"
 #include "../scripts.hpp"
 #include "../SourceStream.hpp"
+#include "../stats.hpp"
 #include "../types.hpp"
 
 #include "../exceptions/InvalidTypeException.hpp"
@@ -64,8 +69,16 @@
 // The initialization list for the constructors are all basically the same.
 #define LevelObject_INIT_LIST(TYPE, DATA) _index(-1), _refCount(0), _data(DATA), _type(TYPE), _addGlobal(true), _isBreaked(false), _isCompounded(false), _isContinued(false), _isReturned(false)
 
-LevelObject::LevelObject() : LevelObject_INIT_LIST(, objmap_t()) {}
-LevelObject::LevelObject(LevelObject const & other) : LevelObject_INIT_LIST(other._type, other._data) {}
+// Objects are only counted once they are made, as the constructors can
+// throw, which does not run the destructor.
+LevelObject::LevelObject() : LevelObject_INIT_LIST(, objmap_t())
+{
+	stats_object_create(_type);
+}
+LevelObject::LevelObject(LevelObject const & other) : LevelObject_INIT_LIST(other._type, other._data)
+{
+	stats_object_create(_type);
+}
 LevelObject::LevelObject(type_t const type) : LevelObject_INIT_LIST(type, false)
 {
 	switch (_type.getNativeType())
@@ -97,10 +110,12 @@ LevelObject::LevelObject(type_t const type) : LevelObject_INIT_LIST(type, false)
 	case LevelObjectType::NT_SDWORD_T:    _data = sdword_t();    break;
 	case LevelObjectType::NT_UDWORD_T:    _data = udword_t();    break;
 	}
+
+	stats_object_create(_type);
 }
 LevelObject::LevelObject(type_t const type, any_t const & data) : LevelObject_INIT_LIST(type, data)
 {
-
+	stats_object_create(_type);
 }
 LevelObject::LevelObject(type_t const type, SourceScannerDHLX & sc) : LevelObject_INIT_LIST(type, false)
 {
@@ -133,6 +148,8 @@ LevelObject::LevelObject(type_t const type, SourceScannerDHLX & sc) : LevelObjec
 	case LevelObjectType::NT_SDWORD_T:    _data = parse<sdword_t>(sc);    break;
 	case LevelObjectType::NT_UDWORD_T:    _data = parse<udword_t>(sc);    break;
 	}
+
+	stats_object_create(_type);
 }
 LevelObject::LevelObject(type_t const type, std::string const & value) : LevelObject_INIT_LIST(type, false)
 {
@@ -165,8 +182,10 @@ LevelObject::LevelObject(type_t const type, std::string const & value) : LevelOb
 	case LevelObjectType::NT_SDWORD_T:    _data = parse<sdword_t>(value);    break;
 	case LevelObjectType::NT_UDWORD_T:    _data = parse<udword_t>(value);    break;
 	}
+
+	stats_object_create(_type);
 }
-LevelObject::LevelObject(type_t const type, std::string const & data, std::vector<std::string> const & base) : LevelObject_INIT_LIST(type, objmap_t())
+LevelObject::LevelObject(type_t const type, CodeDDL const & data, std::vector<std::string> const & base) : LevelObject_INIT_LIST(type, objmap_t())
 {
 	++_refCount;
 
@@ -178,16 +197,40 @@ LevelObject::LevelObject(type_t const type, std::string const & data, std::vecto
 	// (data.size() != 0), so that we don't compound if no keys have been set.
 	// Used to be (this->dataObject.size() != 0), but this would cause derived
 	// compound objects to be compounded even if they were no different.
-	if ((_type.getMode() == type_t::MODE_COMPOUNDOBJECT) && (!_isCompounded && data.size() != 0))
+	if ((_type.getMode() == type_t::MODE_COMPOUNDOBJECT) && (!_isCompounded && data.getData().size() != 0))
 	{
 		do_compound_object(_type.makeString(), this);
 		_isCompounded = true;
 	}
 
 	--_refCount;
+
+	stats_object_create(_type);
+}
+
+LevelObject::~LevelObject()
+{
+	stats_object_destroy(_type);
 }
 
-LevelObject::~LevelObject() {}
+
+
+static Arena & level_object_arena()
+{
+	static Arena arena("LevelObject", sizeof(LevelObject));
+
+	return arena;
+}
+
+// Nothing derives from LevelObject, so size is always sizeof(LevelObject).
+void * LevelObject::operator new(size_t)
+{
+	return level_object_arena().alloc();
+}
+void LevelObject::operator delete(void * p)
+{
+	if (p) level_object_arena().free(p);
+}
 
 
 
@@ -211,7 +254,7 @@ obj_t LevelObject::create(type_t const type, std::string const & value)
 {
 	return new LevelObject(type, value);
 }
-obj_t LevelObject::create(type_t const type, std::string const & data, std::vector<std::string> const & base)
+obj_t LevelObject::create(type_t const type, CodeDDL const & data, std::vector<std::string> const & base)
 {
 	return new LevelObject(type, data, base);
 }
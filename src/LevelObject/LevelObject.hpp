@@ -33,8 +33,11 @@
 #include <ostream>
 #include <vector>
 
+class CodeDDL;
+class CodeDHLX;
 class SourceTokenDDL;
 class SourceTokenDHLX;
+class TextWriter;
 
 
 
@@ -43,18 +46,22 @@ class LevelObject
 public:
 	void addBase(name_t const & base);
 
+	void addData(CodeDDL const & code, std::string const & name = "...");
+	void addData(CodeDHLX const & code);
 	void addData(SourceScannerDHLX & sc);
 	void addData(std::string const & data, std::string const & name = "...");
 	bool addDataIf(SourceScannerDHLX & sc);
-	bool addDataIf(std::string const & data, std::string const & value1, std::string const & value2, std::string const & op, std::string const & type = "", bool checkElse = false);
-	bool addDataIf(std::string const & data, std::vector<std::string> const & values, std::string const & op, bool checkElse = false);
+	bool addDataIf(CodeDDL const & data, std::string const & value1, std::string const & value2, std::string const & op, std::string const & type = "", bool checkElse = false);
+	bool addDataIf(CodeDDL const & data, std::vector<std::string> const & values, std::string const & op, bool checkElse = false);
 
 	void addObject(name_t const & name, obj_t);
 	void addObject(name_t const & name, SourceTokenDDL const &);
+	void addObject(name_t const & name, SourceTokenDDL const &, CodeDDL const & data);
 	void addObject(SourceScannerDHLX &);
 
 	void doCommand(std::string const & command, SourceScannerDHLX &);
 	void doCommand(std::string const & command, SourceTokenDDL const &);
+	void doCommand(std::string const & command, SourceTokenDDL const &, CodeDDL const & data);
 
 	obj_t getObject(name_t const & name);
 
@@ -64,12 +71,12 @@ public:
 	void setType(type_t const type, std::string const & value = "");
 
 	void encodeDoom     (std::ostream & out);
-	void encodeExtraData(std::ostream & out);
+	void encodeExtraData(std::ostream & out, bool doom);
 	void encodeHeretic  (std::ostream & out);
 	void encodeHexen    (std::ostream & out);
 	void encodeStrife   (std::ostream & out);
-	void encodeUDMF     (std::ostream & out, int depth = 0);
-	void encodeUSDF     (std::ostream & out, int depth = 0);
+	void encodeUDMF     (TextWriter   & out, int depth = 0);
+	void encodeUSDF     (TextWriter   & out, int depth = 0);
 
 	any_t const & getData() const {return _data;}
 
@@ -86,7 +93,7 @@ public:
 	static obj_t create(type_t const type, any_t const & data);
 	static obj_t create(type_t const type, SourceScannerDHLX & sc);
 	static obj_t create(type_t const type, std::string const & value);
-	static obj_t create(type_t const type, std::string const & data, std::vector<std::string> const & base);
+	static obj_t create(type_t const type, CodeDDL const & data, std::vector<std::string> const & base);
 
 	friend void add_object(name_t const &, obj_t);
 	friend int_s_t get_object_index(obj_t);
@@ -94,6 +101,7 @@ public:
 
 	friend std::ostream & operator << (std::ostream& out, const LevelObject& in);
 
+	friend class GlobalObjectList;
 	friend class LevelObjectPointer;
 
 private:
@@ -103,9 +111,15 @@ private:
 	LevelObject(type_t const, any_t const &);
 	LevelObject(type_t const, SourceScannerDHLX &);
 	LevelObject(type_t const, std::string const &);
-	LevelObject(type_t const, std::string const &, std::vector<std::string> const &);
+	LevelObject(type_t const, CodeDDL const &, std::vector<std::string> const &);
 	~LevelObject();
 
+	// Taken from an Arena, since there are so many of them.
+	static void * operator new(size_t size);
+	static void operator delete(void * p);
+
+	void addData(SourceStream & ss, std::string const & name);
+
 	void doCommandInfo(SourceScannerDHLX & sc);
 	void doCommandInfo(SourceTokenDDL const & st);
 	void doCommandInfo(string_t const & data);
@@ -21,6 +21,9 @@
 	03/02/2010 - Original version.
 	16/02/2010 - Update for short floats being pointer.
 	16/02/2010 - Major overhaul described in header.
+	17/10/2026 - Inline and pooled values described in header.
+	17/10/2026 - Pooled values taken from an Arena.
+	17/10/2026 - Added encodeText for TextWriter.
 */
 
 #include "LevelObjectData.hpp"
@@ -29,232 +32,301 @@
 #include "LevelObjectPointer.hpp"
 #include "LevelObjectType.hpp"
 
+#include "../arena.hpp"
+#include "../TextWriter.hpp"
 #include "../types.hpp"
 #include "../types/binary.hpp"
 #include "../types/int_t.hpp"
 #include "../types/real_t.hpp"
 #include "../types/string_t.hpp"
 
+#include <new>
 #include <stdexcept>
 
 
 
-LevelObjectData::LevelObjectData(LevelObjectData const & other)
+namespace
 {
-	_val = other._val;
-
-	switch (_val)
+	/*
+		Values too large for _valStore are kept in one arena per type, so
+		that making and clearing values rarely allocates.
+	*/
+	template<typename T>
+	Arena & pool()
 	{
-		case NULL_T:
-			break;
+		static Arena arena("LevelObjectData", sizeof(T));
 
-		case BOOL_T:
-			_valBool = other._valBool;
-			break;
+		return arena;
+	}
 
-		case INT_S_T:
-			_valIntShort = other._valIntShort;
-			break;
+	// How a value of type T is kept in a _valStore.
+	template<typename T, bool isInline>
+	struct Store;
 
-		case INT_T:
-			_valInt = new int_t(*other._valInt);
-			break;
+	template<typename T>
+	struct Store<T, true>
+	{
+		static T * get(void * store) {return static_cast<T *>(store);}
 
-		case INT_L_T:
-			_valIntLong = new int_l_t(*other._valIntLong);
-			break;
+		static void make(void * store, T const & v) {new(store) T(v);}
 
-		case OBJ_T:
-			_valObj = new obj_t(*other._valObj);
-			break;
+		static void free(void * store) {get(store)->~T();}
 
-		case OBJMAP_T:
-			_valObjMap = new objmap_t(*other._valObjMap);
-			break;
+		static void move(void * store, void * from) {make(store, *get(from)); free(from);}
+	};
 
-		case REAL_S_T:
-			_valRealShort = new real_s_t(*other._valRealShort);
-			break;
+	template<typename T>
+	struct Store<T, false>
+	{
+		static T * get(void * store) {return *static_cast<T **>(store);}
 
-		case REAL_T:
-			_valReal = new real_t(*other._valReal);
-			break;
+		static void make(void * store, T const & v) {*static_cast<T **>(store) = new(pool<T>().alloc()) T(v);}
 
-		case REAL_L_T:
-			_valRealLong = new real_l_t(*other._valRealLong);
-			break;
+		static void free(void * store) {get(store)->~T(); pool<T>().free(get(store));}
 
-		case STRING_T:
-			_valString = new string_t(*other._valString);
-			break;
+		static void move(void * store, void * from) {*static_cast<T **>(store) = get(from);}
+	};
+}
 
-		case STRING8_T:
-			_valString8 = new string8_t(*other._valString8);
-			break;
 
-		case STRING16_T:
-			_valString16 = new string16_t(*other._valString16);
-			break;
 
-		case STRING32_T:
-			_valString32 = new string32_t(*other._valString32);
-			break;
+template<typename T>
+T & LevelObjectData::get()
+{
+	return *Store<T, sizeof(T) <= STORE_SIZE>::get(_valStore);
+}
+template<typename T>
+T const & LevelObjectData::get() const
+{
+	return *Store<T, sizeof(T) <= STORE_SIZE>::get(const_cast<char *>(_valStore));
+}
 
-		case STRING80_T:
-			_valString80 = new string80_t(*other._valString80);
-			break;
+template<typename T>
+void LevelObjectData::make(T const & v)
+{
+	Store<T, sizeof(T) <= STORE_SIZE>::make(_valStore, v);
+}
 
-		case STRING320_T:
-			_valString320 = new string320_t(*other._valString320);
-			break;
+template<typename T>
+void LevelObjectData::set(T const & v, Type type)
+{
+	if (_val == type)
+	{
+		get<T>() = v;
+		return;
+	}
 
-		case TYPE_T:
-			_valType = new type_t(*other._valType);
-			break;
+	// An object or map being replaced could be what v is part of.
+	if (_val == OBJ_T || _val == OBJMAP_T)
+	{
+		LevelObjectData data(v);
 
-		case UBYTE_T:
-			_valUByte = new ubyte_t(*other._valUByte);
-			break;
+		clear();
+		take(data);
 
-		case SWORD_T:
-			_valSWord = new sword_t(*other._valSWord);
-			break;
+		return;
+	}
 
-		case UWORD_T:
-			_valUWord = new uword_t(*other._valUWord);
-			break;
+	clear();
+	make(v);
+	_val = type;
+}
 
-		case SDWORD_T:
-			_valSDWord = new sdword_t(*other._valSDWord);
-			break;
 
-		case UDWORD_T:
-			_valUDWord = new udword_t(*other._valUDWord);
-			break;
-	}
+
+LevelObjectData::LevelObjectData(LevelObjectData const & other) : _val(NULL_T)
+{
+	copy(other);
+}
+#if __cplusplus >= 201103L
+LevelObjectData::LevelObjectData(LevelObjectData && other) : _val(NULL_T)
+{
+	take(other);
 }
+#endif
 
 LevelObjectData::LevelObjectData(bool_t const & v) : _val(BOOL_T), _valBool(v) {}
 
-LevelObjectData::LevelObjectData(int_s_t const & v) : _val(INT_S_T), _valIntShort(            v ) {}
-LevelObjectData::LevelObjectData(int_t   const & v) : _val(INT_T),   _valInt(     new int_t  (v)) {}
-LevelObjectData::LevelObjectData(int_l_t const & v) : _val(INT_L_T), _valIntLong( new int_l_t(v)) {}
+LevelObjectData::LevelObjectData(int_s_t const & v) : _val(INT_S_T), _valIntShort(v) {}
+LevelObjectData::LevelObjectData(int_t   const & v) : _val(INT_T)   {make(v);}
+LevelObjectData::LevelObjectData(int_l_t const & v) : _val(INT_L_T) {make(v);}
 
-LevelObjectData::LevelObjectData(obj_t    const & v) : _val(OBJ_T),    _valObj(   new obj_t   (v)) {}
-LevelObjectData::LevelObjectData(objmap_t const & v) : _val(OBJMAP_T), _valObjMap(new objmap_t(v)) {}
+LevelObjectData::LevelObjectData(obj_t    const & v) : _val(OBJ_T)    {make(v);}
+LevelObjectData::LevelObjectData(objmap_t const & v) : _val(OBJMAP_T) {make(v);}
 
-LevelObjectData::LevelObjectData(real_s_t const & v) : _val(REAL_S_T), _valRealShort(new real_s_t(v)) {}
-LevelObjectData::LevelObjectData(real_t   const & v) : _val(REAL_T),   _valReal(     new real_t  (v)) {}
-LevelObjectData::LevelObjectData(real_l_t const & v) : _val(REAL_L_T), _valRealLong( new real_l_t(v)) {}
+LevelObjectData::LevelObjectData(real_s_t const & v) : _val(REAL_S_T) {make(v);}
+LevelObjectData::LevelObjectData(real_t   const & v) : _val(REAL_T)   {make(v);}
+LevelObjectData::LevelObjectData(real_l_t const & v) : _val(REAL_L_T) {make(v);}
 
-LevelObjectData::LevelObjectData(string_t    const & v) : _val(STRING_T),    _valString(   new string_t   (v)) {}
-LevelObjectData::LevelObjectData(string8_t   const & v) : _val(STRING8_T),   _valString8(  new string8_t  (v)) {}
-LevelObjectData::LevelObjectData(string16_t  const & v) : _val(STRING16_T),  _valString16( new string16_t (v)) {}
-LevelObjectData::LevelObjectData(string32_t  const & v) : _val(STRING32_T),  _valString32( new string32_t (v)) {}
-LevelObjectData::LevelObjectData(string80_t  const & v) : _val(STRING80_T),  _valString80( new string80_t (v)) {}
-LevelObjectData::LevelObjectData(string320_t const & v) : _val(STRING320_T), _valString320(new string320_t(v)) {}
+LevelObjectData::LevelObjectData(string_t    const & v) : _val(STRING_T)    {make(v);}
+LevelObjectData::LevelObjectData(string8_t   const & v) : _val(STRING8_T)   {make(v);}
+LevelObjectData::LevelObjectData(string16_t  const & v) : _val(STRING16_T)  {make(v);}
+LevelObjectData::LevelObjectData(string32_t  const & v) : _val(STRING32_T)  {make(v);}
+LevelObjectData::LevelObjectData(string80_t  const & v) : _val(STRING80_T)  {make(v);}
+LevelObjectData::LevelObjectData(string320_t const & v) : _val(STRING320_T) {make(v);}
 
-LevelObjectData::LevelObjectData(type_t const & v) : _val(TYPE_T), _valType(new type_t(v)) {}
+LevelObjectData::LevelObjectData(type_t const & v) : _val(TYPE_T) {make(v);}
 
-LevelObjectData::LevelObjectData(ubyte_t  const & v) : _val(UBYTE_T),  _valUByte( new ubyte_t (v)) {}
-LevelObjectData::LevelObjectData(sword_t  const & v) : _val(SWORD_T),  _valSWord( new sword_t (v)) {}
-LevelObjectData::LevelObjectData(uword_t  const & v) : _val(UWORD_T),  _valUWord( new uword_t (v)) {}
-LevelObjectData::LevelObjectData(sdword_t const & v) : _val(SDWORD_T), _valSDWord(new sdword_t(v)) {}
-LevelObjectData::LevelObjectData(udword_t const & v) : _val(UDWORD_T), _valUDWord(new udword_t(v)) {}
+LevelObjectData::LevelObjectData(ubyte_t  const & v) : _val(UBYTE_T)  {make(v);}
+LevelObjectData::LevelObjectData(sword_t  const & v) : _val(SWORD_T)  {make(v);}
+LevelObjectData::LevelObjectData(uword_t  const & v) : _val(UWORD_T)  {make(v);}
+LevelObjectData::LevelObjectData(sdword_t const & v) : _val(SDWORD_T) {make(v);}
+LevelObjectData::LevelObjectData(udword_t const & v) : _val(UDWORD_T) {make(v);}
 
 
 
+// Only for two of the same type.
+void LevelObjectData::assign(LevelObjectData const & other)
+{
+	switch (_val)
+	{
+		case NULL_T: break;
+
+		case BOOL_T: _valBool = other._valBool; break;
+
+		case INT_S_T: _valIntShort = other._valIntShort; break;
+		case INT_T:   get<int_t>() = other.get<int_t>(); break;
+		case INT_L_T: get<int_l_t>() = other.get<int_l_t>(); break;
+
+		case OBJ_T:    get<obj_t>() = other.get<obj_t>(); break;
+		case OBJMAP_T: get<objmap_t>() = other.get<objmap_t>(); break;
+
+		case REAL_S_T: get<real_s_t>() = other.get<real_s_t>(); break;
+		case REAL_T:   get<real_t>() = other.get<real_t>(); break;
+		case REAL_L_T: get<real_l_t>() = other.get<real_l_t>(); break;
+
+		case STRING_T:    get<string_t>() = other.get<string_t>(); break;
+		case STRING8_T:   get<string8_t>() = other.get<string8_t>(); break;
+		case STRING16_T:  get<string16_t>() = other.get<string16_t>(); break;
+		case STRING32_T:  get<string32_t>() = other.get<string32_t>(); break;
+		case STRING80_T:  get<string80_t>() = other.get<string80_t>(); break;
+		case STRING320_T: get<string320_t>() = other.get<string320_t>(); break;
+
+		case TYPE_T: get<type_t>() = other.get<type_t>(); break;
+
+		case UBYTE_T:  get<ubyte_t>() = other.get<ubyte_t>(); break;
+		case SWORD_T:  get<sword_t>() = other.get<sword_t>(); break;
+		case UWORD_T:  get<uword_t>() = other.get<uword_t>(); break;
+		case SDWORD_T: get<sdword_t>() = other.get<sdword_t>(); break;
+		case UDWORD_T: get<udword_t>() = other.get<udword_t>(); break;
+	}
+}
+
 void LevelObjectData::clear()
 {
 	switch (_val)
 	{
-		case NULL_T:
-			break;
+		case NULL_T: break;
+
+		case BOOL_T: break;
 
-		case BOOL_T:
-			break;
+		case INT_S_T: break;
+		case INT_T:   Store<int_t, sizeof(int_t) <= STORE_SIZE>::free(_valStore); break;
+		case INT_L_T: Store<int_l_t, sizeof(int_l_t) <= STORE_SIZE>::free(_valStore); break;
 
-		case INT_S_T:
-			break;
+		case OBJ_T:    Store<obj_t, sizeof(obj_t) <= STORE_SIZE>::free(_valStore); break;
+		case OBJMAP_T: Store<objmap_t, sizeof(objmap_t) <= STORE_SIZE>::free(_valStore); break;
 
-		case INT_T:
-			delete _valInt;
-			break;
+		case REAL_S_T: Store<real_s_t, sizeof(real_s_t) <= STORE_SIZE>::free(_valStore); break;
+		case REAL_T:   Store<real_t, sizeof(real_t) <= STORE_SIZE>::free(_valStore); break;
+		case REAL_L_T: Store<real_l_t, sizeof(real_l_t) <= STORE_SIZE>::free(_valStore); break;
 
-		case INT_L_T:
-			delete _valIntLong;
-			break;
+		case STRING_T:    Store<string_t, sizeof(string_t) <= STORE_SIZE>::free(_valStore); break;
+		case STRING8_T:   Store<string8_t, sizeof(string8_t) <= STORE_SIZE>::free(_valStore); break;
+		case STRING16_T:  Store<string16_t, sizeof(string16_t) <= STORE_SIZE>::free(_valStore); break;
+		case STRING32_T:  Store<string32_t, sizeof(string32_t) <= STORE_SIZE>::free(_valStore); break;
+		case STRING80_T:  Store<string80_t, sizeof(string80_t) <= STORE_SIZE>::free(_valStore); break;
+		case STRING320_T: Store<string320_t, sizeof(string320_t) <= STORE_SIZE>::free(_valStore); break;
 
-		case OBJ_T:
-			delete _valObj;
-			break;
+		case TYPE_T: Store<type_t, sizeof(type_t) <= STORE_SIZE>::free(_valStore); break;
 
-		case OBJMAP_T:
-			delete _valObjMap;
-			break;
+		case UBYTE_T:  Store<ubyte_t, sizeof(ubyte_t) <= STORE_SIZE>::free(_valStore); break;
+		case SWORD_T:  Store<sword_t, sizeof(sword_t) <= STORE_SIZE>::free(_valStore); break;
+		case UWORD_T:  Store<uword_t, sizeof(uword_t) <= STORE_SIZE>::free(_valStore); break;
+		case SDWORD_T: Store<sdword_t, sizeof(sdword_t) <= STORE_SIZE>::free(_valStore); break;
+		case UDWORD_T: Store<udword_t, sizeof(udword_t) <= STORE_SIZE>::free(_valStore); break;
+	}
+
+	_val = NULL_T;
+}
+
+// This must be NULL_T first.
+void LevelObjectData::copy(LevelObjectData const & other)
+{
+	switch (other._val)
+	{
+		case NULL_T: break;
 
-		case REAL_S_T:
-			delete _valRealShort;
-			break;
+		case BOOL_T: _valBool = other._valBool; break;
 
-		case REAL_T:
-			delete _valReal;
-			break;
+		case INT_S_T: _valIntShort = other._valIntShort; break;
+		case INT_T:   make(other.get<int_t>()); break;
+		case INT_L_T: make(other.get<int_l_t>()); break;
 
-		case REAL_L_T:
-			delete _valRealLong;
-			break;
+		case OBJ_T:    make(other.get<obj_t>()); break;
+		case OBJMAP_T: make(other.get<objmap_t>()); break;
 
-		case STRING_T:
-			delete _valString;
-			break;
+		case REAL_S_T: make(other.get<real_s_t>()); break;
+		case REAL_T:   make(other.get<real_t>()); break;
+		case REAL_L_T: make(other.get<real_l_t>()); break;
 
-		case STRING8_T:
-			delete _valString8;
-			break;
+		case STRING_T:    make(other.get<string_t>()); break;
+		case STRING8_T:   make(other.get<string8_t>()); break;
+		case STRING16_T:  make(other.get<string16_t>()); break;
+		case STRING32_T:  make(other.get<string32_t>()); break;
+		case STRING80_T:  make(other.get<string80_t>()); break;
+		case STRING320_T: make(other.get<string320_t>()); break;
 
-		case STRING16_T:
-			delete _valString16;
-			break;
+		case TYPE_T: make(other.get<type_t>()); break;
 
-		case STRING32_T:
-			delete _valString32;
-			break;
+		case UBYTE_T:  make(other.get<ubyte_t>()); break;
+		case SWORD_T:  make(other.get<sword_t>()); break;
+		case UWORD_T:  make(other.get<uword_t>()); break;
+		case SDWORD_T: make(other.get<sdword_t>()); break;
+		case UDWORD_T: make(other.get<udword_t>()); break;
+	}
+
+	_val = other._val;
+}
 
-		case STRING80_T:
-			delete _valString80;
-			break;
+void LevelObjectData::take(LevelObjectData & other)
+{
+	switch (other._val)
+	{
+		case NULL_T: break;
 
-		case STRING320_T:
-			delete _valString320;
-			break;
+		case BOOL_T: _valBool = other._valBool; break;
 
-		case TYPE_T:
-			delete _valType;
-			break;
+		case INT_S_T: _valIntShort = other._valIntShort; break;
+		case INT_T:   Store<int_t, sizeof(int_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case INT_L_T: Store<int_l_t, sizeof(int_l_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
 
-		case UBYTE_T:
-			delete _valUByte;
-			break;
+		case OBJ_T:    Store<obj_t, sizeof(obj_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case OBJMAP_T: Store<objmap_t, sizeof(objmap_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
 
-		case SWORD_T:
-			delete _valSWord;
-			break;
+		case REAL_S_T: Store<real_s_t, sizeof(real_s_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case REAL_T:   Store<real_t, sizeof(real_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case REAL_L_T: Store<real_l_t, sizeof(real_l_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
 
-		case UWORD_T:
-			delete _valUWord;
-			break;
+		case STRING_T:    Store<string_t, sizeof(string_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case STRING8_T:   Store<string8_t, sizeof(string8_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case STRING16_T:  Store<string16_t, sizeof(string16_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case STRING32_T:  Store<string32_t, sizeof(string32_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case STRING80_T:  Store<string80_t, sizeof(string80_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case STRING320_T: Store<string320_t, sizeof(string320_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
 
-		case SDWORD_T:
-			delete _valSDWord;
-			break;
+		case TYPE_T: Store<type_t, sizeof(type_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
 
-		case UDWORD_T:
-			delete _valUDWord;
-			break;
+		case UBYTE_T:  Store<ubyte_t, sizeof(ubyte_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case SWORD_T:  Store<sword_t, sizeof(sword_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case UWORD_T:  Store<uword_t, sizeof(uword_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case SDWORD_T: Store<sdword_t, sizeof(sdword_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
+		case UDWORD_T: Store<udword_t, sizeof(udword_t) <= STORE_SIZE>::move(_valStore, other._valStore); break;
 	}
 
-	_val = NULL_T;
+	_val = other._val;
+
+	other._val = NULL_T;
 }
 
 
@@ -278,11 +350,11 @@ void LevelObjectData::encodeText(std::ostream & out)
 		break;
 
 	case INT_T:
-		_valInt->encodeText(out);
+		get<int_t>().encodeText(out);
 		break;
 
 	case INT_L_T:
-		_valIntLong->encodeText(out);
+		get<int_l_t>().encodeText(out);
 		break;
 
 	case OBJ_T:
@@ -293,62 +365,155 @@ void LevelObjectData::encodeText(std::ostream & out)
 
 	case REAL_S_T:
 		out.precision(256);
-		out << *_valRealShort;
+		out << get<real_s_t>();
+		break;
+
+	case REAL_T:
+		get<real_t>().encodeText(out);
+		break;
+
+	case REAL_L_T:
+		get<real_l_t>().encodeText(out);
+		break;
+
+	case STRING_T:
+		get<string_t>().encodeText(out);
+		break;
+
+	case STRING8_T:
+		get<string8_t>().encodeText(out);
+		break;
+
+	case STRING16_T:
+		get<string16_t>().encodeText(out);
+		break;
+
+	case STRING32_T:
+		get<string32_t>().encodeText(out);
+		break;
+
+	case STRING80_T:
+		get<string80_t>().encodeText(out);
+		break;
+
+	case STRING320_T:
+		get<string320_t>().encodeText(out);
+		break;
+
+	case TYPE_T:
+		break;
+
+	case UBYTE_T:
+		get<ubyte_t>().encodeText(out);
+		break;
+
+	case SWORD_T:
+		get<sword_t>().encodeText(out);
+		break;
+
+	case UWORD_T:
+		get<uword_t>().encodeText(out);
+		break;
+
+	case SDWORD_T:
+		get<sdword_t>().encodeText(out);
+		break;
+
+	case UDWORD_T:
+		get<udword_t>().encodeText(out);
+		break;
+	}
+}
+
+void LevelObjectData::encodeText(TextWriter & out)
+{
+	switch (_val)
+	{
+	case NULL_T:
+		break;
+
+	case BOOL_T:
+		if (_valBool)
+			out.write("true", 4);
+		else
+			out.write("false", 5);
+		break;
+
+	case INT_S_T:
+		out.writeInt(_valIntShort);
+		break;
+
+	case INT_T:
+		get<int_t>().encodeText(out);
+		break;
+
+	case INT_L_T:
+		get<int_l_t>().encodeText(out);
+		break;
+
+	case OBJ_T:
+		break;
+
+	case OBJMAP_T:
+		break;
+
+	case REAL_S_T:
+		out.writeReal(get<real_s_t>());
 		break;
 
 	case REAL_T:
-		_valReal->encodeText(out);
+		get<real_t>().encodeText(out);
 		break;
 
 	case REAL_L_T:
-		_valRealLong->encodeText(out);
+		get<real_l_t>().encodeText(out);
 		break;
 
 	case STRING_T:
-		_valString->encodeText(out);
+		get<string_t>().encodeText(out);
 		break;
 
 	case STRING8_T:
-		_valString8->encodeText(out);
+		get<string8_t>().encodeText(out);
 		break;
 
 	case STRING16_T:
-		_valString16->encodeText(out);
+		get<string16_t>().encodeText(out);
 		break;
 
 	case STRING32_T:
-		_valString32->encodeText(out);
+		get<string32_t>().encodeText(out);
 		break;
 
 	case STRING80_T:
-		_valString80->encodeText(out);
+		get<string80_t>().encodeText(out);
 		break;
 
 	case STRING320_T:
-		_valString320->encodeText(out);
+		get<string320_t>().encodeText(out);
 		break;
 
 	case TYPE_T:
 		break;
 
 	case UBYTE_T:
-		_valUByte->encodeText(out);
+		get<ubyte_t>().encodeText(out);
 		break;
 
 	case SWORD_T:
-		_valSWord->encodeText(out);
+		get<sword_t>().encodeText(out);
 		break;
 
 	case UWORD_T:
-		_valUWord->encodeText(out);
+		get<uword_t>().encodeText(out);
 		break;
 
 	case SDWORD_T:
-		_valSDWord->encodeText(out);
+		get<sdword_t>().encodeText(out);
 		break;
 
 	case UDWORD_T:
-		_valUDWord->encodeText(out);
+		get<udword_t>().encodeText(out);
 		break;
 	}
 }
@@ -374,30 +539,30 @@ TYPE_NAME const & LevelObjectData::FUNC_NAME() const				\
 LevelObjectData_get(bool_t, BOOL_T, getBool, _valBool)
 
 LevelObjectData_get(int_s_t, INT_S_T, getIntShort,  _valIntShort)
-LevelObjectData_get(int_t,   INT_T,   getInt,      *_valInt)
-LevelObjectData_get(int_l_t, INT_L_T, getIntLong,  *_valIntLong)
+LevelObjectData_get(int_t,   INT_T,   getInt,      get<int_t>())
+LevelObjectData_get(int_l_t, INT_L_T, getIntLong,  get<int_l_t>())
 
-LevelObjectData_get(obj_t,    OBJ_T,    getObj,    *_valObj)
-LevelObjectData_get(objmap_t, OBJMAP_T, getObjMap, *_valObjMap)
+LevelObjectData_get(obj_t,    OBJ_T,    getObj,    get<obj_t>())
+LevelObjectData_get(objmap_t, OBJMAP_T, getObjMap, get<objmap_t>())
 
-LevelObjectData_get(real_s_t, REAL_S_T, getRealShort, *_valRealShort)
-LevelObjectData_get(real_t,   REAL_T,   getReal,      *_valReal)
-LevelObjectData_get(real_l_t, REAL_L_T, getRealLong,  *_valRealLong)
+LevelObjectData_get(real_s_t, REAL_S_T, getRealShort, get<real_s_t>())
+LevelObjectData_get(real_t,   REAL_T,   getReal,      get<real_t>())
+LevelObjectData_get(real_l_t, REAL_L_T, getRealLong,  get<real_l_t>())
 
-LevelObjectData_get(string_t,    STRING_T,    getString,    *_valString)
-LevelObjectData_get(string8_t,   STRING8_T,   getString8,   *_valString8)
-LevelObjectData_get(string16_t,  STRING16_T,  getString16,  *_valString16)
-LevelObjectData_get(string32_t,  STRING32_T,  getString32,  *_valString32)
-LevelObjectData_get(string80_t,  STRING80_T,  getString80,  *_valString80)
-LevelObjectData_get(string320_t, STRING320_T, getString320, *_valString320)
+LevelObjectData_get(string_t,    STRING_T,    getString,    get<string_t>())
+LevelObjectData_get(string8_t,   STRING8_T,   getString8,   get<string8_t>())
+LevelObjectData_get(string16_t,  STRING16_T,  getString16,  get<string16_t>())
+LevelObjectData_get(string32_t,  STRING32_T,  getString32,  get<string32_t>())
+LevelObjectData_get(string80_t,  STRING80_T,  getString80,  get<string80_t>())
+LevelObjectData_get(string320_t, STRING320_T, getString320, get<string320_t>())
 
-LevelObjectData_get(type_t, TYPE_T, getType, *_valType)
+LevelObjectData_get(type_t, TYPE_T, getType, get<type_t>())
 
-LevelObjectData_get(ubyte_t,  UBYTE_T,  getUByte,  *_valUByte)
-LevelObjectData_get(sword_t,  SWORD_T,  getSWord,  *_valSWord)
-LevelObjectData_get(uword_t,  UWORD_T,  getUWord,  *_valUWord)
-LevelObjectData_get(sdword_t, SDWORD_T, getSDWord, *_valSDWord)
-LevelObjectData_get(udword_t, UDWORD_T, getUDWord, *_valUDWord)
+LevelObjectData_get(ubyte_t,  UBYTE_T,  getUByte,  get<ubyte_t>())
+LevelObjectData_get(sword_t,  SWORD_T,  getSWord,  get<sword_t>())
+LevelObjectData_get(uword_t,  UWORD_T,  getUWord,  get<uword_t>())
+LevelObjectData_get(sdword_t, SDWORD_T, getSDWord, get<sdword_t>())
+LevelObjectData_get(udword_t, UDWORD_T, getUDWord, get<udword_t>())
 
 #undef LevelObjectData_get
 
@@ -413,30 +578,30 @@ TYPE##_t LevelObjectData::FUNC_NAME() const \
 	case BOOL_T: return convert<TYPE##_t, bool_t>( _valBool); \
 		\
 	case INT_S_T: return convert<TYPE##_t, int_s_t>( _valIntShort); \
-	case INT_T:   return convert<TYPE##_t, int_t>  (*_valInt); \
-	case INT_L_T: return convert<TYPE##_t, int_l_t>(*_valIntLong); \
+	case INT_T:   return convert<TYPE##_t, int_t>  (get<int_t>()); \
+	case INT_L_T: return convert<TYPE##_t, int_l_t>(get<int_l_t>()); \
 		\
-	case OBJ_T:    return convert<TYPE##_t, obj_t>(*_valObj); \
+	case OBJ_T:    return convert<TYPE##_t, obj_t>(get<obj_t>()); \
 	case OBJMAP_T: throw std::invalid_argument("LevelObjectData(OBJMAP_T)->" #FUNC_NAME "()"); \
 		\
-	case REAL_S_T: return convert<TYPE##_t, real_s_t>(*_valRealShort); \
-	case REAL_T:   return convert<TYPE##_t, real_t>  (*_valReal); \
-	case REAL_L_T: return convert<TYPE##_t, real_l_t>(*_valRealLong); \
+	case REAL_S_T: return convert<TYPE##_t, real_s_t>(get<real_s_t>()); \
+	case REAL_T:   return convert<TYPE##_t, real_t>  (get<real_t>()); \
+	case REAL_L_T: return convert<TYPE##_t, real_l_t>(get<real_l_t>()); \
 		\
-	case STRING_T:    return convert<TYPE##_t, string_t>   (*_valString); \
-	case STRING8_T:   return convert<TYPE##_t, string8_t>  (*_valString8); \
-	case STRING16_T:  return convert<TYPE##_t, string16_t> (*_valString16); \
-	case STRING32_T:  return convert<TYPE##_t, string32_t> (*_valString32); \
-	case STRING80_T:  return convert<TYPE##_t, string80_t> (*_valString80); \
-	case STRING320_T: return convert<TYPE##_t, string320_t>(*_valString320); \
+	case STRING_T:    return convert<TYPE##_t, string_t>   (get<string_t>()); \
+	case STRING8_T:   return convert<TYPE##_t, string8_t>  (get<string8_t>()); \
+	case STRING16_T:  return convert<TYPE##_t, string16_t> (get<string16_t>()); \
+	case STRING32_T:  return convert<TYPE##_t, string32_t> (get<string32_t>()); \
+	case STRING80_T:  return convert<TYPE##_t, string80_t> (get<string80_t>()); \
+	case STRING320_T: return convert<TYPE##_t, string320_t>(get<string320_t>()); \
 		\
 	case TYPE_T: throw std::invalid_argument("LevelObjectData(TYPE_T)->" #FUNC_NAME "()"); \
 		\
-	case UBYTE_T:  return convert<TYPE##_t, ubyte_t> (*_valUByte); \
-	case SWORD_T:  return convert<TYPE##_t, sword_t> (*_valSWord); \
-	case UWORD_T:  return convert<TYPE##_t, uword_t> (*_valUWord); \
-	case SDWORD_T: return convert<TYPE##_t, sdword_t>(*_valSDWord); \
-	case UDWORD_T: return convert<TYPE##_t, udword_t>(*_valUDWord); \
+	case UBYTE_T:  return convert<TYPE##_t, ubyte_t> (get<ubyte_t>()); \
+	case SWORD_T:  return convert<TYPE##_t, sword_t> (get<sword_t>()); \
+	case UWORD_T:  return convert<TYPE##_t, uword_t> (get<uword_t>()); \
+	case SDWORD_T: return convert<TYPE##_t, sdword_t>(get<sdword_t>()); \
+	case UDWORD_T: return convert<TYPE##_t, udword_t>(get<udword_t>()); \
 	} \
 	\
 	return TYPE##_t(); \
@@ -478,30 +643,30 @@ LevelObjectData & LevelObjectData::operator += (LevelObjectData const & other)
 		case BOOL_T: _valBool += other.toBool(); break;
 
 		case INT_S_T:  _valIntShort += other.toIntShort(); break;
-		case INT_T:   *_valInt      += other.toInt();      break;
-		case INT_L_T: *_valIntLong  += other.toIntLong();  break;
+		case INT_T:   get<int_t>()      += other.toInt();      break;
+		case INT_L_T: get<int_l_t>()  += other.toIntLong();  break;
 
 		case OBJ_T:    throw std::invalid_argument("LevelObjectData(OBJ_T)+=...");
 		case OBJMAP_T: throw std::invalid_argument("LevelObjectData(OBJMAP_T)+=...");
 
-		case REAL_S_T: *_valRealShort += other.toRealShort(); break;
-		case REAL_T:   *_valReal      += other.toReal();      break;
-		case REAL_L_T: *_valRealLong  += other.toRealLong();  break;
+		case REAL_S_T: get<real_s_t>() += other.toRealShort(); break;
+		case REAL_T:   get<real_t>()      += other.toReal();      break;
+		case REAL_L_T: get<real_l_t>()  += other.toRealLong();  break;
 
-		case STRING_T:    *_valString    += other.toString();    break;
-		case STRING8_T:   *_valString8   += other.toString8();   break;
-		case STRING16_T:  *_valString16  += other.toString16();  break;
-		case STRING32_T:  *_valString32  += other.toString32();  break;
-		case STRING80_T:  *_valString80  += other.toString80();  break;
-		case STRING320_T: *_valString320 += other.toString320(); break;
+		case STRING_T:    get<string_t>()    += other.toString();    break;
+		case STRING8_T:   get<string8_t>()   += other.toString8();   break;
+		case STRING16_T:  get<string16_t>()  += other.toString16();  break;
+		case STRING32_T:  get<string32_t>()  += other.toString32();  break;
+		case STRING80_T:  get<string80_t>()  += other.toString80();  break;
+		case STRING320_T: get<string320_t>() += other.toString320(); break;
 
 		case TYPE_T: throw std::invalid_argument("LevelObjectData(TYPE_T)+=...");
 
-		case UBYTE_T:  *_valUByte  += other.toUByte();  break;
-		case SWORD_T:  *_valSWord  += other.toSWord();  break;
-		case UWORD_T:  *_valUWord  += other.toUWord();  break;
-		case SDWORD_T: *_valSDWord += other.toSDWord(); break;
-		case UDWORD_T: *_valUDWord += other.toUDWord(); break;
+		case UBYTE_T:  get<ubyte_t>()  += other.toUByte();  break;
+		case SWORD_T:  get<sword_t>()  += other.toSWord();  break;
+		case UWORD_T:  get<uword_t>()  += other.toUWord();  break;
+		case SDWORD_T: get<sdword_t>() += other.toSDWord(); break;
+		case UDWORD_T: get<udword_t>() += other.toUDWord(); break;
 	}
 
 	return *this;
@@ -509,102 +674,68 @@ LevelObjectData & LevelObjectData::operator += (LevelObjectData const & other)
 
 LevelObjectData & LevelObjectData::operator = (LevelObjectData const & other)
 {
-	clear();
-
-	_val = other._val;
-
-	switch (_val)
+	if (_val == other._val)
 	{
-		case NULL_T:
-			break;
-
-		case BOOL_T:
-			_valBool = other._valBool;
-			break;
-
-		case INT_S_T:
-			_valIntShort = other._valIntShort;
-			break;
-
-		case INT_T:
-			_valInt = new int_t(*other._valInt);
-			break;
-
-		case INT_L_T:
-			_valIntLong = new int_l_t(*other._valIntLong);
-			break;
-
-		case OBJ_T:
-			_valObj = new obj_t(*other._valObj);
-			break;
-
-		case OBJMAP_T:
-			_valObjMap = new objmap_t(*other._valObjMap);
-			break;
-
-		case REAL_S_T:
-			_valRealShort = new real_s_t(*other._valRealShort);
-			break;
-
-		case REAL_T:
-			_valReal = new real_t(*other._valReal);
-			break;
-
-		case REAL_L_T:
-			_valRealLong = new real_l_t(*other._valRealLong);
-			break;
+		assign(other);
+		return *this;
+	}
 
-		case STRING_T:
-			_valString = new string_t(*other._valString);
-			break;
+	// An object or map being replaced could be what other is part of.
+	if (_val == OBJ_T || _val == OBJMAP_T)
+	{
+		LevelObjectData data(other);
 
-		case STRING8_T:
-			_valString8 = new string8_t(*other._valString8);
-			break;
+		clear();
+		take(data);
 
-		case STRING16_T:
-			_valString16 = new string16_t(*other._valString16);
-			break;
+		return *this;
+	}
 
-		case STRING32_T:
-			_valString32 = new string32_t(*other._valString32);
-			break;
+	clear();
+	copy(other);
 
-		case STRING80_T:
-			_valString80 = new string80_t(*other._valString80);
-			break;
+	return *this;
+}
+#if __cplusplus >= 201103L
+LevelObjectData & LevelObjectData::operator = (LevelObjectData && other)
+{
+	if (this != &other)
+	{
+		clear();
+		take(other);
+	}
 
-		case STRING320_T:
-			_valString320 = new string320_t(*other._valString320);
-			break;
+	return *this;
+}
+#endif
 
-		case TYPE_T:
-			_valType = new type_t(*other._valType);
-			break;
+LevelObjectData & LevelObjectData::operator = (bool_t const & v) {set(v, BOOL_T); return *this;}
 
-		case UBYTE_T:
-			_valUByte = new ubyte_t(*other._valUByte);
-			break;
+LevelObjectData & LevelObjectData::operator = (int_s_t const & v) {set(v, INT_S_T); return *this;}
+LevelObjectData & LevelObjectData::operator = (int_t   const & v) {set(v, INT_T);   return *this;}
+LevelObjectData & LevelObjectData::operator = (int_l_t const & v) {set(v, INT_L_T); return *this;}
 
-		case SWORD_T:
-			_valSWord = new sword_t(*other._valSWord);
-			break;
+LevelObjectData & LevelObjectData::operator = (obj_t    const & v) {set(v, OBJ_T);    return *this;}
+LevelObjectData & LevelObjectData::operator = (objmap_t const & v) {set(v, OBJMAP_T); return *this;}
 
-		case UWORD_T:
-			_valUWord = new uword_t(*other._valUWord);
-			break;
+LevelObjectData & LevelObjectData::operator = (real_s_t const & v) {set(v, REAL_S_T); return *this;}
+LevelObjectData & LevelObjectData::operator = (real_t   const & v) {set(v, REAL_T);   return *this;}
+LevelObjectData & LevelObjectData::operator = (real_l_t const & v) {set(v, REAL_L_T); return *this;}
 
-		case SDWORD_T:
-			_valSDWord = new sdword_t(*other._valSDWord);
-			break;
+LevelObjectData & LevelObjectData::operator = (string_t    const & v) {set(v, STRING_T);    return *this;}
+LevelObjectData & LevelObjectData::operator = (string8_t   const & v) {set(v, STRING8_T);   return *this;}
+LevelObjectData & LevelObjectData::operator = (string16_t  const & v) {set(v, STRING16_T);  return *this;}
+LevelObjectData & LevelObjectData::operator = (string32_t  const & v) {set(v, STRING32_T);  return *this;}
+LevelObjectData & LevelObjectData::operator = (string80_t  const & v) {set(v, STRING80_T);  return *this;}
+LevelObjectData & LevelObjectData::operator = (string320_t const & v) {set(v, STRING320_T); return *this;}
 
-		case UDWORD_T:
-			_valUDWord = new udword_t(*other._valUDWord);
-			break;
-	}
+LevelObjectData & LevelObjectData::operator = (type_t const & v) {set(v, TYPE_T); return *this;}
 
-	return *this;
-}
+LevelObjectData & LevelObjectData::operator = (ubyte_t  const & v) {set(v, UBYTE_T);  return *this;}
+LevelObjectData & LevelObjectData::operator = (sword_t  const & v) {set(v, SWORD_T);  return *this;}
+LevelObjectData & LevelObjectData::operator = (uword_t  const & v) {set(v, UWORD_T);  return *this;}
+LevelObjectData & LevelObjectData::operator = (sdword_t const & v) {set(v, SDWORD_T); return *this;}
+LevelObjectData & LevelObjectData::operator = (udword_t const & v) {set(v, UDWORD_T); return *this;}
 
 
 
@@ -618,32 +749,32 @@ int cmp(LevelObjectData const & l, LevelObjectData const & r)
 		case LevelObjectData::BOOL_T: return cmp(l._valBool, r.toBool());
 
 		case LevelObjectData::INT_S_T: return cmp( l._valIntShort, r.toIntShort());
-		case LevelObjectData::INT_T:   return cmp(*l._valInt,      r.toInt());
-		case LevelObjectData::INT_L_T: return cmp(*l._valIntLong,  r.toIntLong());
+		case LevelObjectData::INT_T:   return cmp(l.get<int_t>(),      r.toInt());
+		case LevelObjectData::INT_L_T: return cmp(l.get<int_l_t>(),  r.toIntLong());
 
 		case LevelObjectData::OBJ_T:    throw std::invalid_argument("cmp(LevelObjectData(OBJ_T),...)");
 		// Even if there was a meaningful way to handle this, it is still obviously an error.
 		case LevelObjectData::OBJMAP_T: throw std::invalid_argument("cmp(LevelObjectData(OBJMAP_T),...)");
 
-		case LevelObjectData::REAL_S_T: return cmp(*l._valRealShort, r.toRealShort());
-		case LevelObjectData::REAL_T:   return cmp(*l._valReal,      r.toReal());
-		case LevelObjectData::REAL_L_T: return cmp(*l._valRealLong,  r.toRealLong());
+		case LevelObjectData::REAL_S_T: return cmp(l.get<real_s_t>(), r.toRealShort());
+		case LevelObjectData::REAL_T:   return cmp(l.get<real_t>(),      r.toReal());
+		case LevelObjectData::REAL_L_T: return cmp(l.get<real_l_t>(),  r.toRealLong());
 
-		case LevelObjectData::STRING_T:    return cmp(*l._valString,    r.toString());
-		case LevelObjectData::STRING8_T:   return cmp(*l._valString8,   r.toString8());
-		case LevelObjectData::STRING16_T:  return cmp(*l._valString16,  r.toString16());
-		case LevelObjectData::STRING32_T:  return cmp(*l._valString32,  r.toString32());
-		case LevelObjectData::STRING80_T:  return cmp(*l._valString80,  r.toString80());
-		case LevelObjectData::STRING320_T: return cmp(*l._valString320, r.toString320());
+		case LevelObjectData::STRING_T:    return cmp(l.get<string_t>(),    r.toString());
+		case LevelObjectData::STRING8_T:   return cmp(l.get<string8_t>(),   r.toString8());
+		case LevelObjectData::STRING16_T:  return cmp(l.get<string16_t>(),  r.toString16());
+		case LevelObjectData::STRING32_T:  return cmp(l.get<string32_t>(),  r.toString32());
+		case LevelObjectData::STRING80_T:  return cmp(l.get<string80_t>(),  r.toString80());
+		case LevelObjectData::STRING320_T: return cmp(l.get<string320_t>(), r.toString320());
 
 		// TODO
 		case LevelObjectData::TYPE_T: throw std::invalid_argument("cmp(LevelObjectData(TYPE_T),...)");
 
-		case LevelObjectData::UBYTE_T:  return cmp(*l._valUByte,  r.toUByte());
-		case LevelObjectData::SWORD_T:  return cmp(*l._valSWord,  r.toSWord());
-		case LevelObjectData::UWORD_T:  return cmp(*l._valUWord,  r.toUWord());
-		case LevelObjectData::SDWORD_T: return cmp(*l._valSDWord, r.toSDWord());
-		case LevelObjectData::UDWORD_T: return cmp(*l._valUDWord, r.toUDWord());
+		case LevelObjectData::UBYTE_T:  return cmp(l.get<ubyte_t>(),  r.toUByte());
+		case LevelObjectData::SWORD_T:  return cmp(l.get<sword_t>(),  r.toSWord());
+		case LevelObjectData::UWORD_T:  return cmp(l.get<uword_t>(),  r.toUWord());
+		case LevelObjectData::SDWORD_T: return cmp(l.get<sdword_t>(), r.toSDWord());
+		case LevelObjectData::UDWORD_T: return cmp(l.get<udword_t>(), r.toUDWord());
 	}
 
 	return 0;
@@ -28,6 +28,10 @@
 		LevelObject in the first place. One important change: get
 		functions now check type. If it's wrong, throw an exception NOT
 		derived from CompilerException.
+	2026/10/17 - Values are kept inline when they fit, and in a pool when
+		they do not, instead of each having its own allocation.
+		Assigning a value of the same type assigns to the old one.
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #ifndef LEVELOBJECTDATA_H
@@ -39,6 +43,8 @@
 
 
 
+class TextWriter;
+
 class LevelObjectData
 {
 public:
@@ -76,6 +82,9 @@ public:
 	};
 
 	LevelObjectData(LevelObjectData const &);
+	#if __cplusplus >= 201103L
+	LevelObjectData(LevelObjectData &&);
+	#endif
 
 	LevelObjectData(bool_t const &);
 
@@ -110,6 +119,7 @@ public:
 
 
 	void encodeText(std::ostream & out);
+	void encodeText(TextWriter   & out);
 
 
 
@@ -205,6 +215,37 @@ public:
 	LevelObjectData & operator += (LevelObjectData const &);
 
 	LevelObjectData & operator = (LevelObjectData const &);
+	#if __cplusplus >= 201103L
+	LevelObjectData & operator = (LevelObjectData &&);
+	#endif
+
+	LevelObjectData & operator = (bool_t const &);
+
+	LevelObjectData & operator = (int_s_t const &);
+	LevelObjectData & operator = (int_t   const &);
+	LevelObjectData & operator = (int_l_t const &);
+
+	LevelObjectData & operator = (obj_t    const &);
+	LevelObjectData & operator = (objmap_t const &);
+
+	LevelObjectData & operator = (real_s_t const &);
+	LevelObjectData & operator = (real_t   const &);
+	LevelObjectData & operator = (real_l_t const &);
+
+	LevelObjectData & operator = (string_t    const &);
+	LevelObjectData & operator = (string8_t   const &);
+	LevelObjectData & operator = (string16_t  const &);
+	LevelObjectData & operator = (string32_t  const &);
+	LevelObjectData & operator = (string80_t  const &);
+	LevelObjectData & operator = (string320_t const &);
+
+	LevelObjectData & operator = (type_t const &);
+
+	LevelObjectData & operator = (ubyte_t  const &);
+	LevelObjectData & operator = (sword_t  const &);
+	LevelObjectData & operator = (uword_t  const &);
+	LevelObjectData & operator = (sdword_t const &);
+	LevelObjectData & operator = (udword_t const &);
 
 
 
@@ -215,39 +256,39 @@ public:
 
 
 private:
+	// Values up to this size are made in _valStore. Larger ones are made in
+	// a pool, and _valStore only has their address.
+	enum {STORE_SIZE = 32};
+
+	void assign(LevelObjectData const & other);
+
 	void clear();
 
-	Type _val;
+	void copy(LevelObjectData const & other);
 
-	union
-	{
-		bool_t        _valBool;
+	template<typename T> T       & get();
+	template<typename T> T const & get() const;
 
-		int_s_t       _valIntShort;
-		int_t       * _valInt;
-		int_l_t     * _valIntLong;
+	template<typename T> void make(T const & v);
 
-		obj_t       * _valObj;
-		objmap_t    * _valObjMap;
+	// Assigns v if it is the current type, otherwise makes it.
+	template<typename T> void set(T const & v, Type type);
 
-		real_s_t    * _valRealShort;
-		real_t      * _valReal;
-		real_l_t    * _valRealLong;
+	// Sets this to other's value and type, and other to NULL_T. This must
+	// be NULL_T first.
+	void take(LevelObjectData & other);
 
-		string_t    * _valString;
-		string8_t   * _valString8;
-		string16_t  * _valString16;
-		string32_t  * _valString32;
-		string80_t  * _valString80;
-		string320_t * _valString320;
+	Type _val;
+
+	union
+	{
+		bool_t  _valBool;
+		int_s_t _valIntShort;
 
-		type_t      * _valType;
+		char _valStore[STORE_SIZE];
 
-		ubyte_t     * _valUByte;
-		sword_t     * _valSWord;
-		uword_t     * _valUWord;
-		sdword_t    * _valSDWord;
-		udword_t    * _valUDWord;
+		// Only for the alignment of _valStore.
+		long double _valAlign;
 	};
 };
 
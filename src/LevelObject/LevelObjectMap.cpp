@@ -18,87 +18,335 @@
 */
 
 /*
-
+	2026/10/17 - Replaced the map and list with a single insertion-ordered
+		hash table.
+	2026/10/17 - Added shared base layers for derived objects.
+	2026/10/17 - Copies and merges are counted for --debug-stats.
 */
 
 #include "LevelObjectMap.hpp"
 
 #include "LevelObjectPointer.hpp"
 
+#include "../stats.hpp"
+
 #include "../exceptions/NoSuchElementException.hpp"
 
 #include "../../common/foreach.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 
 
-LevelObjectMap::LevelObjectMap() : _objMap(), _objList()
+static StatsCounter stats_copy        ("LevelObjectMap", "copy");
+static StatsCounter stats_copy_entries("LevelObjectMap", "copy-entries");
+static StatsCounter stats_merge       ("LevelObjectMap", "merge");
+
+
+
+LevelObjectMap::LevelObjectMap() : _entries(), _slots(), _base(NULL), _countDead(0)
 {
 
 }
-LevelObjectMap::LevelObjectMap(LevelObjectMap const & other) : _objMap(other._objMap), _objList(other._objList)
+LevelObjectMap::LevelObjectMap(LevelObjectMap const & other) : _entries(), _slots(), _base(other._base), _countDead(0)
 {
+	if (_base) ++_base->refCount;
+
+	_entries.reserve(other._entries.size() - other._countDead);
+
+	FOREACH_T_CONST(entry_list_t, it, other._entries)
+	{
+		if (it->isLive)
+			_entries.push_back(*it);
+	}
+
+	if (!_entries.empty())
+		rehash(_entries.size());
 
+	stats_copy.add();
+	stats_copy_entries.add(_entries.size());
+}
+LevelObjectMap::~LevelObjectMap()
+{
+	release(_base);
 }
 
 void LevelObjectMap::add(name_t const & name, obj_t obj)
 {
-	if (!has(name))
-		_objList.push_back(pair_t(name, obj));
-	else
+	size_t slot = find(name);
+
+	if (isUsed(slot))
 	{
-		FOREACH_T(list_t, it, _objList)
-		{
-			if (it->first == name)
-			{
-				it->second = obj;
-				break;
-			}
-		}
+		_entries[_slots[slot] - 1].pair.second = obj;
+		return;
 	}
 
-	_objMap[name] = obj;
+	if ((_entries.size() + 1) * 2 > _slots.size())
+	{
+		rehash(_entries.size() - _countDead + 1);
+		slot = find(name);
+	}
+
+	Entry entry = {pair_t(name, obj), true, true, _base && _base->map.has(name)};
+
+	_entries.push_back(entry);
+	_slots[slot] = _entries.size();
 }
+/*
+	Objects without names are only kept for their order, and are never in
+	the table.
+*/
 void LevelObjectMap::add(obj_t obj)
 {
-	_objList.push_back(pair_t(name_t(""), obj));
+	if ((_entries.size() + 1) * 2 > _slots.size())
+		rehash(_entries.size() - _countDead + 1);
+
+	Entry entry = {pair_t(name_t(""), obj), false, true, false};
+
+	_entries.push_back(entry);
 }
 void LevelObjectMap::del(name_t const & name)
 {
-	_objMap.erase(name);
+	// A key of the base would show through again, so the base is folded in
+	// first. name may be in the base, so it is kept until done with.
+	Layer * base = NULL;
+
+	if (_base && _base->map.has(name))
+		base = materialize();
 
-	FOREACH_T(list_t, it, _objList)
+	size_t slot = find(name);
+
+	if (isUsed(slot))
 	{
-		if (it->first == name)
+		Entry & entry = _entries[_slots[slot] - 1];
+
+		// The name is left alone, since it may be what was passed in.
+		entry.pair.second = obj_t();
+		entry.isLive      = false;
+
+		_slots[slot] = size_t(-1);
+		++_countDead;
+	}
+
+	release(base);
+}
+/*
+	Returns the slot holding name, or else the slot to add it in. Deleted
+	slots are reused, so that adding and deleting the same key (as #for
+	does) does not leave a trail of them to probe past.
+*/
+size_t LevelObjectMap::find(name_t const & name) const
+{
+	if (_slots.empty()) return size_t(-1);
+
+	size_t mask = _slots.size() - 1;
+	size_t free = size_t(-1);
+
+	for (size_t slot = name.hash() & mask;; slot = (slot + 1) & mask)
+	{
+		size_t index = _slots[slot];
+
+		if (!index)
+			return free != size_t(-1) ? free : slot;
+
+		if (index == size_t(-1))
+		{
+			if (free == size_t(-1)) free = slot;
+		}
+		else if (_entries[index - 1].pair.first == name)
+			return slot;
+	}
+}
+void LevelObjectMap::flatten(entry_list_t & entries, bool keepIndex) const
+{
+	size_t end = getEnd();
+
+	entries.reserve(end);
+
+	for (size_t index = 0; index < end; ++index)
+	{
+		Entry const * entry = getEntry(index);
+
+		if (entry)
+		{
+			entries.push_back(*entry);
+			entries.back().isOverride = false;
+		}
+		else if (keepIndex)
 		{
-			_objList.erase(it);
-			break;
+			Entry dead = {pair_t(name_t(""), obj_t()), false, false, false};
+
+			entries.push_back(dead);
 		}
 	}
 }
 obj_t LevelObjectMap::get(name_t const & name)
 {
-	if (!has(name))
-		throw NoSuchElementException(name.getString());
+	size_t slot = find(name);
 
-	return _objMap[name];
+	if (isUsed(slot))
+		return _entries[_slots[slot] - 1].pair.second;
+
+	if (_base)
+		return _base->map.get(name);
+
+	throw NoSuchElementException(name.getString());
 }
 bool LevelObjectMap::has(name_t const & name) const
 {
-	if (_objMap.find(name) == _objMap.end())
-		return false;
+	size_t slot = find(name);
+
+	return isUsed(slot) || (_base && _base->map.has(name));
+}
+
+LevelObjectMap::Layer * LevelObjectMap::materialize()
+{
+	entry_list_t entries;
+	flatten(entries, true);
+
+	_entries.swap(entries);
+
+	_countDead = 0;
+
+	FOREACH_T(entry_list_t, it, _entries)
+	{
+		if (!it->isLive) ++_countDead;
+	}
+
+	Layer * base = _base;
+	_base = NULL;
+
+	reindex(_entries.size() - _countDead);
+
+	return base;
+}
+
+/*
+	Drops dead entries and rebuilds the table for at least size entries.
+	Only called when adding, so iterators are not invalidated by del.
+*/
+void LevelObjectMap::rehash(size_t size)
+{
+	if (_countDead)
+	{
+		entry_list_t entries;
+		entries.reserve(_entries.size() - _countDead);
+
+		FOREACH_T(entry_list_t, it, _entries)
+		{
+			if (it->isLive)
+				entries.push_back(*it);
+		}
 
-	return true;
+		_entries.swap(entries);
+		_countDead = 0;
+	}
+
+	reindex(size);
 }
+/*
+	Rebuilds the table for at least size entries, leaving _entries alone.
+*/
+void LevelObjectMap::reindex(size_t size)
+{
+	size_t slotCount = 16;
+
+	while (slotCount < size * 4)
+		slotCount *= 2;
+
+	_slots.assign(slotCount, 0);
+
+	size_t mask = slotCount - 1;
+
+	for (size_t index = 0; index < _entries.size(); ++index)
+	{
+		if (!_entries[index].isKeyed || !_entries[index].isLive)
+			continue;
+
+		size_t slot = _entries[index].pair.first.hash() & mask;
+
+		while (_slots[slot])
+			slot = (slot + 1) & mask;
 
+		_slots[slot] = index + 1;
+	}
+}
+
+void LevelObjectMap::release(Layer * layer)
+{
+	if (layer && --layer->refCount == 0)
+		delete layer;
+}
+
+/*
+	Moves everything into a new layer, which this map then uses as its base.
+	A map that only has a base already just hands that out.
+*/
+LevelObjectMap::Layer * LevelObjectMap::share()
+{
+	if (!_base || !_entries.empty())
+	{
+		Layer * layer = new Layer();
+
+		flatten(layer->map._entries, false);
+
+		if (!layer->map._entries.empty())
+			layer->map.reindex(layer->map._entries.size());
+
+		entry_list_t().swap(_entries);
+		std::vector<size_t>().swap(_slots);
+
+		_countDead = 0;
+
+		release(_base);
+		_base = layer;
+	}
+
+	++_base->refCount;
+
+	return _base;
+}
+
+void LevelObjectMap::swap(LevelObjectMap & other)
+{
+	_entries.swap(other._entries);
+	_slots.swap(other._slots);
+
+	std::swap(_base, other._base);
+	std::swap(_countDead, other._countDead);
+}
+
+/*
+	Adding to a map with nothing in it yet, which is what addBase does for
+	a new object, shares the other map's entries instead of copying them.
+*/
 LevelObjectMap & LevelObjectMap::operator += (LevelObjectMap & other)
 {
+	stats_merge.add();
+
+	if (_entries.empty() && !_base)
+	{
+		if (!other._entries.empty() || other._base)
+			_base = other.share();
+
+		return *this;
+	}
+
 	FOREACH_T(LevelObjectMap, it, other)
 		add(it->first, other.get(it->first));
 
 	return *this;
 }
 
+LevelObjectMap & LevelObjectMap::operator = (LevelObjectMap const & other)
+{
+	LevelObjectMap map(other);
+
+	swap(map);
+
+	return *this;
+}
+
 
 
@@ -18,33 +18,121 @@
 */
 
 /*
-
+	2026/10/17 - Replaced the map and list with a single insertion-ordered
+		hash table.
+	2026/10/17 - Added shared base layers for derived objects.
 */
 
 #ifndef LEVELOBJECTMAP_H
 #define LEVELOBJECTMAP_H
 
 #include "LevelObjectName.hpp"
+#include "LevelObjectPointer.hpp"
 
 #include "../types.hpp"
 
-#include <list>
-#include <map>
 #include <utility>
+#include <vector>
 
 
 
+/*
+	Keys are kept in the order they were added. Entries are stored in that
+	order in a vector, and an open-addressing table indexes them by name.
+	Deleting only marks the entry dead, so iterators stay valid while
+	deleting (#delete volatile relies on that). Dead entries are dropped the
+	next time the table needs to grow.
+
+	A map that gets all of its keys from a base (as with LINEDEF line1 :
+	line0) does not copy them. Instead, it shares a read-only layer holding
+	the base's entries and only keeps the keys set on it since, which are
+	looked up first. Changing a key of the layer adds an override that
+	iterates in the layer key's place. Deleting one folds the whole layer
+	into the map first, keeping every entry's index so that iterators are
+	not disturbed.
+*/
 class LevelObjectMap
 {
 	public:
 		typedef std::pair<name_t, obj_t> pair_t;
-		typedef std::list<pair_t> list_t;
-		typedef std::map<name_t, obj_t> map_t;
-		typedef list_t::const_iterator const_iterator;
-		typedef list_t::iterator iterator;
+
+	private:
+		struct Entry
+		{
+			pair_t pair;
+			bool   isKeyed;
+			bool   isLive;
+			bool   isOverride; // replaces the key in _base
+		};
+
+		struct Layer;
+
+		typedef std::vector<Entry> entry_list_t;
+
+	public:
+		/*
+			Entries of the base layer are shared, so nothing may be changed
+			through an iterator.
+		*/
+		template<typename M, typename V>
+		class Iterator
+		{
+			public:
+				Iterator() : _map(NULL), _index(0), _pair(NULL) {}
+				Iterator(M * map, size_t index) : _map(map), _index(index), _pair(NULL) {skipForward();}
+
+				template<typename M2, typename V2>
+				Iterator(Iterator<M2, V2> const & other) : _map(other._map), _index(other._index), _pair(other._pair) {}
+
+				V & operator * () const {return *_pair;}
+				V * operator -> () const {return _pair;}
+
+				Iterator & operator ++ () {++_index; skipForward(); return *this;}
+				Iterator & operator -- () {--_index; skipBackward(); return *this;}
+				Iterator operator ++ (int) {Iterator it(*this); ++*this; return it;}
+				Iterator operator -- (int) {Iterator it(*this); --*this; return it;}
+
+				template<typename M2, typename V2>
+				bool operator == (Iterator<M2, V2> const & other) const {return _index == other._index;}
+				template<typename M2, typename V2>
+				bool operator != (Iterator<M2, V2> const & other) const {return _index != other._index;}
+
+			private:
+				// Going back from the first entry wraps around to -1,
+				// which ++ then brings back to 0, as with a list.
+				void skipBackward()
+				{
+					while (_index != size_t(-1) && !(_pair = getPair())) --_index;
+				}
+				void skipForward()
+				{
+					_pair = NULL;
+
+					size_t end = _map->getEnd();
+
+					while (_index < end && !(_pair = getPair())) ++_index;
+				}
+
+				V * getPair() const
+				{
+					Entry const * entry = _map->getEntry(_index);
+
+					return entry ? const_cast<V *>(&entry->pair) : NULL;
+				}
+
+				M *    _map;
+				size_t _index;
+				V *    _pair;
+
+				template<typename M2, typename V2> friend class Iterator;
+		};
+
+		typedef Iterator<LevelObjectMap const, pair_t const> const_iterator;
+		typedef Iterator<LevelObjectMap, pair_t> iterator;
 
 		explicit LevelObjectMap();
 		         LevelObjectMap(LevelObjectMap const &);
+		        ~LevelObjectMap();
 
 		void  add(name_t const &, obj_t);
 		void  add(obj_t);
@@ -52,20 +140,99 @@ class LevelObjectMap
 		obj_t get(name_t const &);
 		bool  has(name_t const &) const;
 
-		const_iterator begin() const {return _objList.begin();}
-		      iterator begin()       {return _objList.begin();}
-		const_iterator end() const {return _objList.end();}
-		      iterator end()       {return _objList.end();}
+		void swap(LevelObjectMap &);
+
+		const_iterator begin() const {return const_iterator(this, 0);}
+		      iterator begin()       {return iterator(this, 0);}
+		const_iterator end() const {return const_iterator(this, getEnd());}
+		      iterator end()       {return iterator(this, getEnd());}
 
 		LevelObjectMap & operator += (LevelObjectMap &);
 
+		LevelObjectMap & operator = (LevelObjectMap const &);
+
 	private:
-		map_t  _objMap;
-		list_t _objList;
+		// Returns the slot for name, either holding it or empty.
+		size_t find(name_t const & name) const;
+
+		// Copies every entry in iteration order. With keepIndex, entries
+		// that are not iterated are kept dead, so indexes do not change.
+		void flatten(entry_list_t & entries, bool keepIndex) const;
+
+		// Returns the entry iterated at index, or NULL if there is none.
+		Entry const * getEntry(size_t index) const;
+
+		// Iteration covers the entries of _base, then those of _entries.
+		size_t getEnd() const;
+
+		// Folds _base into _entries. The old base is returned, for the
+		// caller to release.
+		Layer * materialize();
+
+		void rehash(size_t size);
+		void reindex(size_t size);
+
+		// Makes this map a base layer, and returns it for another map.
+		Layer * share();
+
+		bool isUsed(size_t slot) const {return slot != size_t(-1) && _slots[slot] && _slots[slot] != size_t(-1);}
+
+		static void release(Layer * layer);
+
+		entry_list_t _entries;
+
+		// Entry index + 1, 0 for empty or -1 for a deleted entry. The size
+		// is always a power of two.
+		std::vector<size_t> _slots;
+
+		// Never changed while shared, and never has a base of its own.
+		Layer * _base;
+
+		size_t _countDead;
+};
+
+struct LevelObjectMap::Layer
+{
+	Layer() : map(), refCount(1) {}
+
+	LevelObjectMap map;
+
+	size_t refCount;
 };
 
 
 
+inline LevelObjectMap::Entry const * LevelObjectMap::getEntry(size_t index) const
+{
+	size_t sizeBase = _base ? _base->map._entries.size() : 0;
+
+	if (index < sizeBase)
+	{
+		Entry const & entry = _base->map._entries[index];
+
+		if (entry.isKeyed && !_entries.empty())
+		{
+			size_t slot = find(entry.pair.first);
+
+			if (isUsed(slot))
+				return &_entries[_slots[slot] - 1];
+		}
+
+		return &entry;
+	}
+
+	Entry const & entry = _entries[index - sizeBase];
+
+	return entry.isLive && !entry.isOverride ? &entry : NULL;
+}
+
+inline size_t LevelObjectMap::getEnd() const
+{
+	return (_base ? _base->map._entries.size() : 0) + _entries.size();
+}
+
+
+
 #endif /* LEVELOBJECTMAP_H */
 
 
@@ -19,6 +19,8 @@
 
 /*
 	03/02/2010 - Original version.
+	2026/10/17 - Name parts are interned in a symbol table.
+	2026/10/17 - Symbols keep a table of their indexed names.
 */
 
 #include "LevelObjectName.hpp"
@@ -32,6 +34,97 @@
 
 #include "../../common/foreach.hpp"
 
+#include <deque>
+#include <map>
+
+
+
+/*
+	Every distinct name part is stored once, and names only keep its index.
+	ID 0 is always the empty string. Function-local so that the static names
+	below can be made before anything else.
+*/
+namespace
+{
+	struct SymbolLess
+	{
+		bool operator () (std::string const * l, std::string const * r) const
+		{
+			return *l < *r;
+		}
+	};
+
+	class SymbolTable
+	{
+	public:
+		SymbolTable()
+		{
+			intern(std::string());
+		}
+
+		std::string const & get(unsigned id) const
+		{
+			return _strings[id];
+		}
+
+		/*
+			Returns the ID of the string of id followed by index. Small
+			indexes are kept in a table, since they are what arrays use.
+		*/
+		unsigned index(unsigned id, int_s_t index)
+		{
+			if (index < 0 || index >= INDEX_MAX)
+				return intern(_strings[id] + make_string(index));
+
+			if (_indexes.size() <= id)
+				_indexes.resize(id + 1);
+
+			if (_indexes[id].size() <= size_t(index))
+				_indexes[id].resize(size_t(index) + 1, 0);
+
+			// ID 0 is the empty string, which no index can make.
+			if (!_indexes[id][index])
+			{
+				unsigned indexID = intern(_strings[id] + make_string(index));
+
+				_indexes[id][index] = indexID;
+			}
+
+			return _indexes[id][index];
+		}
+
+		unsigned intern(std::string const & s)
+		{
+			std::map<std::string const *, unsigned, SymbolLess>::iterator it(_ids.find(&s));
+
+			if (it != _ids.end()) return it->second;
+
+			unsigned id = (unsigned)_strings.size();
+
+			_strings.push_back(s);
+			_ids.insert(std::make_pair(&_strings.back(), id));
+
+			return id;
+		}
+
+	private:
+		enum {INDEX_MAX = 0x10000};
+
+		// A deque does not move its elements, so _ids can point into it.
+		std::deque<std::string> _strings;
+		std::map<std::string const *, unsigned, SymbolLess> _ids;
+
+		std::vector<std::vector<unsigned> > _indexes;
+	};
+
+	SymbolTable & symbols()
+	{
+		static SymbolTable table;
+
+		return table;
+	}
+}
+
 
 
 LevelObjectName const LevelObjectName::name_return_value(".return_value");
@@ -39,24 +132,40 @@ LevelObjectName const LevelObjectName::name_return_type(".return_type");
 
 
 
-LevelObjectName::LevelObjectName() {}
-LevelObjectName::LevelObjectName(LevelObjectName const & other, size_t count)
+LevelObjectName::LevelObjectName() : _size(0), _more(NULL)
 {
-	for (size_t index = 0; index < other._name.size() && index < count; ++index)
-		this->_name.push_back(other._name[index]);
+	_ids[0] = 0;
 }
-LevelObjectName::LevelObjectName(char const * name)
+LevelObjectName::LevelObjectName(LevelObjectName const & other, size_t count) : _size(0), _more(NULL)
 {
-	this->_name.push_back(name);
+	resize(count < other._size ? count : other._size);
+
+	for (size_t index = 0; index < _size; ++index)
+		(_more ? _more : _ids)[index] = other.at(index);
+
+	if (_more) _ids[0] = _more[0];
 }
-LevelObjectName::LevelObjectName(std::vector<std::string> const & nameVector) : _name(nameVector)
+LevelObjectName::LevelObjectName(char const * name) : _size(1), _more(NULL)
 {
+	_ids[0] = symbols().intern(name);
+}
+LevelObjectName::LevelObjectName(std::vector<std::string> const & nameVector) : _size(0), _more(NULL)
+{
+	resize(nameVector.size());
+
+	for (size_t index = 0; index < _size; ++index)
+		(_more ? _more : _ids)[index] = symbols().intern(nameVector[index]);
 
+	if (_more) _ids[0] = _more[0];
+}
+LevelObjectName::~LevelObjectName()
+{
+	delete[] _more;
 }
 
 bool LevelObjectName::empty() const
 {
-	return this->_name.size() == 1 && this->_name[0].empty();
+	return _size == 1 && _ids[0] == 0;
 }
 
 /*
@@ -66,9 +175,11 @@ bool LevelObjectName::empty() const
 */
 bool LevelObjectName::isPrivate() const
 {
-	if (this->_name.size() != 1) return false;
+	if (_size != 1) return false;
+
+	std::string const & name(getString());
 
-	return (this->_name[0].size() > 1 && this->_name[0][0] == '_' && this->_name[0][1] == '_');
+	return (name.size() > 1 && name[0] == '_' && name[1] == '_');
 }
 
 /*
@@ -80,9 +191,11 @@ bool LevelObjectName::isPrivate() const
 */
 bool LevelObjectName::isVolatile() const
 {
-	if (this->_name.size() != 1) return false;
+	if (_size != 1) return false;
 
-	return (this->_name[0].size() > 1 && this->_name[0][0] == '_' && this->_name[0][1] != '_');
+	std::string const & name(getString());
+
+	return (name.size() > 1 && name[0] == '_' && name[1] != '_');
 }
 
 LevelObjectName LevelObjectName::getFirst() const
@@ -93,49 +206,82 @@ LevelObjectName LevelObjectName::getRest() const
 {
 	LevelObjectName newName;
 
-	for (size_t index = 1; index < this->_name.size(); ++index)
-		newName._name.push_back(this->_name[index]);
+	if (_size < 2) return newName;
+
+	newName.resize(_size - 1);
+
+	for (size_t index = 0; index < newName._size; ++index)
+		(newName._more ? newName._more : newName._ids)[index] = at(index + 1);
+
+	if (newName._more) newName._ids[0] = newName._more[0];
 
 	return newName;
 }
 
-std::string LevelObjectName::getString(size_t index) const
+LevelObjectName LevelObjectName::getIndexed(int_s_t index) const
 {
-	return this->_name[index];
+	LevelObjectName newName(*this);
+
+	if (!_size) return newName;
+
+	unsigned & id((newName._more ? newName._more : newName._ids)[_size - 1]);
+
+	id = symbols().index(id, index);
+
+	if (newName._more) newName._ids[0] = newName._more[0];
+
+	return newName;
 }
 
-size_t LevelObjectName::size() const
+std::string const & LevelObjectName::getString(size_t index) const
 {
-	return this->_name.size();
+	return symbols().get(at(index));
 }
 
-LevelObjectName & LevelObjectName::operator = (LevelObjectName const & other)
+/*
+	Sets the size, discarding the old IDs.
+*/
+void LevelObjectName::resize(size_t size)
 {
-	_name = other._name;
+	delete[] _more;
+	_more = NULL;
 
-	return *this;
+	_size = size;
+	_ids[0] = 0;
+
+	if (_size > INLINE_SIZE)
+		_more = new unsigned[_size];
 }
 
-bool LevelObjectName::operator == (LevelObjectName const & other) const
+size_t LevelObjectName::size() const
 {
-	return this->_name[0] == other._name[0];
+	return _size;
 }
-bool LevelObjectName::operator < (LevelObjectName const & other) const
+
+LevelObjectName & LevelObjectName::operator = (LevelObjectName const & other)
 {
-	// TODO This could cause problems if a multi-part name was used for a
-	// key. On the other hand, that should never happen, so maybe throw an
-	// exception?
-	return this->_name[0] < other._name[0];
+	if (this == &other) return *this;
+
+	resize(other._size);
+
+	for (size_t index = 0; index < _size; ++index)
+		(_more ? _more : _ids)[index] = other.at(index);
+
+	if (_more) _ids[0] = _more[0];
+
+	return *this;
 }
 
 
 
 std::ostream & operator << (std::ostream & out, LevelObjectName const & in)
 {
-	out << in._name[0];
+	if (!in._size) return out;
+
+	out << in.getString(0);
 
-	for (size_t index = 1; index < in._name.size(); ++index)
-		out << '.' << in._name[index];
+	for (size_t index = 1; index < in._size; ++index)
+		out << '.' << in.getString(index);
 
 	return out;
 }
@@ -24,11 +24,16 @@
 
 	2010/03/02 - Original version.
 	2010/06/24 - Make constructors explicit.
+	2026/10/17 - Name parts are interned, so a name is a short list of
+		IDs. Names of up to four parts need no allocation.
+	2026/10/17 - Added getIndexed, for v[index].
 */
 
 #ifndef LEVELOBJECTNAME_H
 #define LEVELOBJECTNAME_H
 
+#include "../types.hpp"
+
 #include <ostream>
 #include <string>
 #include <vector>
@@ -45,6 +50,7 @@ class LevelObjectName
 		*/
 		explicit LevelObjectName(char const * name);
 		explicit LevelObjectName(std::vector<std::string> const & nameVec);
+		~LevelObjectName();
 
 		bool empty() const;
 
@@ -54,14 +60,25 @@ class LevelObjectName
 		LevelObjectName getFirst() const;
 		LevelObjectName getRest() const;
 
-		std::string getString(size_t index = 0) const;
+		/*
+			Returns name[index], which is this name with index appended
+			to its last part. Each part keeps a table of its indexed
+			names, so this does not format or look up a string.
+		*/
+		LevelObjectName getIndexed(int_s_t index) const;
+
+		std::string const & getString(size_t index = 0) const;
+
+		// Only the first part is used, the same as for comparing.
+		size_t hash() const {return _ids[0];}
 
 		size_t size() const;
 
 		LevelObjectName & operator = (LevelObjectName const & other);
 
-		bool operator == (LevelObjectName const & other) const;
-		bool operator <  (LevelObjectName const & other) const;
+		// Compares IDs, so the order is that of interning, not the text.
+		bool operator == (LevelObjectName const & other) const {return _ids[0] == other._ids[0];}
+		bool operator <  (LevelObjectName const & other) const {return _ids[0] <  other._ids[0];}
 
 
 
@@ -81,7 +98,17 @@ class LevelObjectName
 		*/
 		explicit LevelObjectName();
 
-		std::vector<std::string> _name;
+		enum {INLINE_SIZE = 4};
+
+		unsigned at(size_t index) const {return _more ? _more[index] : _ids[index];}
+
+		void resize(size_t size);
+
+		size_t _size;
+
+		// The first ID is always in _ids, even if the rest are in _more.
+		unsigned   _ids[INLINE_SIZE];
+		unsigned * _more;
 };
 
 
@@ -23,9 +23,14 @@
 	2010/02/06 - Original version.
 	2010/02/16 - No more cmp function here.
 	2010/06/30 - Inlined the functions.
+	2026/10/17 - Added _shared.
 */
 
 #include "LevelObjectPointer.hpp"
 
 
 
+bool LevelObjectPointer::_shared = false;
+
+
+
@@ -23,6 +23,7 @@
 	2010/02/06 - Original version.
 	2010/02/16 - No more cmp function here.
 	2010/06/30 - Inlined the functions.
+	2026/10/17 - Added setShared() for encoding on several threads.
 */
 
 #ifndef LEVELOBJECTPOINTER_H
@@ -50,23 +51,58 @@ class LevelObjectPointer
 
 		LevelObjectPointer & operator = (LevelObjectPointer const &);
 
+		/*
+			While set, reference counts are changed atomically, so that
+			pointers to the same object can be copied on more than one
+			thread. Nothing may be freed while it is set.
+		*/
+		static void setShared(bool shared) {_shared = shared;}
+
 	private:
+		static void ref(LevelObject * p);
+		static bool unref(LevelObject * p);
+
 		LevelObject * _p;
+
+		static bool _shared;
 };
 
 
 
+inline void LevelObjectPointer::ref(LevelObject * p)
+{
+	#if USE_THREADS
+	if (_shared)
+	{
+		__atomic_add_fetch(&p->_refCount, 1, __ATOMIC_RELAXED);
+		return;
+	}
+	#endif
+
+	++p->_refCount;
+}
+// Returns true if that was the last pointer.
+inline bool LevelObjectPointer::unref(LevelObject * p)
+{
+	#if USE_THREADS
+	if (_shared)
+		return __atomic_sub_fetch(&p->_refCount, 1, __ATOMIC_ACQ_REL) == 0;
+	#endif
+
+	return --p->_refCount == 0;
+}
+
 inline LevelObjectPointer::LevelObjectPointer(LevelObject * p) : _p(p)
 {
-	if (_p) ++_p->_refCount;
+	if (_p) ref(_p);
 }
 inline LevelObjectPointer::LevelObjectPointer(LevelObjectPointer const & p) : _p(p._p)
 {
-	if (_p) ++_p->_refCount;
+	if (_p) ref(_p);
 }
 inline LevelObjectPointer::~LevelObjectPointer()
 {
-	if (_p && (--_p->_refCount == 0))
+	if (_p && unref(_p))
 		delete _p;
 }
 
@@ -94,9 +130,9 @@ inline LevelObjectPointer & LevelObjectPointer::operator = (const LevelObjectPoi
 
 	this->_p = p._p;
 
-	if (this->_p) ++_p->_refCount;
+	if (this->_p) ref(_p);
 
-	if (old && --old->_refCount == 0)
+	if (old && unref(old))
 		delete old;
 
 	return *this;
@@ -32,6 +32,10 @@
 		bool).
 	2010/02/28 - Update for lo_type enum.
 	2010/06/24 - Update for explicit name_t constructors.
+	2026/10/17 - Added addData(CodeDHLX) to run compiled DHLX blocks.
+	2026/10/17 - Added addData(CodeDDL). DDL blocks are only read once.
+	2026/10/17 - Objects being added are named for --trace.
+	2026/10/17 - DDL statements are timed for --profile-source.
 */
 
 #include "LevelObject.hpp"
@@ -39,10 +43,13 @@
 #include "LevelObjectMap.hpp"
 #include "LevelObjectName.hpp"
 
+#include "../CodeDDL.hpp"
+#include "../CodeDHLX.hpp"
 #include "../compound_objects.hpp"
 #include "../global_object.hpp"
 #include "../math.hpp"
 #include "../options.hpp"
+#include "../profile.hpp"
 #include "../scripts.hpp"
 #include "../SourceStream.hpp"
 #include "../SourceToken.hpp"
@@ -64,7 +71,6 @@
 
 #include <cstdlib>
 #include <iostream>
-#include <sstream>
 
 
 
@@ -81,6 +87,193 @@ void LevelObject::addBase(name_t const & base)
 	_data.getObjMap() += other->_data.getObjMap();
 }
 
+void LevelObject::addData(CodeDHLX const & code)
+{
+	LevelObjectStack los(this);
+
+	FOREACH_T_CONST(std::vector<CodeDHLX::Op>, it, code._ops)
+	{
+		CodeDHLX::Op const & op(*it);
+
+		switch (op.op)
+		{
+		case CodeDHLX::OP_ASSIGN:
+		case CodeDHLX::OP_BLOCK:
+		case CodeDHLX::OP_DECLARE:
+		{
+			// If the first identifier has since changed from or to being
+			// a type, let the scanner sort it out.
+			if (type_t::has_type(op.data) != op.hasType)
+			{
+				SourceScannerDHLX sc(op.statement);
+				addObject(sc);
+				break;
+			}
+
+			type_t newType(type_t::type_null);
+
+			if (op.hasType)
+				newType = type_t::get_type(op.data);
+
+			name_t newName(op.name.get());
+
+			ProfileObject profileObject(newName);
+
+			obj_t newObject(NULL);
+
+			if (newType == type_t::type_null)
+			{
+				if (hasObject(newName))
+				{
+					newObject = getObject(newName);
+					newType   = newObject->getType();
+				}
+				else
+				{
+					newType = type_t::get_default_type(newName, _type);
+				}
+			}
+
+			std::vector<name_t> baseName;
+
+			for (size_t index = 0; index < op.base.size(); ++index)
+				baseName.push_back(op.base[index].get());
+
+			if (op.op == CodeDHLX::OP_ASSIGN)
+			{
+				SourceScannerDHLX sc(op.sc);
+
+				if (newType.getMode() == type_t::MODE_VALUE)
+					newObject = create(newType, sc);
+				else
+					newObject = get_object(parse<int_s_t>(sc), newType);
+
+				sc.get(SourceTokenDHLX::TT_OP_SEMICOLON);
+			}
+			else
+			{
+				if (newObject == NULL) newObject = create(newType);
+
+				for (size_t index = 0; index < baseName.size(); ++index)
+					newObject->addBase(baseName[index]);
+
+				if (op.op == CodeDHLX::OP_BLOCK)
+				{
+					newObject->addData(*op.code);
+
+					if ((newObject->_type.getMode() == type_t::MODE_COMPOUNDOBJECT) && !newObject->_isCompounded)
+					{
+						do_compound_object(newObject->_type.makeString(), newObject);
+						newObject->_isCompounded = true;
+					}
+				}
+			}
+
+			addObject(newName, newObject);
+		}
+			break;
+
+		case CodeDHLX::OP_BREAK:
+			_isBreaked = true;
+			break;
+
+		case CodeDHLX::OP_COMMAND:
+		{
+			SourceScannerDHLX sc(op.sc);
+			doCommand(op.data, sc);
+		}
+			break;
+
+		case CodeDHLX::OP_CONTINUE:
+			_isContinued = true;
+			break;
+
+		case CodeDHLX::OP_ELSE:
+			if (!last_if_result)
+				addData(*op.code);
+			break;
+
+		case CodeDHLX::OP_IF:
+		{
+			SourceScannerDHLX sc(op.sc);
+
+			if (parse<bool_t>(sc))
+			{
+				addData(code.getBody(op, sc));
+				last_if_result = true;
+			}
+			else
+			{
+				last_if_result = false;
+			}
+		}
+			break;
+
+		case CodeDHLX::OP_INTERPRET:
+		{
+			SourceScannerDHLX sc(op.sc);
+
+			if (!op.hasType)
+			{
+				addObject(sc);
+				break;
+			}
+
+			while (true)
+			{
+				SourceTokenDHLX st(sc.get());
+
+				if (st.getType() == SourceTokenDHLX::TT_OP_BRACE_C)
+					break;
+
+				sc.unget(st);
+
+				addObject(sc);
+			}
+		}
+			break;
+
+		case CodeDHLX::OP_RETURN:
+		{
+			SourceScannerDHLX sc(op.sc);
+
+			obj_t returnType  = getObject(name_t::name_return_type);
+			obj_t returnValue = create(returnType->_data.getType(), sc);
+
+			sc.get(SourceTokenDHLX::TT_OP_SEMICOLON);
+
+			addObject(name_t::name_return_value, returnValue);
+
+			_isReturned = 1;
+		}
+			break;
+
+		// Like the scanner version, #break and #continue only take effect
+		// at the end of the block.
+		case CodeDHLX::OP_WHILE:
+			while (true)
+			{
+				SourceScannerDHLX cond(op.sc);
+				if (!parse<bool_t>(cond)) break;
+
+				addData(*op.code);
+
+				if (_isContinued)
+				{
+					_isContinued = false;
+					continue;
+				}
+
+				if (_isBreaked)
+				{
+					_isBreaked = false;
+					break;
+				}
+			}
+			break;
+		}
+	}
+}
 void LevelObject::addData(SourceScannerDHLX & sc)
 {
 	LevelObjectStack los(this);
@@ -109,13 +302,61 @@ void LevelObject::addData(SourceScannerDHLX & sc)
 		addObject(sc);
 	}
 }
+void LevelObject::addData(CodeDDL const & code, std::string const & name)
+{
+	LevelObjectStack los(this);
+
+	code.compile();
+
+	for (size_t index = 0; index < code._statements.size(); ++index)
+	{
+		if (_isBreaked || _isContinued || _isReturned)
+			return;
+
+		SourceTokenDDL const & st(code._statements[index].st);
+
+		ProfileSource profileSource(code._sourceFile, code._sourceLine + code._statements[index].line - 1);
+
+		try
+		{
+			if (!st.getName().empty() && st.getName()[0] == '#')
+				doCommand(st.getName().substr(1), st, code.getCode(index));
+			else
+				addObject(parse_name(st.getName()), st, code.getCode(index));
+		}
+		catch (CompilerException& e)
+		{
+			PRINT_ERROR(name << ':' << code._statements[index].line << ':' << e << "\n  ->" << st << '\n');
+
+			throw;
+		}
+	}
+
+	if (code._isComplete)
+		return;
+
+	// Reading the block failed partway. Read it again up to there, so that
+	// the error comes out the same as it would have.
+	SourceStream   ss(code._data.data(), code._data.size());
+	SourceTokenDDL st;
+
+	for (size_t count = code._count; count; --count)
+	{
+		st.clear();
+		ss >> st;
+	}
+
+	addData(ss, name);
+}
 void LevelObject::addData(std::string const & data, std::string const & name)
+{
+	addData(CodeDDL(data), name);
+}
+void LevelObject::addData(SourceStream & ss, std::string const & name)
 {
 	LevelObjectStack los(this);
 
-	std::istringstream iss(data);
-	SourceStream       ss(iss);
-	SourceTokenDDL     st;
+	SourceTokenDDL st;
 
 	while (ss)
 	{
@@ -161,7 +402,7 @@ bool LevelObject::addDataIf(SourceScannerDHLX & sc)
 // will not be added.
 // If type is non-empty, evaluate values as that type before comparing,
 // otherwise take as names.
-bool LevelObject::addDataIf(std::string const & data, std::string const & value1, std::string const & value2, std::string const & opString, std::string const & type, bool checkElse)
+bool LevelObject::addDataIf(CodeDDL const & data, std::string const & value1, std::string const & value2, std::string const & opString, std::string const & type, bool checkElse)
 {
 	if (checkElse && last_if_result)
 		return false;
@@ -232,7 +473,7 @@ bool LevelObject::addDataIf(std::string const & data, std::string const & value1
 
 	#undef CHECK_CMP
 }
-bool LevelObject::addDataIf(std::string const & data, std::vector<std::string> const & value, std::string const & opString, bool checkElse)
+bool LevelObject::addDataIf(CodeDDL const & data, std::vector<std::string> const & value, std::string const & opString, bool checkElse)
 {
 	if (checkElse && last_if_result)
 		return false;
@@ -368,20 +609,26 @@ void LevelObject::addObject(name_t const & name, obj_t newObject)
 		_data.getObjMap().add(newObject);
 }
 void LevelObject::addObject(name_t const & name, SourceTokenDDL const & st)
+{
+	addObject(name, st, CodeDDL(st.getData()));
+}
+void LevelObject::addObject(name_t const & name, SourceTokenDDL const & st, CodeDDL const & data)
 {
 	if (st.empty())
 		return;
 
+	ProfileObject profileObject(name);
+
 	if (name.empty() && st.getType().empty() && st.getBase().empty() && st.getValue().empty())
 	{
-		addData(st.getData());
+		addData(data);
 		return;
 	}
 
 	// commands start with #
 	if (!name.empty() && name.getString()[0] == '#')
 	{
-		doCommand(name.getString().substr(1), st);
+		doCommand(name.getString().substr(1), st, data);
 
 		return;
 	}
@@ -389,9 +636,9 @@ void LevelObject::addObject(name_t const & name, SourceTokenDDL const & st)
 	if (name.size() != 1)
 	{
 		if (name.getString() == misc_name_global())
-			return global_object->addObject(name.getRest(), st);
+			return global_object->addObject(name.getRest(), st, data);
 
-		return getObject(name.getFirst())->addObject(name.getRest(), st);
+		return getObject(name.getFirst())->addObject(name.getRest(), st, data);
 	}
 
 	if (_data.get_dataType() != any_t::OBJMAP_T)
@@ -431,7 +678,7 @@ void LevelObject::addObject(name_t const & name, SourceTokenDDL const & st)
 	case type_t::MODE_COMPOUNDOBJECT:
 	case type_t::MODE_INLINE:
 		if (st.getValue().empty())
-			newObject = LevelObject::create(newType, st.getData(), st.getBase());
+			newObject = LevelObject::create(newType, data, st.getBase());
 
 		else
 			newObject = parse_obj(st.getValue(), newType);
@@ -485,6 +732,8 @@ void LevelObject::addObject(SourceScannerDHLX & sc)
 
 	name_t newName(parse_name(sc));
 
+	ProfileObject profileObject(newName);
+
 	obj_t newObject(NULL);
 
 	if (newType == type_t::type_null)
@@ -25,6 +25,8 @@
 
 #include "LevelObjectMap.hpp"
 
+#include "../CodeDDL.hpp"
+#include "../CodeDHLX.hpp"
 #include "../compound_objects.hpp"
 #include "../global_object.hpp"
 #include "../options.hpp"
@@ -139,15 +141,14 @@ void LevelObject::doCommand(std::string const & command, SourceScannerDHLX & sc)
 	else if (command == command_name_while())
 	{
 		SourceScannerDHLX cond(sc.getblock(SourceTokenDHLX::TT_OP_PARENTHESIS_O, SourceTokenDHLX::TT_OP_PARENTHESIS_C));
-		SourceScannerDHLX data(sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C));
+		CodeDHLX          data(sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C));
 
 		while (true)
 		{
 			SourceScannerDHLX condcopy(cond);
 			if (!parse<bool_t>(condcopy)) break;
 
-			SourceScannerDHLX datacopy(data);
-			addData(datacopy);
+			addData(data);
 
 			if (_isContinued)
 			{
@@ -167,6 +168,10 @@ void LevelObject::doCommand(std::string const & command, SourceScannerDHLX & sc)
 }
 
 void LevelObject::doCommand(std::string const & command, SourceTokenDDL const & st)
+{
+	doCommand(command, st, CodeDDL(st.getData()));
+}
+void LevelObject::doCommand(std::string const & command, SourceTokenDDL const & st, CodeDDL const & data)
 {
 	// # break
 	if (command == command_name_break())
@@ -240,7 +245,7 @@ void LevelObject::doCommand(std::string const & command, SourceTokenDDL const &
 	{
 		do
 		{
-			addData(st.getData());
+			addData(data);
 
 			if (_isContinued)
 			{
@@ -259,15 +264,15 @@ void LevelObject::doCommand(std::string const & command, SourceTokenDDL const &
 
 	// # else { data }
 	else if (command == command_name_else())
-		addDataIf(st.getData(), "", "", "", "", true);
+		addDataIf(data, "", "", "", "", true);
 
 	// # else if cmp : value1 : op : value2 : [type] { data }
 	else if (command == command_name_elseifcmp())
-		addDataIf(st.getData(), st.getBase(0), st.getBase(2), st.getBase(1), st.getBase(3), true);
+		addDataIf(data, st.getBase(0), st.getBase(2), st.getBase(1), st.getBase(3), true);
 
 	// # else if* : name... { data }
 	else if (command.substr(0, 6) == command_name_elseif())
-		addDataIf(st.getData(), st.getBase(), command.substr(6), true);
+		addDataIf(data, st.getBase(), command.substr(6), true);
 
 	// # error : message
 	// prints message and counts towards error-limit
@@ -296,7 +301,7 @@ void LevelObject::doCommand(std::string const & command, SourceTokenDDL const &
 
 		while (forIterObj->_data < forStopObj->_data)
 		{
-			addData(st.getData());
+			addData(data);
 
 			forIterObj->_data += forStepObj->_data;
 
@@ -318,11 +323,11 @@ void LevelObject::doCommand(std::string const & command, SourceTokenDDL const &
 
 	// # if cmp : value1 : op : value2 : [type] { data }
 	else if (command == command_name_ifcmp())
-		addDataIf(st.getData(), st.getBase(0), st.getBase(2), st.getBase(1), st.getBase(3));
+		addDataIf(data, st.getBase(0), st.getBase(2), st.getBase(1), st.getBase(3));
 
 	// # if* : name... { data }
 	else if (command.substr(0, 2) == command_name_if())
-		addDataIf(st.getData(), st.getBase(), command.substr(2));
+		addDataIf(data, st.getBase(), command.substr(2));
 
 	// # info : message
 	else if (command == command_name_info())
@@ -395,7 +400,7 @@ void LevelObject::doCommand(std::string const & command, SourceTokenDDL const &
 	{
 		while (parse<bool_t>(st.getBase(0)))
 		{
-			addData(st.getData());
+			addData(data);
 
 			if (_isContinued)
 			{
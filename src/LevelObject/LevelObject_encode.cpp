@@ -20,6 +20,11 @@
 /*
 	2010/02/28 - Update for lo_type enum.
 	2010/06/24 - Update for explicit name_t constructors.
+	2026/10/17 - Binary encoders read keys through FieldSlots.
+	2026/10/17 - encodeDoom no longer moves keys to ExtraData itself, so
+		that encoding leaves the objects unchanged.
+	2026/10/17 - encodeUDMF and encodeUSDF write to a TextWriter, and leave
+		out indentation and comments with --do-compact-text.
 */
 
 #include "LevelObject.hpp"
@@ -29,6 +34,7 @@
 
 #include "../global_object.hpp"
 #include "../options.hpp"
+#include "../TextWriter.hpp"
 #include "../types.hpp"
 
 #include "../exceptions/InvalidTypeException.hpp"
@@ -42,6 +48,7 @@
 
 #include <climits>
 #include <sstream>
+#include <vector>
 
 
 
@@ -124,32 +131,245 @@ static const name_t name_x                ("x");
 static const name_t name_y                ("y");
 static const name_t name_zoneboundry      ("zoneboundry");
 
-#define CHECKFLAG(ASSIGN, FLAG, VALUE) \
-if (hasObject(FLAG) && convert<bool_t, obj_t>(getObject(FLAG))) \
+
+
+/*
+	The keys read by the binary encoders. Each object's keys are resolved to
+	these once, by FieldSlots, rather than being looked up for every use.
+*/
+#define ENCODE_FIELDS(FIELD) \
+	FIELD(ambush) \
+	FIELD(angle) \
+	FIELD(arg0) \
+	FIELD(arg1) \
+	FIELD(arg2) \
+	FIELD(arg3) \
+	FIELD(arg4) \
+	FIELD(blockeverything) \
+	FIELD(blockfloaters) \
+	FIELD(blocking) \
+	FIELD(blockmonsters) \
+	FIELD(blockplayers) \
+	FIELD(blocksound) \
+	FIELD(checkswitchrange) \
+	FIELD(clipmidtex) \
+	FIELD(coop) \
+	FIELD(dm) \
+	FIELD(dontdraw) \
+	FIELD(dontpegbottom) \
+	FIELD(dontpegtop) \
+	FIELD(dormant) \
+	FIELD(firstsideonly) \
+	FIELD(flags) \
+	FIELD(flags2) \
+	FIELD(friend) \
+	FIELD(height) \
+	FIELD(heightceiling) \
+	FIELD(heightfloor) \
+	FIELD(id) \
+	FIELD(impact) \
+	FIELD(invisible) \
+	FIELD(jumpover) \
+	FIELD(lightlevel) \
+	FIELD(mapped) \
+	FIELD(midtex3d) \
+	FIELD(missilecross) \
+	FIELD(monsteractivate) \
+	FIELD(monstercross) \
+	FIELD(offsetx) \
+	FIELD(offsety) \
+	FIELD(passuse) \
+	FIELD(playercross) \
+	FIELD(playerpush) \
+	FIELD(playeruse) \
+	FIELD(railing) \
+	FIELD(repeatspecial) \
+	FIELD(secret) \
+	FIELD(sector) \
+	FIELD(sideback) \
+	FIELD(sidefront) \
+	FIELD(single) \
+	FIELD(skill1) \
+	FIELD(skill2) \
+	FIELD(skill3) \
+	FIELD(skill4) \
+	FIELD(skill5) \
+	FIELD(special) \
+	FIELD(standing) \
+	FIELD(texturebottom) \
+	FIELD(textureceiling) \
+	FIELD(texturefloor) \
+	FIELD(texturemiddle) \
+	FIELD(texturetop) \
+	FIELD(translucent) \
+	FIELD(twosided) \
+	FIELD(type) \
+	FIELD(v1) \
+	FIELD(v2) \
+	FIELD(wrapmidtex) \
+	FIELD(x) \
+	FIELD(y) \
+	FIELD(zoneboundry)
+
+enum Field
+{
+	#define FIELD(NAME) FIELD_##NAME,
+	ENCODE_FIELDS(FIELD)
+	#undef FIELD
+
+	FIELD_COUNT
+};
+
+static name_t const * const field_names[FIELD_COUNT] =
+{
+	#define FIELD(NAME) &name_##NAME,
+	ENCODE_FIELDS(FIELD)
+	#undef FIELD
+};
+
+// The fields each type has, ending with FIELD_COUNT.
+static Field const schema_linedef[] =
+{
+	FIELD_v1, FIELD_v2, FIELD_flags, FIELD_flags2, FIELD_id, FIELD_special,
+	FIELD_arg0, FIELD_arg1, FIELD_arg2, FIELD_arg3, FIELD_arg4,
+	FIELD_sidefront, FIELD_sideback, FIELD_blocking, FIELD_blockmonsters,
+	FIELD_twosided, FIELD_dontpegtop, FIELD_dontpegbottom, FIELD_secret,
+	FIELD_blocksound, FIELD_dontdraw, FIELD_mapped, FIELD_passuse,
+	FIELD_repeatspecial, FIELD_monsteractivate, FIELD_blockplayers,
+	FIELD_blockeverything, FIELD_playeruse, FIELD_playercross,
+	FIELD_monstercross, FIELD_impact, FIELD_playerpush, FIELD_missilecross,
+	FIELD_zoneboundry, FIELD_jumpover, FIELD_blockfloaters,
+	FIELD_clipmidtex, FIELD_wrapmidtex, FIELD_midtex3d,
+	FIELD_checkswitchrange, FIELD_firstsideonly, FIELD_railing,
+	FIELD_translucent,
+	FIELD_COUNT
+};
+static Field const schema_sector[] =
+{
+	FIELD_heightfloor, FIELD_heightceiling, FIELD_texturefloor,
+	FIELD_textureceiling, FIELD_lightlevel, FIELD_special, FIELD_id,
+	FIELD_COUNT
+};
+static Field const schema_sidedef[] =
+{
+	FIELD_offsetx, FIELD_offsety, FIELD_texturetop, FIELD_texturebottom,
+	FIELD_texturemiddle, FIELD_sector,
+	FIELD_COUNT
+};
+static Field const schema_thing[] =
+{
+	FIELD_id, FIELD_x, FIELD_y, FIELD_height, FIELD_angle, FIELD_type,
+	FIELD_flags, FIELD_special, FIELD_arg0, FIELD_arg1, FIELD_arg2,
+	FIELD_arg3, FIELD_arg4, FIELD_skill1, FIELD_skill2, FIELD_skill3,
+	FIELD_skill4, FIELD_skill5, FIELD_ambush, FIELD_single, FIELD_dm,
+	FIELD_coop, FIELD_friend, FIELD_dormant, FIELD_translucent,
+	FIELD_invisible, FIELD_standing,
+	FIELD_COUNT
+};
+static Field const schema_vertex[] =
+{
+	FIELD_x, FIELD_y,
+	FIELD_COUNT
+};
+
+/*
+	Maps the ID of each name in schema to its Field + 1, or 0 for names not
+	in the schema. Relies on name_t::hash() being the interned ID.
+*/
+static std::vector<unsigned char> make_field_table(Field const * schema)
+{
+	std::vector<unsigned char> table;
+
+	for (; *schema != FIELD_COUNT; ++schema)
+	{
+		size_t id = field_names[*schema]->hash();
+
+		if (id >= table.size())
+			table.resize(id + 1, 0);
+
+		table[id] = static_cast<unsigned char>(*schema + 1);
+	}
+
+	return table;
+}
+
+static std::vector<unsigned char> const * get_field_table(type_t const type)
+{
+	static std::vector<unsigned char> const table_linedef(make_field_table(schema_linedef));
+	static std::vector<unsigned char> const table_sector (make_field_table(schema_sector));
+	static std::vector<unsigned char> const table_sidedef(make_field_table(schema_sidedef));
+	static std::vector<unsigned char> const table_thing  (make_field_table(schema_thing));
+	static std::vector<unsigned char> const table_vertex (make_field_table(schema_vertex));
+
+	if (type == type_t::type_linedef()) return &table_linedef;
+	if (type == type_t::type_sector())  return &table_sector;
+	if (type == type_t::type_sidedef()) return &table_sidedef;
+	if (type == type_t::type_thing())   return &table_thing;
+	if (type == type_t::type_vertex())  return &table_vertex;
+
+	return NULL;
+}
+
+/*
+	The values of an object's fields, found with a single pass over its keys.
+	Fields the object does not have are left null.
+*/
+class FieldSlots
+{
+public:
+	FieldSlots(type_t const type, objmap_t const & map)
+	{
+		std::vector<unsigned char> const * table = get_field_table(type);
+
+		if (!table) return;
+
+		FOREACH_T_CONST(objmap_t, it, map)
+		{
+			size_t id = it->first.hash();
+
+			if (id < table->size() && (*table)[id])
+				_slots[(*table)[id] - 1] = it->second;
+		}
+	}
+
+	obj_t const & get(Field field) const {return _slots[field];}
+
+	bool getFlag(Field field) const {return has(field) && convert<bool_t, obj_t>(_slots[field]);}
+
+	bool has(Field field) const {return !(_slots[field] == obj_t());}
+
+private:
+	obj_t _slots[FIELD_COUNT];
+};
+
+
+
+#define CHECKFLAG(ASSIGN, FIELD, VALUE) \
+if (fields.getFlag(FIELD)) \
 	ASSIGN |= VALUE; \
 else (void) 0
 
-#define CHECKFLAGNOT(ASSIGN, FLAG, VALUE) \
-if (!hasObject(FLAG) || !convert<bool_t, obj_t>(getObject(FLAG))) \
+#define CHECKFLAGNOT(ASSIGN, FIELD, VALUE) \
+if (!fields.getFlag(FIELD)) \
 	ASSIGN |= VALUE; \
 else (void) 0
 
-#define CHECKVALUE1_ASSIGN(ASSIGN, NAME, TYPE) \
-if (hasObject(NAME)) \
-	ASSIGN = convert<TYPE##_t, obj_t>(getObject(NAME)); \
+#define CHECKVALUE1_ASSIGN(ASSIGN, FIELD, TYPE) \
+if (fields.has(FIELD)) \
+	ASSIGN = convert<TYPE##_t, obj_t>(fields.get(FIELD)); \
 else
 
-#define CHECKVALUE2_ASSIGN(ASSIGN, NAME, TYPE, DEFAULT) \
-CHECKVALUE1_ASSIGN(ASSIGN, NAME, TYPE) \
+#define CHECKVALUE2_ASSIGN(ASSIGN, FIELD, TYPE, DEFAULT) \
+CHECKVALUE1_ASSIGN(ASSIGN, FIELD, TYPE) \
 	ASSIGN = TYPE##_t(DEFAULT)
 
-#define CHECKVALUE1_BINARY(NAME, TYPE) \
-if (hasObject(NAME)) \
-	convert<TYPE##_t, obj_t>(getObject(NAME)).encodeBinary(out); \
+#define CHECKVALUE1_BINARY(FIELD, TYPE) \
+if (fields.has(FIELD)) \
+	convert<TYPE##_t, obj_t>(fields.get(FIELD)).encodeBinary(out); \
 else
 
-#define CHECKVALUE2_BINARY(NAME, TYPE, DEFAULT) \
-CHECKVALUE1_BINARY(NAME, TYPE) \
+#define CHECKVALUE2_BINARY(FIELD, TYPE, DEFAULT) \
+CHECKVALUE1_BINARY(FIELD, TYPE) \
 	TYPE##_t(DEFAULT).encodeBinary(out)
 
 
@@ -158,6 +378,8 @@ void LevelObject::encodeDoom(std::ostream & out)
 {
 	if (_data.get_dataType() != any_t::OBJMAP_T) return;
 
+	FieldSlots const fields(_type, _data.getObjMap());
+
 	if (_type == type_t::type_linedef())
 	{
 		uword_t v1;        // 00-01
@@ -168,38 +390,31 @@ void LevelObject::encodeDoom(std::ostream & out)
 		uword_t sidefront; // 10-11
 		uword_t sideback;  // 12-13
 
-		CHECKVALUE2_ASSIGN(v1,        name_v1,        uword, -1); // 00-01
-		CHECKVALUE2_ASSIGN(v2,        name_v2,        uword, -1); // 02-03
-		CHECKVALUE1_ASSIGN(flags,     name_flags,     uword    )  // 04-05
+		CHECKVALUE2_ASSIGN(v1,        FIELD_v1,        uword, -1); // 00-01
+		CHECKVALUE2_ASSIGN(v2,        FIELD_v2,        uword, -1); // 02-03
+		CHECKVALUE1_ASSIGN(flags,     FIELD_flags,     uword    )  // 04-05
 		{
-			CHECKFLAG(flags, name_blocking,      uword_t(0x0001U)); // Doom
-			CHECKFLAG(flags, name_blockmonsters, uword_t(0x0002U)); // Doom
-			CHECKFLAG(flags, name_twosided,      uword_t(0x0004U)); // Doom
-			CHECKFLAG(flags, name_dontpegtop,    uword_t(0x0008U)); // Doom
-			CHECKFLAG(flags, name_dontpegbottom, uword_t(0x0010U)); // Doom
-			CHECKFLAG(flags, name_secret,        uword_t(0x0020U)); // Doom
-			CHECKFLAG(flags, name_blocksound,    uword_t(0x0040U)); // Doom
-			CHECKFLAG(flags, name_dontdraw,      uword_t(0x0080U)); // Doom
-			CHECKFLAG(flags, name_mapped,        uword_t(0x0100U)); // Doom
-			CHECKFLAG(flags, name_passuse,       uword_t(0x0200U)); // Boom
+			CHECKFLAG(flags, FIELD_blocking,      uword_t(0x0001U)); // Doom
+			CHECKFLAG(flags, FIELD_blockmonsters, uword_t(0x0002U)); // Doom
+			CHECKFLAG(flags, FIELD_twosided,      uword_t(0x0004U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegtop,    uword_t(0x0008U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegbottom, uword_t(0x0010U)); // Doom
+			CHECKFLAG(flags, FIELD_secret,        uword_t(0x0020U)); // Doom
+			CHECKFLAG(flags, FIELD_blocksound,    uword_t(0x0040U)); // Doom
+			CHECKFLAG(flags, FIELD_dontdraw,      uword_t(0x0080U)); // Doom
+			CHECKFLAG(flags, FIELD_mapped,        uword_t(0x0100U)); // Doom
+			CHECKFLAG(flags, FIELD_passuse,       uword_t(0x0200U)); // Boom
 		}
-		CHECKVALUE2_ASSIGN(id,        name_id,        uword,  0); // 06-07
-		CHECKVALUE2_ASSIGN(special,   name_special,   uword,  0); // 08-09
-		CHECKVALUE2_ASSIGN(sidefront, name_sidefront, uword, -1); // 10-11
-		CHECKVALUE2_ASSIGN(sideback,  name_sideback,  uword, -1); // 12-13
+		CHECKVALUE2_ASSIGN(id,        FIELD_id,        uword,  0); // 06-07
+		CHECKVALUE2_ASSIGN(special,   FIELD_special,   uword,  0); // 08-09
+		CHECKVALUE2_ASSIGN(sidefront, FIELD_sidefront, uword, -1); // 10-11
+		CHECKVALUE2_ASSIGN(sideback,  FIELD_sideback,  uword, -1); // 12-13
 
+		// The rest goes to ExtraData. See encodeExtraData.
 		if (option_output_extradata && (special != uword_t(270)))
 		{
-			if (hasObject(name_special))
-				addObject(name_extradata_special, getObject(name_special));
-
-			if (hasObject(name_id))
-				addObject(name_extradata_tag, getObject(name_id));
-
 			special = uword_t(270);
 			id      = uword_t(_index);
-
-			addObject(name_special, create(type_t::type_uword(), make_string(special)));
 		}
 
 		v1.encodeBinary(out);
@@ -215,25 +430,25 @@ void LevelObject::encodeDoom(std::ostream & out)
 
 	if (_type == type_t::type_sector())
 	{
-		CHECKVALUE2_BINARY(name_heightfloor,    sword,     0); // 00-01
-		CHECKVALUE2_BINARY(name_heightceiling,  sword,     0); // 02-03
-		CHECKVALUE2_BINARY(name_texturefloor,   string8,  ""); // 04-11
-		CHECKVALUE2_BINARY(name_textureceiling, string8,  ""); // 12-19
-		CHECKVALUE2_BINARY(name_lightlevel,     uword,   160); // 20-21
-		CHECKVALUE2_BINARY(name_special,        uword,     0); // 22-23
-		CHECKVALUE2_BINARY(name_id,             uword,     0); // 24-25
+		CHECKVALUE2_BINARY(FIELD_heightfloor,    sword,     0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_heightceiling,  sword,     0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturefloor,   string8,  ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_textureceiling, string8,  ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_lightlevel,     uword,   160); // 20-21
+		CHECKVALUE2_BINARY(FIELD_special,        uword,     0); // 22-23
+		CHECKVALUE2_BINARY(FIELD_id,             uword,     0); // 24-25
 
 		return;
 	}
 
 	if (_type == type_t::type_sidedef())
 	{
-		CHECKVALUE2_BINARY(name_offsetx,       sword,    0); // 00-01
-		CHECKVALUE2_BINARY(name_offsety,       sword,    0); // 02-03
-		CHECKVALUE2_BINARY(name_texturetop,    string8, ""); // 04-11
-		CHECKVALUE2_BINARY(name_texturebottom, string8, ""); // 12-19
-		CHECKVALUE2_BINARY(name_texturemiddle, string8, ""); // 20-27
-		CHECKVALUE2_BINARY(name_sector,        uword,   -1); // 28-29
+		CHECKVALUE2_BINARY(FIELD_offsetx,       sword,    0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_offsety,       sword,    0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturetop,    string8, ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_texturebottom, string8, ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_texturemiddle, string8, ""); // 20-27
+		CHECKVALUE2_BINARY(FIELD_sector,        uword,   -1); // 28-29
 
 		return;
 	}
@@ -246,36 +461,29 @@ void LevelObject::encodeDoom(std::ostream & out)
 		uword_t type;  // 06-07
 		uword_t flags; // 08-09
 
-		CHECKVALUE2_ASSIGN(x,     name_x,     sword, 0); // 00-01
-		CHECKVALUE2_ASSIGN(y,     name_y,     sword, 0); // 02-03
-		CHECKVALUE2_ASSIGN(angle, name_angle, uword, 0); // 04-05
-		CHECKVALUE2_ASSIGN(type,  name_type,  uword, 0); // 06-07
-		CHECKVALUE1_ASSIGN(flags, name_flags, uword   )  // 08-09
+		CHECKVALUE2_ASSIGN(x,     FIELD_x,     sword, 0); // 00-01
+		CHECKVALUE2_ASSIGN(y,     FIELD_y,     sword, 0); // 02-03
+		CHECKVALUE2_ASSIGN(angle, FIELD_angle, uword, 0); // 04-05
+		CHECKVALUE2_ASSIGN(type,  FIELD_type,  uword, 0); // 06-07
+		CHECKVALUE1_ASSIGN(flags, FIELD_flags, uword   )  // 08-09
 		{
-			CHECKFLAG   (flags, name_skill1, uword_t(0x0001U)); // Doom
-			CHECKFLAG   (flags, name_skill2, uword_t(0x0001U)); // Doom
-			CHECKFLAG   (flags, name_skill3, uword_t(0x0002U)); // Doom
-			CHECKFLAG   (flags, name_skill4, uword_t(0x0004U)); // Doom
-			CHECKFLAG   (flags, name_skill5, uword_t(0x0004U)); // Doom
-			CHECKFLAG   (flags, name_ambush, uword_t(0x0008U)); // Doom
-			CHECKFLAGNOT(flags, name_single, uword_t(0x0010U)); // Doom
-			CHECKFLAGNOT(flags, name_dm,     uword_t(0x0020U)); // Boom
-			CHECKFLAGNOT(flags, name_coop,   uword_t(0x0040U)); // Boom
-			CHECKFLAG   (flags, name_friend, uword_t(0x0080U)); // Boom
+			CHECKFLAG   (flags, FIELD_skill1, uword_t(0x0001U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill2, uword_t(0x0001U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill3, uword_t(0x0002U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill4, uword_t(0x0004U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill5, uword_t(0x0004U)); // Doom
+			CHECKFLAG   (flags, FIELD_ambush, uword_t(0x0008U)); // Doom
+			CHECKFLAGNOT(flags, FIELD_single, uword_t(0x0010U)); // Doom
+			CHECKFLAGNOT(flags, FIELD_dm,     uword_t(0x0020U)); // Boom
+			CHECKFLAGNOT(flags, FIELD_coop,   uword_t(0x0040U)); // Boom
+			CHECKFLAG   (flags, FIELD_friend, uword_t(0x0080U)); // Boom
 		}
 
+		// The rest goes to ExtraData. See encodeExtraData.
 		if (option_output_extradata && (type != uword_t(5004)))
 		{
-			if (hasObject(name_type))
-				addObject(name_extradata_type, getObject(name_type));
-
-			if (hasObject(name_flags))
-				addObject(name_extradata_flags, getObject(name_flags));
-
 			type  = uword_t(5004);
 			flags = uword_t(_index);
-
-			addObject(name_type, create(type_t::type_uword(), make_string(type)));
 		}
 
 		x.encodeBinary(out);
@@ -289,41 +497,113 @@ void LevelObject::encodeDoom(std::ostream & out)
 
 	if (_type == type_t::type_vertex())
 	{
-		CHECKVALUE2_BINARY(name_x, sword, 0); // 00-01
-		CHECKVALUE2_BINARY(name_y, sword, 0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_x, sword, 0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_y, sword, 0); // 02-03
 
 		return;
 	}
 }
 
-void LevelObject::encodeExtraData(std::ostream & out)
+/*
+	An object's keys, with some of them replaced for encodeExtraData without
+	touching the object itself.
+*/
+class ExtraDataKeys
+{
+public:
+	ExtraDataKeys(LevelObject & object) : _object(object), _count(0) {}
+
+	obj_t get(name_t const & name)
+	{
+		for (size_t index = 0; index < _count; ++index)
+			if (*_names[index] == name) return _values[index];
+
+		return _object.getObject(name);
+	}
+
+	bool has(name_t const & name)
+	{
+		for (size_t index = 0; index < _count; ++index)
+			if (*_names[index] == name) return true;
+
+		return _object.hasObject(name);
+	}
+
+	// name must outlive this.
+	void set(name_t const & name, obj_t const & value)
+	{
+		size_t index = 0;
+
+		while (index < _count && !(*_names[index] == name)) ++index;
+
+		if (index == _count) ++_count;
+
+		_names[index]  = &name;
+		_values[index] = value;
+	}
+
+private:
+	LevelObject & _object;
+
+	name_t const * _names[2];
+	obj_t          _values[2];
+	size_t _count;
+};
+
+/*
+	With doom, writes the ExtraData for what encodeDoom could not fit into
+	the binary lumps, as though those keys had been moved to the extradata_*
+	keys. The objects themselves are left unchanged.
+*/
+void LevelObject::encodeExtraData(std::ostream & out, bool doom)
 {
 	if (_data.get_dataType() != any_t::OBJMAP_T)
 		return;
 
+	ExtraDataKeys keys(*this);
+
 	if (_type == type_t::type_linedef())
 	{
-		int_l_t special = convert<int_l_t, obj_t>(getObject(name_special));
+		bool moved = false;
+
+		if (doom)
+		{
+			uword_t special(0);
+
+			if (hasObject(name_special))
+				special = convert<uword_t, obj_t>(getObject(name_special));
 
-		if (special != int_l_t(270)) return;
+			if (special != uword_t(270))
+			{
+				if (hasObject(name_special))
+					keys.set(name_extradata_special, getObject(name_special));
+
+				if (hasObject(name_id))
+					keys.set(name_extradata_tag, getObject(name_id));
+
+				moved = true;
+			}
+		}
+
+		if (!moved && convert<int_l_t, obj_t>(getObject(name_special)) != int_l_t(270)) return;
 
 		out << "linedef\n{\n";
 
 		out << "\trecordnum " << _index << '\n';
 
-		if (hasObject(name_extradata_special))
+		if (keys.has(name_extradata_special))
 		{
-			out << "\tspecial "; getObject(name_extradata_special)->_data.encodeText(out); out << '\n';
+			out << "\tspecial "; keys.get(name_extradata_special)->_data.encodeText(out); out << '\n';
 		}
 
-		if (hasObject(name_extradata_tag))
+		if (keys.has(name_extradata_tag))
 		{
-			out << "\ttag "; getObject(name_extradata_tag)->_data.encodeText(out); out << '\n';
+			out << "\ttag "; keys.get(name_extradata_tag)->_data.encodeText(out); out << '\n';
 		}
 
-		if (hasObject(name_extradata_flags))
+		if (keys.has(name_extradata_flags))
 		{
-			out << "\textflags "; getObject(name_extradata_flags)->_data.encodeText(out); out << '\n';
+			out << "\textflags "; keys.get(name_extradata_flags)->_data.encodeText(out); out << '\n';
 		}
 		else
 		{
@@ -413,22 +693,41 @@ void LevelObject::encodeExtraData(std::ostream & out)
 
 	if (_type == type_t::type_thing())
 	{
-		int_l_t type = convert<int_l_t, obj_t>(getObject(name_type));
+		bool moved = false;
+
+		if (doom)
+		{
+			uword_t type(0);
+
+			if (hasObject(name_type))
+				type = convert<uword_t, obj_t>(getObject(name_type));
+
+			if (type != uword_t(5004))
+			{
+				if (hasObject(name_type))
+					keys.set(name_extradata_type, getObject(name_type));
+
+				if (hasObject(name_flags))
+					keys.set(name_extradata_flags, getObject(name_flags));
 
-		if (type != int_l_t(5004)) return;
+				moved = true;
+			}
+		}
+
+		if (!moved && convert<int_l_t, obj_t>(getObject(name_type)) != int_l_t(5004)) return;
 
 		out << "mapthing\n{\n";
 
 		out << "\trecordnum " << _index << '\n';
 
-		if (hasObject(name_extradata_type))
+		if (keys.has(name_extradata_type))
 		{
-			out << "\ttype "; getObject(name_extradata_type)->_data.encodeText(out); out << '\n';
+			out << "\ttype "; keys.get(name_extradata_type)->_data.encodeText(out); out << '\n';
 		}
 
-		if (hasObject(name_extradata_flags))
+		if (keys.has(name_extradata_flags))
 		{
-			out << "\toptions "; getObject(name_extradata_flags)->_data.encodeText(out); out << '\n';
+			out << "\toptions "; keys.get(name_extradata_flags)->_data.encodeText(out); out << '\n';
 		}
 		else
 		{
@@ -523,80 +822,82 @@ void LevelObject::encodeHeretic(std::ostream & out)
 {
 	if (_data.get_dataType() != any_t::OBJMAP_T) return;
 
+	FieldSlots const fields(_type, _data.getObjMap());
+
 	if (_type == type_t::type_linedef())
 	{
-		CHECKVALUE2_BINARY(name_v1,        uword, -1); // 00-01
-		CHECKVALUE2_BINARY(name_v2,        uword, -1); // 02-03
-		CHECKVALUE1_BINARY(name_flags,     uword    )  // 04-05
+		CHECKVALUE2_BINARY(FIELD_v1,        uword, -1); // 00-01
+		CHECKVALUE2_BINARY(FIELD_v2,        uword, -1); // 02-03
+		CHECKVALUE1_BINARY(FIELD_flags,     uword    )  // 04-05
 		{
 			uword_t flags(0);
 
-			CHECKFLAG(flags, name_blocking,      uword_t(0x0001U)); // Doom
-			CHECKFLAG(flags, name_blockmonsters, uword_t(0x0002U)); // Doom
-			CHECKFLAG(flags, name_twosided,      uword_t(0x0004U)); // Doom
-			CHECKFLAG(flags, name_dontpegtop,    uword_t(0x0008U)); // Doom
-			CHECKFLAG(flags, name_dontpegbottom, uword_t(0x0010U)); // Doom
-			CHECKFLAG(flags, name_secret,        uword_t(0x0020U)); // Doom
-			CHECKFLAG(flags, name_blocksound,    uword_t(0x0040U)); // Doom
-			CHECKFLAG(flags, name_dontdraw,      uword_t(0x0080U)); // Doom
-			CHECKFLAG(flags, name_mapped,        uword_t(0x0100U)); // Doom
-			CHECKFLAG(flags, name_passuse,       uword_t(0x0200U)); // Boom
+			CHECKFLAG(flags, FIELD_blocking,      uword_t(0x0001U)); // Doom
+			CHECKFLAG(flags, FIELD_blockmonsters, uword_t(0x0002U)); // Doom
+			CHECKFLAG(flags, FIELD_twosided,      uword_t(0x0004U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegtop,    uword_t(0x0008U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegbottom, uword_t(0x0010U)); // Doom
+			CHECKFLAG(flags, FIELD_secret,        uword_t(0x0020U)); // Doom
+			CHECKFLAG(flags, FIELD_blocksound,    uword_t(0x0040U)); // Doom
+			CHECKFLAG(flags, FIELD_dontdraw,      uword_t(0x0080U)); // Doom
+			CHECKFLAG(flags, FIELD_mapped,        uword_t(0x0100U)); // Doom
+			CHECKFLAG(flags, FIELD_passuse,       uword_t(0x0200U)); // Boom
 
 			flags.encodeBinary(out);
 		}
-		CHECKVALUE2_BINARY(name_id,        uword,  0); // 06-07
-		CHECKVALUE2_BINARY(name_special,   uword,  0); // 08-09
-		CHECKVALUE2_BINARY(name_sidefront, uword, -1); // 10-11
-		CHECKVALUE2_BINARY(name_sideback,  uword, -1); // 12-13
+		CHECKVALUE2_BINARY(FIELD_id,        uword,  0); // 06-07
+		CHECKVALUE2_BINARY(FIELD_special,   uword,  0); // 08-09
+		CHECKVALUE2_BINARY(FIELD_sidefront, uword, -1); // 10-11
+		CHECKVALUE2_BINARY(FIELD_sideback,  uword, -1); // 12-13
 
 		return;
 	}
 
 	if (_type == type_t::type_sector())
 	{
-		CHECKVALUE2_BINARY(name_heightfloor,    sword,     0); // 00-01
-		CHECKVALUE2_BINARY(name_heightceiling,  sword,     0); // 02-03
-		CHECKVALUE2_BINARY(name_texturefloor,   string8,  ""); // 04-11
-		CHECKVALUE2_BINARY(name_textureceiling, string8,  ""); // 12-19
-		CHECKVALUE2_BINARY(name_lightlevel,     uword,   160); // 20-21
-		CHECKVALUE2_BINARY(name_special,        uword,     0); // 22-23
-		CHECKVALUE2_BINARY(name_id,             uword,     0); // 24-25
+		CHECKVALUE2_BINARY(FIELD_heightfloor,    sword,     0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_heightceiling,  sword,     0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturefloor,   string8,  ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_textureceiling, string8,  ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_lightlevel,     uword,   160); // 20-21
+		CHECKVALUE2_BINARY(FIELD_special,        uword,     0); // 22-23
+		CHECKVALUE2_BINARY(FIELD_id,             uword,     0); // 24-25
 
 		return;
 	}
 
 	if (_type == type_t::type_sidedef())
 	{
-		CHECKVALUE2_BINARY(name_offsetx,       sword,    0); // 00-01
-		CHECKVALUE2_BINARY(name_offsety,       sword,    0); // 02-03
-		CHECKVALUE2_BINARY(name_texturetop,    string8, ""); // 04-11
-		CHECKVALUE2_BINARY(name_texturebottom, string8, ""); // 12-19
-		CHECKVALUE2_BINARY(name_texturemiddle, string8, ""); // 20-27
-		CHECKVALUE2_BINARY(name_sector,        uword,   -1); // 28-29
+		CHECKVALUE2_BINARY(FIELD_offsetx,       sword,    0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_offsety,       sword,    0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturetop,    string8, ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_texturebottom, string8, ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_texturemiddle, string8, ""); // 20-27
+		CHECKVALUE2_BINARY(FIELD_sector,        uword,   -1); // 28-29
 
 		return;
 	}
 
 	if (_type == type_t::type_thing())
 	{
-		CHECKVALUE2_BINARY(name_x,     sword, 0); // 00-01
-		CHECKVALUE2_BINARY(name_y,     sword, 0); // 02-03
-		CHECKVALUE2_BINARY(name_angle, uword, 0); // 04-05
-		CHECKVALUE2_BINARY(name_type,  uword, 0); // 06-07
-		CHECKVALUE1_BINARY(name_flags, uword   )  // 08-09
+		CHECKVALUE2_BINARY(FIELD_x,     sword, 0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_y,     sword, 0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_angle, uword, 0); // 04-05
+		CHECKVALUE2_BINARY(FIELD_type,  uword, 0); // 06-07
+		CHECKVALUE1_BINARY(FIELD_flags, uword   )  // 08-09
 		{
 			uword_t flags(0);
 
-			CHECKFLAG   (flags, name_skill1, uword_t(0x0001U)); // Doom
-			CHECKFLAG   (flags, name_skill2, uword_t(0x0001U)); // Doom
-			CHECKFLAG   (flags, name_skill3, uword_t(0x0002U)); // Doom
-			CHECKFLAG   (flags, name_skill4, uword_t(0x0004U)); // Doom
-			CHECKFLAG   (flags, name_skill5, uword_t(0x0004U)); // Doom
-			CHECKFLAG   (flags, name_ambush, uword_t(0x0008U)); // Doom
-			CHECKFLAGNOT(flags, name_single, uword_t(0x0010U)); // Doom
-			CHECKFLAGNOT(flags, name_dm,     uword_t(0x0020U)); // Boom
-			CHECKFLAGNOT(flags, name_coop,   uword_t(0x0040U)); // Boom
-			CHECKFLAG   (flags, name_friend, uword_t(0x0080U)); // Boom
+			CHECKFLAG   (flags, FIELD_skill1, uword_t(0x0001U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill2, uword_t(0x0001U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill3, uword_t(0x0002U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill4, uword_t(0x0004U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill5, uword_t(0x0004U)); // Doom
+			CHECKFLAG   (flags, FIELD_ambush, uword_t(0x0008U)); // Doom
+			CHECKFLAGNOT(flags, FIELD_single, uword_t(0x0010U)); // Doom
+			CHECKFLAGNOT(flags, FIELD_dm,     uword_t(0x0020U)); // Boom
+			CHECKFLAGNOT(flags, FIELD_coop,   uword_t(0x0040U)); // Boom
+			CHECKFLAG   (flags, FIELD_friend, uword_t(0x0080U)); // Boom
 
 			flags.encodeBinary(out);
 		}
@@ -606,8 +907,8 @@ void LevelObject::encodeHeretic(std::ostream & out)
 
 	if (_type == type_t::type_vertex())
 	{
-		CHECKVALUE2_BINARY(name_x, sword, 0); // 00-01
-		CHECKVALUE2_BINARY(name_y, sword, 0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_x, sword, 0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_y, sword, 0); // 02-03
 
 		return;
 	}
@@ -617,6 +918,8 @@ void LevelObject::encodeHexen(std::ostream & out)
 {
 	if (_data.get_dataType() != any_t::OBJMAP_T) return;
 
+	FieldSlots const fields(_type, _data.getObjMap());
+
 	if (_type == type_t::type_linedef())
 	{
 		uword_t v1;        // 00-01
@@ -634,58 +937,58 @@ void LevelObject::encodeHexen(std::ostream & out)
 		ubyte_t flags2;    // **
 		uword_t id;        // **
 
-		CHECKVALUE2_ASSIGN(v1,        name_v1,        uword, -1); // 00-01
-		CHECKVALUE2_ASSIGN(v2,        name_v2,        uword, -1); // 02-03
-		CHECKVALUE1_ASSIGN(flags,     name_flags,     uword    )  // 04-05
+		CHECKVALUE2_ASSIGN(v1,        FIELD_v1,        uword, -1); // 00-01
+		CHECKVALUE2_ASSIGN(v2,        FIELD_v2,        uword, -1); // 02-03
+		CHECKVALUE1_ASSIGN(flags,     FIELD_flags,     uword    )  // 04-05
 		{
-			CHECKFLAG(flags, name_blocking,        uword_t(0x0001U)); // Doom
-			CHECKFLAG(flags, name_blockmonsters,   uword_t(0x0002U)); // Doom
-			CHECKFLAG(flags, name_twosided,        uword_t(0x0004U)); // Doom
-			CHECKFLAG(flags, name_dontpegtop,      uword_t(0x0008U)); // Doom
-			CHECKFLAG(flags, name_dontpegbottom,   uword_t(0x0010U)); // Doom
-			CHECKFLAG(flags, name_secret,          uword_t(0x0020U)); // Doom
-			CHECKFLAG(flags, name_blocksound,      uword_t(0x0040U)); // Doom
-			CHECKFLAG(flags, name_dontdraw,        uword_t(0x0080U)); // Doom
-			CHECKFLAG(flags, name_mapped,          uword_t(0x0100U)); // Doom
-			CHECKFLAG(flags, name_repeatspecial,   uword_t(0x0200U)); // Hexen
-			CHECKFLAG(flags, name_monsteractivate, uword_t(0x2000U)); // Hexen
-			CHECKFLAG(flags, name_blockplayers,    uword_t(0x4000U)); // Hexen
-			CHECKFLAG(flags, name_blockeverything, uword_t(0x8000U)); // Hexen
-
-			if (hasObject(name_playeruse) && convert<bool_t, obj_t>(getObject(name_playeruse)))
-				if (hasObject(name_playercross) && convert<bool_t, obj_t>(getObject(name_playercross)))
+			CHECKFLAG(flags, FIELD_blocking,        uword_t(0x0001U)); // Doom
+			CHECKFLAG(flags, FIELD_blockmonsters,   uword_t(0x0002U)); // Doom
+			CHECKFLAG(flags, FIELD_twosided,        uword_t(0x0004U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegtop,      uword_t(0x0008U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegbottom,   uword_t(0x0010U)); // Doom
+			CHECKFLAG(flags, FIELD_secret,          uword_t(0x0020U)); // Doom
+			CHECKFLAG(flags, FIELD_blocksound,      uword_t(0x0040U)); // Doom
+			CHECKFLAG(flags, FIELD_dontdraw,        uword_t(0x0080U)); // Doom
+			CHECKFLAG(flags, FIELD_mapped,          uword_t(0x0100U)); // Doom
+			CHECKFLAG(flags, FIELD_repeatspecial,   uword_t(0x0200U)); // Hexen
+			CHECKFLAG(flags, FIELD_monsteractivate, uword_t(0x2000U)); // Hexen
+			CHECKFLAG(flags, FIELD_blockplayers,    uword_t(0x4000U)); // Hexen
+			CHECKFLAG(flags, FIELD_blockeverything, uword_t(0x8000U)); // Hexen
+
+			if (fields.getFlag(FIELD_playeruse))
+				if (fields.getFlag(FIELD_playercross))
 					flags |= uword_t(0x1800U);
 				else
 					flags |= uword_t(0x0400U);
-			else if (hasObject(name_monstercross) && convert<bool_t, obj_t>(getObject(name_monstercross)))
+			else if (fields.getFlag(FIELD_monstercross))
 				flags |= uword_t(0x0800U);
-			else if (hasObject(name_impact) && convert<bool_t, obj_t>(getObject(name_impact)))
+			else if (fields.getFlag(FIELD_impact))
 				flags |= uword_t(0x0C00U);
-			else if (hasObject(name_playerpush) && convert<bool_t, obj_t>(getObject(name_playerpush)))
+			else if (fields.getFlag(FIELD_playerpush))
 				flags |= uword_t(0x1000U);
-			else if (hasObject(name_missilecross) && convert<bool_t, obj_t>(getObject(name_missilecross)))
+			else if (fields.getFlag(FIELD_missilecross))
 				flags |= uword_t(0x1400U);
 		}
-		CHECKVALUE2_ASSIGN(special,   name_special,   ubyte,  0); // 06
-		CHECKVALUE2_ASSIGN(arg0,      name_arg0,      ubyte,  0); // 07
-		CHECKVALUE2_ASSIGN(arg1,      name_arg1,      ubyte,  0); // 08
-		CHECKVALUE2_ASSIGN(arg2,      name_arg2,      ubyte,  0); // 09
-		CHECKVALUE2_ASSIGN(arg3,      name_arg3,      ubyte,  0); // 10
-		CHECKVALUE2_ASSIGN(arg4,      name_arg4,      ubyte,  0); // 11
-		CHECKVALUE2_ASSIGN(sidefront, name_sidefront, uword, -1); // 12-13
-		CHECKVALUE2_ASSIGN(sideback,  name_sideback,  uword, -1); // 14-15
-		CHECKVALUE1_ASSIGN(flags2,    name_flags2,    ubyte    )  // **
+		CHECKVALUE2_ASSIGN(special,   FIELD_special,   ubyte,  0); // 06
+		CHECKVALUE2_ASSIGN(arg0,      FIELD_arg0,      ubyte,  0); // 07
+		CHECKVALUE2_ASSIGN(arg1,      FIELD_arg1,      ubyte,  0); // 08
+		CHECKVALUE2_ASSIGN(arg2,      FIELD_arg2,      ubyte,  0); // 09
+		CHECKVALUE2_ASSIGN(arg3,      FIELD_arg3,      ubyte,  0); // 10
+		CHECKVALUE2_ASSIGN(arg4,      FIELD_arg4,      ubyte,  0); // 11
+		CHECKVALUE2_ASSIGN(sidefront, FIELD_sidefront, uword, -1); // 12-13
+		CHECKVALUE2_ASSIGN(sideback,  FIELD_sideback,  uword, -1); // 14-15
+		CHECKVALUE1_ASSIGN(flags2,    FIELD_flags2,    ubyte    )  // **
 		{
-			CHECKFLAG(flags2, name_zoneboundry,      ubyte_t(0x01U)); // ZDoom
-			CHECKFLAG(flags2, name_jumpover,         ubyte_t(0x02U)); // ZDoom
-			CHECKFLAG(flags2, name_blockfloaters,    ubyte_t(0x04U)); // ZDoom
-			CHECKFLAG(flags2, name_clipmidtex,       ubyte_t(0x08U)); // ZDoom
-			CHECKFLAG(flags2, name_wrapmidtex,       ubyte_t(0x10U)); // ZDoom
-			CHECKFLAG(flags2, name_midtex3d,         ubyte_t(0x20U)); // ZDoom
-			CHECKFLAG(flags2, name_checkswitchrange, ubyte_t(0x40U)); // ZDoom
-			CHECKFLAG(flags2, name_firstsideonly,    ubyte_t(0x80U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_zoneboundry,      ubyte_t(0x01U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_jumpover,         ubyte_t(0x02U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_blockfloaters,    ubyte_t(0x04U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_clipmidtex,       ubyte_t(0x08U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_wrapmidtex,       ubyte_t(0x10U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_midtex3d,         ubyte_t(0x20U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_checkswitchrange, ubyte_t(0x40U)); // ZDoom
+			CHECKFLAG(flags2, FIELD_firstsideonly,    ubyte_t(0x80U)); // ZDoom
 		}
-		CHECKVALUE2_ASSIGN(id,        name_id,        uword,  0); // **
+		CHECKVALUE2_ASSIGN(id,        FIELD_id,        uword,  0); // **
 
 		switch (special.makeInt())
 		{
@@ -744,73 +1047,73 @@ void LevelObject::encodeHexen(std::ostream & out)
 
 	if (_type == type_t::type_sector())
 	{
-		CHECKVALUE2_BINARY(name_heightfloor,    sword,     0); // 00-01
-		CHECKVALUE2_BINARY(name_heightceiling,  sword,     0); // 02-03
-		CHECKVALUE2_BINARY(name_texturefloor,   string8,  ""); // 04-11
-		CHECKVALUE2_BINARY(name_textureceiling, string8,  ""); // 12-19
-		CHECKVALUE2_BINARY(name_lightlevel,     uword,   160); // 20-21
-		CHECKVALUE2_BINARY(name_special,        uword,     0); // 22-23
-		CHECKVALUE2_BINARY(name_id,             uword,     0); // 24-25
+		CHECKVALUE2_BINARY(FIELD_heightfloor,    sword,     0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_heightceiling,  sword,     0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturefloor,   string8,  ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_textureceiling, string8,  ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_lightlevel,     uword,   160); // 20-21
+		CHECKVALUE2_BINARY(FIELD_special,        uword,     0); // 22-23
+		CHECKVALUE2_BINARY(FIELD_id,             uword,     0); // 24-25
 
 		return;
 	}
 
 	if (_type == type_t::type_sidedef())
 	{
-		CHECKVALUE2_BINARY(name_offsetx,       sword,    0); // 00-01
-		CHECKVALUE2_BINARY(name_offsety,       sword,    0); // 02-03
-		CHECKVALUE2_BINARY(name_texturetop,    string8, ""); // 04-11
-		CHECKVALUE2_BINARY(name_texturebottom, string8, ""); // 12-19
-		CHECKVALUE2_BINARY(name_texturemiddle, string8, ""); // 20-27
-		CHECKVALUE2_BINARY(name_sector,        uword,   -1); // 28-29
+		CHECKVALUE2_BINARY(FIELD_offsetx,       sword,    0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_offsety,       sword,    0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturetop,    string8, ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_texturebottom, string8, ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_texturemiddle, string8, ""); // 20-27
+		CHECKVALUE2_BINARY(FIELD_sector,        uword,   -1); // 28-29
 
 		return;
 	}
 
 	if (_type == type_t::type_thing())
 	{
-		CHECKVALUE2_BINARY(name_id,      uword,  0); // 00-01
-		CHECKVALUE2_BINARY(name_x,       sword,  0); // 02-03
-		CHECKVALUE2_BINARY(name_y,       sword,  0); // 04-05
-		CHECKVALUE2_BINARY(name_height,  sword,  0); // 06-07
-		CHECKVALUE2_BINARY(name_angle,   uword,  0); // 08-09
-		CHECKVALUE2_BINARY(name_type,    uword,  0); // 10-11
-		CHECKVALUE1_BINARY(name_flags,   uword    )  // 12-13
+		CHECKVALUE2_BINARY(FIELD_id,      uword,  0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_x,       sword,  0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_y,       sword,  0); // 04-05
+		CHECKVALUE2_BINARY(FIELD_height,  sword,  0); // 06-07
+		CHECKVALUE2_BINARY(FIELD_angle,   uword,  0); // 08-09
+		CHECKVALUE2_BINARY(FIELD_type,    uword,  0); // 10-11
+		CHECKVALUE1_BINARY(FIELD_flags,   uword    )  // 12-13
 		{
 			uword_t flags;
 
-			CHECKFLAG(flags, name_skill1,      uword_t(0x0001U)); // Doom
-			CHECKFLAG(flags, name_skill2,      uword_t(0x0001U)); // Doom
-			CHECKFLAG(flags, name_skill3,      uword_t(0x0002U)); // Doom
-			CHECKFLAG(flags, name_skill4,      uword_t(0x0004U)); // Doom
-			CHECKFLAG(flags, name_skill5,      uword_t(0x0004U)); // Doom
-			CHECKFLAG(flags, name_ambush,      uword_t(0x0008U)); // Doom
-			CHECKFLAG(flags, name_dormant,     uword_t(0x0010U)); // Hexen
-			CHECKFLAG(flags, name_single,      uword_t(0x0100U)); // Hexen
-			CHECKFLAG(flags, name_coop,        uword_t(0x0200U)); // Hexen
-			CHECKFLAG(flags, name_dm,          uword_t(0x0400U)); // Hexen
-			CHECKFLAG(flags, name_translucent, uword_t(0x0800U)); // Hexen
-			CHECKFLAG(flags, name_invisible,   uword_t(0x1000U)); // Hexen
-			CHECKFLAG(flags, name_friend,      uword_t(0x2000U)); // Hexen
-			CHECKFLAG(flags, name_standing,    uword_t(0x4000U)); // Hexen
+			CHECKFLAG(flags, FIELD_skill1,      uword_t(0x0001U)); // Doom
+			CHECKFLAG(flags, FIELD_skill2,      uword_t(0x0001U)); // Doom
+			CHECKFLAG(flags, FIELD_skill3,      uword_t(0x0002U)); // Doom
+			CHECKFLAG(flags, FIELD_skill4,      uword_t(0x0004U)); // Doom
+			CHECKFLAG(flags, FIELD_skill5,      uword_t(0x0004U)); // Doom
+			CHECKFLAG(flags, FIELD_ambush,      uword_t(0x0008U)); // Doom
+			CHECKFLAG(flags, FIELD_dormant,     uword_t(0x0010U)); // Hexen
+			CHECKFLAG(flags, FIELD_single,      uword_t(0x0100U)); // Hexen
+			CHECKFLAG(flags, FIELD_coop,        uword_t(0x0200U)); // Hexen
+			CHECKFLAG(flags, FIELD_dm,          uword_t(0x0400U)); // Hexen
+			CHECKFLAG(flags, FIELD_translucent, uword_t(0x0800U)); // Hexen
+			CHECKFLAG(flags, FIELD_invisible,   uword_t(0x1000U)); // Hexen
+			CHECKFLAG(flags, FIELD_friend,      uword_t(0x2000U)); // Hexen
+			CHECKFLAG(flags, FIELD_standing,    uword_t(0x4000U)); // Hexen
 
 			flags.encodeBinary(out);
 		}
 
-		CHECKVALUE2_BINARY(name_special, ubyte,  0); // 14
-		CHECKVALUE2_BINARY(name_arg0,    ubyte,  0); // 15
-		CHECKVALUE2_BINARY(name_arg1,    ubyte,  0); // 16
-		CHECKVALUE2_BINARY(name_arg2,    ubyte,  0); // 17
-		CHECKVALUE2_BINARY(name_arg3,    ubyte,  0); // 18
-		CHECKVALUE2_BINARY(name_arg4,    ubyte,  0); // 19
+		CHECKVALUE2_BINARY(FIELD_special, ubyte,  0); // 14
+		CHECKVALUE2_BINARY(FIELD_arg0,    ubyte,  0); // 15
+		CHECKVALUE2_BINARY(FIELD_arg1,    ubyte,  0); // 16
+		CHECKVALUE2_BINARY(FIELD_arg2,    ubyte,  0); // 17
+		CHECKVALUE2_BINARY(FIELD_arg3,    ubyte,  0); // 18
+		CHECKVALUE2_BINARY(FIELD_arg4,    ubyte,  0); // 19
 
 		return;
 	}
 
 	if (_type == type_t::type_vertex())
 	{
-		CHECKVALUE2_BINARY(name_x, sword, 0); // 00-01
-		CHECKVALUE2_BINARY(name_y, sword, 0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_x, sword, 0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_y, sword, 0); // 02-03
 
 		return;
 	}
@@ -820,82 +1123,84 @@ void LevelObject::encodeStrife(std::ostream & out)
 {
 	if (_data.get_dataType() != any_t::OBJMAP_T) return;
 
+	FieldSlots const fields(_type, _data.getObjMap());
+
 	if (_type == type_t::type_linedef())
 	{
-		CHECKVALUE2_BINARY(name_v1,        uword, -1); // 00-01
-		CHECKVALUE2_BINARY(name_v2,        uword, -1); // 02-03
-		CHECKVALUE1_BINARY(name_flags,     uword    )  // 04-05
+		CHECKVALUE2_BINARY(FIELD_v1,        uword, -1); // 00-01
+		CHECKVALUE2_BINARY(FIELD_v2,        uword, -1); // 02-03
+		CHECKVALUE1_BINARY(FIELD_flags,     uword    )  // 04-05
 		{
 			uword_t flags(0);
 
-			CHECKFLAG(flags, name_blocking,      uword_t(0x0001U)); // Doom
-			CHECKFLAG(flags, name_blockmonsters, uword_t(0x0002U)); // Doom
-			CHECKFLAG(flags, name_twosided,      uword_t(0x0004U)); // Doom
-			CHECKFLAG(flags, name_dontpegtop,    uword_t(0x0008U)); // Doom
-			CHECKFLAG(flags, name_dontpegbottom, uword_t(0x0010U)); // Doom
-			CHECKFLAG(flags, name_secret,        uword_t(0x0020U)); // Doom
-			CHECKFLAG(flags, name_blocksound,    uword_t(0x0040U)); // Doom
-			CHECKFLAG(flags, name_dontdraw,      uword_t(0x0080U)); // Doom
-			CHECKFLAG(flags, name_mapped,        uword_t(0x0100U)); // Doom
-			CHECKFLAG(flags, name_railing,       uword_t(0x0200U)); // Strife
-			CHECKFLAG(flags, name_translucent,   uword_t(0x0400U)); // Strife
+			CHECKFLAG(flags, FIELD_blocking,      uword_t(0x0001U)); // Doom
+			CHECKFLAG(flags, FIELD_blockmonsters, uword_t(0x0002U)); // Doom
+			CHECKFLAG(flags, FIELD_twosided,      uword_t(0x0004U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegtop,    uword_t(0x0008U)); // Doom
+			CHECKFLAG(flags, FIELD_dontpegbottom, uword_t(0x0010U)); // Doom
+			CHECKFLAG(flags, FIELD_secret,        uword_t(0x0020U)); // Doom
+			CHECKFLAG(flags, FIELD_blocksound,    uword_t(0x0040U)); // Doom
+			CHECKFLAG(flags, FIELD_dontdraw,      uword_t(0x0080U)); // Doom
+			CHECKFLAG(flags, FIELD_mapped,        uword_t(0x0100U)); // Doom
+			CHECKFLAG(flags, FIELD_railing,       uword_t(0x0200U)); // Strife
+			CHECKFLAG(flags, FIELD_translucent,   uword_t(0x0400U)); // Strife
 
 			flags.encodeBinary(out);
 		}
-		CHECKVALUE2_BINARY(name_id,        uword,  0); // 06-07
-		CHECKVALUE2_BINARY(name_special,   uword,  0); // 08-09
-		CHECKVALUE2_BINARY(name_sidefront, uword, -1); // 10-11
-		CHECKVALUE2_BINARY(name_sideback,  uword, -1); // 12-13
+		CHECKVALUE2_BINARY(FIELD_id,        uword,  0); // 06-07
+		CHECKVALUE2_BINARY(FIELD_special,   uword,  0); // 08-09
+		CHECKVALUE2_BINARY(FIELD_sidefront, uword, -1); // 10-11
+		CHECKVALUE2_BINARY(FIELD_sideback,  uword, -1); // 12-13
 
 		return;
 	}
 
 	if (_type == type_t::type_sector())
 	{
-		CHECKVALUE2_BINARY(name_heightfloor,    sword,     0); // 00-01
-		CHECKVALUE2_BINARY(name_heightceiling,  sword,     0); // 02-03
-		CHECKVALUE2_BINARY(name_texturefloor,   string8,  ""); // 04-11
-		CHECKVALUE2_BINARY(name_textureceiling, string8,  ""); // 12-19
-		CHECKVALUE2_BINARY(name_lightlevel,     uword,   160); // 20-21
-		CHECKVALUE2_BINARY(name_special,        uword,     0); // 22-23
-		CHECKVALUE2_BINARY(name_id,             uword,     0); // 24-25
+		CHECKVALUE2_BINARY(FIELD_heightfloor,    sword,     0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_heightceiling,  sword,     0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturefloor,   string8,  ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_textureceiling, string8,  ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_lightlevel,     uword,   160); // 20-21
+		CHECKVALUE2_BINARY(FIELD_special,        uword,     0); // 22-23
+		CHECKVALUE2_BINARY(FIELD_id,             uword,     0); // 24-25
 
 		return;
 	}
 
 	if (_type == type_t::type_sidedef())
 	{
-		CHECKVALUE2_BINARY(name_offsetx,       sword,    0); // 00-01
-		CHECKVALUE2_BINARY(name_offsety,       sword,    0); // 02-03
-		CHECKVALUE2_BINARY(name_texturetop,    string8, ""); // 04-11
-		CHECKVALUE2_BINARY(name_texturebottom, string8, ""); // 12-19
-		CHECKVALUE2_BINARY(name_texturemiddle, string8, ""); // 20-27
-		CHECKVALUE2_BINARY(name_sector,        uword,   -1); // 28-29
+		CHECKVALUE2_BINARY(FIELD_offsetx,       sword,    0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_offsety,       sword,    0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_texturetop,    string8, ""); // 04-11
+		CHECKVALUE2_BINARY(FIELD_texturebottom, string8, ""); // 12-19
+		CHECKVALUE2_BINARY(FIELD_texturemiddle, string8, ""); // 20-27
+		CHECKVALUE2_BINARY(FIELD_sector,        uword,   -1); // 28-29
 
 		return;
 	}
 
 	if (_type == type_t::type_thing())
 	{
-		CHECKVALUE2_BINARY(name_x,     sword, 0); // 00-01
-		CHECKVALUE2_BINARY(name_y,     sword, 0); // 02-03
-		CHECKVALUE2_BINARY(name_angle, uword, 0); // 04-05
-		CHECKVALUE2_BINARY(name_type,  uword, 0); // 06-07
-		CHECKVALUE1_BINARY(name_flags, uword   )  // 08-09
+		CHECKVALUE2_BINARY(FIELD_x,     sword, 0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_y,     sword, 0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_angle, uword, 0); // 04-05
+		CHECKVALUE2_BINARY(FIELD_type,  uword, 0); // 06-07
+		CHECKVALUE1_BINARY(FIELD_flags, uword   )  // 08-09
 		{
 			uword_t flags(0);
 
-			CHECKFLAG   (flags, name_skill1,      uword_t(0x0001U)); // Doom
-			CHECKFLAG   (flags, name_skill2,      uword_t(0x0001U)); // Doom
-			CHECKFLAG   (flags, name_skill3,      uword_t(0x0002U)); // Doom
-			CHECKFLAG   (flags, name_skill4,      uword_t(0x0004U)); // Doom
-			CHECKFLAG   (flags, name_skill5,      uword_t(0x0004U)); // Doom
-			CHECKFLAG   (flags, name_standing,    uword_t(0x0008U)); // Strife
-			CHECKFLAGNOT(flags, name_single,      uword_t(0x0010U)); // Doom
-			CHECKFLAGNOT(flags, name_ambush,      uword_t(0x0020U)); // Strife
-			CHECKFLAG   (flags, name_friend,      uword_t(0x0080U)); // Strife
-			CHECKFLAGNOT(flags, name_translucent, uword_t(0x0100U)); // Strife
-			CHECKFLAGNOT(flags, name_invisible,   uword_t(0x0200U)); // Strife
+			CHECKFLAG   (flags, FIELD_skill1,      uword_t(0x0001U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill2,      uword_t(0x0001U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill3,      uword_t(0x0002U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill4,      uword_t(0x0004U)); // Doom
+			CHECKFLAG   (flags, FIELD_skill5,      uword_t(0x0004U)); // Doom
+			CHECKFLAG   (flags, FIELD_standing,    uword_t(0x0008U)); // Strife
+			CHECKFLAGNOT(flags, FIELD_single,      uword_t(0x0010U)); // Doom
+			CHECKFLAGNOT(flags, FIELD_ambush,      uword_t(0x0020U)); // Strife
+			CHECKFLAG   (flags, FIELD_friend,      uword_t(0x0080U)); // Strife
+			CHECKFLAGNOT(flags, FIELD_translucent, uword_t(0x0100U)); // Strife
+			CHECKFLAGNOT(flags, FIELD_invisible,   uword_t(0x0200U)); // Strife
 		}
 
 		return;
@@ -903,14 +1208,66 @@ void LevelObject::encodeStrife(std::ostream & out)
 
 	if (_type == type_t::type_vertex())
 	{
-		CHECKVALUE2_BINARY(name_x, sword, 0); // 00-01
-		CHECKVALUE2_BINARY(name_y, sword, 0); // 02-03
+		CHECKVALUE2_BINARY(FIELD_x, sword, 0); // 00-01
+		CHECKVALUE2_BINARY(FIELD_y, sword, 0); // 02-03
 
 		return;
 	}
 }
 
-void LevelObject::encodeUDMF(std::ostream & out, int depth)
+/*
+	With --do-compact-text, TEXTMAP and DIALOG are written without the
+	indentation or the index comments.
+*/
+static void encode_text_begin(TextWriter & out, int depth, std::string const & type, int_s_t index)
+{
+	if (option_compact_text)
+	{
+		out.write(type);
+		out.write("\n{\n", 3);
+
+		return;
+	}
+
+	out.writeIndent(depth);
+	out.write(type);
+	out.write(" /* ", 4);
+	out.writeInt(index);
+	out.write(" */\n", 4);
+
+	out.writeIndent(depth);
+	out.write("{\n", 2);
+}
+
+static void encode_text_end(TextWriter & out, int depth)
+{
+	if (option_compact_text)
+	{
+		out.write("}\n", 2);
+
+		return;
+	}
+
+	out.writeIndent(depth);
+	out.write("}\n\n", 3);
+}
+
+static void encode_text_key(TextWriter & out, int depth, name_t const & name)
+{
+	if (!option_compact_text)
+		out.writeIndent(depth);
+
+	for (size_t index = 0; index < name.size(); ++index)
+	{
+		if (index) out.put('.');
+
+		out.write(name.getString(index));
+	}
+
+	out.put('=');
+}
+
+void LevelObject::encodeUDMF(TextWriter & out, int depth)
 {
 	if (_data.get_dataType() == any_t::OBJMAP_T)
 	{
@@ -918,7 +1275,7 @@ void LevelObject::encodeUDMF(std::ostream & out, int depth)
 
 		if (depth && (_type.getMode() != type_t::MODE_INLINE))
 		{
-			out << get_object_index(this);
+			out.writeInt(get_object_index(this));
 		}
 		else
 		{
@@ -931,11 +1288,7 @@ void LevelObject::encodeUDMF(std::ostream & out, int depth)
 				return;
 			}
 
-			for(int i = depth; i; --i) out.put('\t');
-			out << _type.makeString() << " /* " << get_object_index(this) << " */\n";
-
-			for(int i = depth; i; --i) out.put('\t');
-			out << "{\n";
+			encode_text_begin(out, depth, _type.makeString(), get_object_index(this));
 
 			FOREACH_T(objmap_t, it, _data.getObjMap())
 			{
@@ -945,13 +1298,11 @@ void LevelObject::encodeUDMF(std::ostream & out, int depth)
 				}
 				else
 				{
-					for(int i = depth+1; i; --i) out.put('\t');
-					out << it->first << '='; it->second->encodeUDMF(out, depth+1); out << ";\n";
+					encode_text_key(out, depth+1, it->first); it->second->encodeUDMF(out, depth+1); out.write(";\n", 2);
 				}
 			}
 
-			for(int i = depth; i; --i) out.put('\t');
-			out << "}\n\n";
+			encode_text_end(out, depth);
 		}
 
 		return;
@@ -962,7 +1313,7 @@ void LevelObject::encodeUDMF(std::ostream & out, int depth)
 	_data.encodeText(out);
 }
 
-void LevelObject::encodeUSDF(std::ostream & out, int depth)
+void LevelObject::encodeUSDF(TextWriter & out, int depth)
 {
 	if (_data.get_dataType() == any_t::OBJMAP_T)
 	{
@@ -970,7 +1321,7 @@ void LevelObject::encodeUSDF(std::ostream & out, int depth)
 
 		if (depth && (_type.getMode() != type_t::MODE_INLINE))
 		{
-			out << get_object_index(this);
+			out.writeInt(get_object_index(this));
 		}
 		else
 		{
@@ -983,11 +1334,7 @@ void LevelObject::encodeUSDF(std::ostream & out, int depth)
 				return;
 			}
 
-			for(int i = depth; i; --i) out.put('\t');
-			out << _type.makeString() << " /* " << ((_type.getMode() == type_t::MODE_OBJECT) ? get_object_index(this) : -1) << " */\n";
-
-			for(int i = depth; i; --i) out.put('\t');
-			out << "{\n";
+			encode_text_begin(out, depth, _type.makeString(), (_type.getMode() == type_t::MODE_OBJECT) ? get_object_index(this) : -1);
 
 			FOREACH_T(objmap_t, it, _data.getObjMap())
 			{
@@ -997,13 +1344,11 @@ void LevelObject::encodeUSDF(std::ostream & out, int depth)
 				}
 				else
 				{
-					for(int i = depth+1; i; --i) out.put('\t');
-					out << it->first << '='; it->second->encodeUSDF(out, depth+1); out << ";\n";
+					encode_text_key(out, depth+1, it->first); it->second->encodeUSDF(out, depth+1); out.write(";\n", 2);
 				}
 			}
 
-			for(int i = depth; i; --i) out.put('\t');
-			out << "}\n\n";
+			encode_text_end(out, depth);
 		}
 
 		return;
@@ -0,0 +1,700 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+*/
+
+#include "NodeBuilder.hpp"
+
+#include "global_object.hpp"
+#include "options.hpp"
+#include "types.hpp"
+
+#include "LevelObject/LevelObject.hpp"
+
+#include "types/binary.hpp"
+
+#include "../common/foreach.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <set>
+
+#if USE_THREADS
+#include <thread>
+#endif
+
+#ifndef USE_ZLIB
+#define USE_ZLIB 0
+#endif
+
+#if USE_ZLIB
+#include <zlib.h>
+#endif
+
+
+
+// Points closer than this to a partition are on it.
+static double const node_epsilon = 1.0 / 1024;
+
+// Sets of segs with more candidates than this only try this many of them.
+static size_t const node_max_candidates = 256;
+
+// Segs times candidates at which the candidates are evaluated on threads.
+static size_t const node_parallel_work = 1 << 16;
+
+// A split costs as much as this much imbalance.
+static size_t const node_split_cost = 8;
+
+static const name_t name_sideback ("sideback");
+static const name_t name_sidefront("sidefront");
+static const name_t name_v1       ("v1");
+static const name_t name_v2       ("v2");
+static const name_t name_x        ("x");
+static const name_t name_y        ("y");
+
+
+
+struct NodeBuilder::Candidate
+{
+	Partition partition;
+
+	// The seg whose line it is.
+	size_t seg;
+};
+
+// One thread's share of the candidates.
+struct NodeBuilder::Evaluation
+{
+	NodeBuilder const * builder;
+
+	std::vector<Seg>       const * segs;
+	std::vector<Candidate> const * candidates;
+
+	size_t begin, end;
+
+	// The result. best is end if no candidate divides the segs.
+	size_t best, cost;
+};
+
+
+
+static void node_put_8(std::string & out, unsigned long value)
+{
+	out += static_cast<char>(value & 0xFF);
+}
+
+static void node_put_16(std::string & out, unsigned long value)
+{
+	out += static_cast<char>((value     ) & 0xFF);
+	out += static_cast<char>((value >> 8) & 0xFF);
+}
+
+static void node_put_32(std::string & out, unsigned long value)
+{
+	out += static_cast<char>((value      ) & 0xFF);
+	out += static_cast<char>((value >>  8) & 0xFF);
+	out += static_cast<char>((value >> 16) & 0xFF);
+	out += static_cast<char>((value >> 24) & 0xFF);
+}
+
+static long node_round(double value)
+{
+	return static_cast<long>(std::floor(value + 0.5));
+}
+
+static global_object_list_t * node_objects(type_t const type)
+{
+	global_object_map_t::iterator it(global_object_map.find(type));
+
+	return it == global_object_map.end() ? NULL : &it->second;
+}
+
+
+
+NodeBuilder::NodeBuilder() : _countVertexes(0)
+{
+
+}
+
+void NodeBuilder::build()
+{
+	readMap();
+
+	std::vector<Seg> segs;
+
+	for (size_t index = 0; index < _lines.size(); ++index)
+	{
+		Line const & line = _lines[index];
+
+		for (int side = 0; side < 2; ++side)
+		{
+			if (!line.sides[side]) continue;
+
+			Seg seg;
+
+			seg.v1   = side ? line.v2 : line.v1;
+			seg.v2   = side ? line.v1 : line.v2;
+			seg.line = index;
+			seg.side = side;
+
+			segs.push_back(seg);
+		}
+	}
+
+	if (!segs.empty())
+		buildNode(segs);
+}
+
+NodeBuilder::Child NodeBuilder::buildNode(std::vector<Seg> & segs)
+{
+	// Every distinct line once.
+	std::vector<Candidate> candidates;
+	{
+		std::set<std::pair<std::pair<double, double>, std::pair<double, double> > > seen;
+
+		for (size_t index = 0; index < segs.size(); ++index)
+		{
+			Candidate candidate;
+
+			candidate.partition = getPartition(segs[index]);
+			candidate.seg       = index;
+
+			Partition const & p = candidate.partition;
+
+			if (seen.insert(std::make_pair(std::make_pair(p.x, p.y), std::make_pair(p.dx, p.dy))).second)
+				candidates.push_back(candidate);
+		}
+	}
+
+	size_t best = candidates.size();
+
+	if (!isConvex(segs, candidates))
+	{
+		if (candidates.size() > node_max_candidates)
+		{
+			std::vector<Candidate> sample;
+
+			for (size_t index = 0; index < node_max_candidates; ++index)
+				sample.push_back(candidates[index * candidates.size() / node_max_candidates]);
+
+			size_t bestSample = choosePartition(segs, sample);
+
+			if (bestSample != sample.size())
+				best = bestSample * candidates.size() / node_max_candidates;
+		}
+
+		if (best == candidates.size())
+			best = choosePartition(segs, candidates);
+	}
+
+	Child child;
+
+	if (best == candidates.size())
+	{
+		Subsector subsector;
+
+		subsector.first = _segs.size();
+		subsector.count = segs.size();
+
+		_segs.insert(_segs.end(), segs.begin(), segs.end());
+
+		child.index     = _subsectors.size();
+		child.subsector = true;
+
+		_subsectors.push_back(subsector);
+
+		return child;
+	}
+
+	Partition const partition = candidates[best].partition;
+
+	std::vector<Seg> front, back;
+
+	FOREACH_T_CONST(std::vector<Seg>, it, segs)
+	{
+		int side = segSide(partition, *it);
+
+		if (side > 0)
+			front.push_back(*it);
+		else if (side < 0)
+			back.push_back(*it);
+		else
+		{
+			Seg seg1 = *it, seg2 = *it;
+
+			seg1.v2 = seg2.v1 = getSplitVertex(*it, partition);
+
+			if (pointSide(partition, _vertices[it->v1]) > 0)
+			{
+				front.push_back(seg1);
+				back.push_back(seg2);
+			}
+			else
+			{
+				back.push_back(seg1);
+				front.push_back(seg2);
+			}
+		}
+	}
+
+	std::vector<Seg>().swap(segs);
+
+	Node node;
+
+	node.x  = node_round(partition.x);
+	node.y  = node_round(partition.y);
+	node.dx = node_round(partition.dx);
+	node.dy = node_round(partition.dy);
+
+	getBox(front, node.box[0]);
+	getBox(back,  node.box[1]);
+
+	node.child[0] = buildNode(front);
+	node.child[1] = buildNode(back);
+
+	child.index     = _nodes.size();
+	child.subsector = false;
+
+	_nodes.push_back(node);
+
+	return child;
+}
+
+size_t NodeBuilder::choosePartition(std::vector<Seg> const & segs, std::vector<Candidate> const & candidates) const
+{
+	size_t count = 1;
+
+	#if USE_THREADS
+	if (segs.size() * candidates.size() >= node_parallel_work)
+	{
+		count = option_jobs > 0 ? option_jobs : std::thread::hardware_concurrency();
+
+		if (count > candidates.size())
+			count = candidates.size();
+
+		if (count < 1)
+			count = 1;
+	}
+	#endif
+
+	std::vector<Evaluation> evaluations(count);
+
+	for (size_t index = 0; index < count; ++index)
+	{
+		Evaluation & evaluation = evaluations[index];
+
+		evaluation.builder    = this;
+		evaluation.segs       = &segs;
+		evaluation.candidates = &candidates;
+		evaluation.begin      = candidates.size() *  index      / count;
+		evaluation.end        = candidates.size() * (index + 1) / count;
+	}
+
+	#if USE_THREADS
+	if (count > 1)
+	{
+		std::vector<std::thread> threads;
+
+		// This thread takes the first share.
+		for (size_t index = 1; index < count; ++index)
+			threads.push_back(std::thread(evaluate, &evaluations[index]));
+
+		evaluate(&evaluations[0]);
+
+		FOREACH_T(std::vector<std::thread>, it, threads)
+			it->join();
+	}
+	else
+	#endif
+		evaluate(&evaluations[0]);
+
+	// The first of the cheapest, whatever the number of threads.
+	size_t best = candidates.size(), cost = 0;
+
+	FOREACH_T_CONST(std::vector<Evaluation>, it, evaluations)
+	{
+		if (it->best != it->end && (best == candidates.size() || it->cost < cost))
+		{
+			best = it->best;
+			cost = it->cost;
+		}
+	}
+
+	return best;
+}
+
+double NodeBuilder::distance(Partition const & partition, Vertex const & v) const
+{
+	return ((v.x - partition.x) * partition.dy - (v.y - partition.y) * partition.dx) / partition.length;
+}
+
+void NodeBuilder::evaluate(Evaluation * evaluation)
+{
+	NodeBuilder const & builder = *evaluation->builder;
+
+	std::vector<Seg> const & segs = *evaluation->segs;
+
+	evaluation->best = evaluation->end;
+	evaluation->cost = 0;
+
+	for (size_t index = evaluation->begin; index < evaluation->end; ++index)
+	{
+		Partition const & partition = (*evaluation->candidates)[index].partition;
+
+		size_t front = 0, back = 0, splits = 0;
+
+		bool found = evaluation->best != evaluation->end;
+
+		FOREACH_T_CONST(std::vector<Seg>, it, segs)
+		{
+			int side = builder.segSide(partition, *it);
+
+			if (side > 0)
+				++front;
+			else if (side < 0)
+				++back;
+			else
+			{
+				++front;
+				++back;
+				++splits;
+
+				// Already worse than the best, whatever the balance.
+				if (found && splits * node_split_cost > evaluation->cost)
+					break;
+			}
+		}
+
+		if (found && splits * node_split_cost > evaluation->cost)
+			continue;
+
+		// It has to put segs on both sides.
+		if (!front || !back)
+			continue;
+
+		size_t cost = splits * node_split_cost + (front > back ? front - back : back - front);
+
+		if (!found || cost < evaluation->cost)
+		{
+			evaluation->best = index;
+			evaluation->cost = cost;
+		}
+	}
+}
+
+void NodeBuilder::getBox(std::vector<Seg> const & segs, int box[4]) const
+{
+	if (segs.empty())
+	{
+		box[0] = box[1] = box[2] = box[3] = 0;
+		return;
+	}
+
+	double top    = _vertices[segs[0].v1].y;
+	double bottom = top;
+	double left   = _vertices[segs[0].v1].x;
+	double right  = left;
+
+	FOREACH_T_CONST(std::vector<Seg>, it, segs)
+	{
+		for (int end = 0; end < 2; ++end)
+		{
+			Vertex const & v = _vertices[end ? it->v2 : it->v1];
+
+			if (v.y > top)    top    = v.y;
+			if (v.y < bottom) bottom = v.y;
+			if (v.x < left)   left   = v.x;
+			if (v.x > right)  right  = v.x;
+		}
+	}
+
+	box[0] = static_cast<int>(std::ceil (top));
+	box[1] = static_cast<int>(std::floor(bottom));
+	box[2] = static_cast<int>(std::floor(left));
+	box[3] = static_cast<int>(std::ceil (right));
+}
+
+NodeBuilder::Partition NodeBuilder::getPartition(Seg const & seg) const
+{
+	Line const & line = _lines[seg.line];
+
+	Vertex const & v1 = _vertices[seg.side ? line.v2 : line.v1];
+	Vertex const & v2 = _vertices[seg.side ? line.v1 : line.v2];
+
+	Partition partition;
+
+	partition.x      = v1.x;
+	partition.y      = v1.y;
+	partition.dx     = v2.x - v1.x;
+	partition.dy     = v2.y - v1.y;
+	partition.length = std::sqrt(partition.dx * partition.dx + partition.dy * partition.dy);
+
+	return partition;
+}
+
+size_t NodeBuilder::getSplitVertex(Seg const & seg, Partition const & partition)
+{
+	Vertex const & v1 = _vertices[seg.v1];
+	Vertex const & v2 = _vertices[seg.v2];
+
+	double d1 = distance(partition, v1);
+	double d2 = distance(partition, v2);
+	double t  = d1 / (d1 - d2);
+
+	Vertex v;
+
+	v.x = v1.x + (v2.x - v1.x) * t;
+	v.y = v1.y + (v2.y - v1.y) * t;
+
+	std::pair<long long int, long long int> key(node_round(v.x * 65536), node_round(v.y * 65536));
+
+	std::map<std::pair<long long int, long long int>, size_t>::iterator it(_splitVertices.find(key));
+
+	if (it != _splitVertices.end())
+		return it->second;
+
+	_splitVertices[key] = _vertices.size();
+	_vertices.push_back(v);
+
+	return _vertices.size() - 1;
+}
+
+bool NodeBuilder::isConvex(std::vector<Seg> const & segs, std::vector<Candidate> const & candidates) const
+{
+	FOREACH_T_CONST(std::vector<Candidate>, candidate, candidates)
+	{
+		FOREACH_T_CONST(std::vector<Seg>, it, segs)
+		{
+			if (segSide(candidate->partition, *it) <= 0)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool NodeBuilder::needsExtended() const
+{
+	return _vertices.size() > 0xFFFF || _segs.size() > 0xFFFF ||
+		_subsectors.size() > 0x7FFF || _nodes.size() > 0x7FFF;
+}
+
+int NodeBuilder::pointSide(Partition const & partition, Vertex const & v) const
+{
+	double d = distance(partition, v);
+
+	return d > node_epsilon ? 1 : d < -node_epsilon ? -1 : 0;
+}
+
+void NodeBuilder::readMap()
+{
+	if (global_object_list_t * vertexes = node_objects(type_t::type_vertex()))
+	{
+		FOREACH_T(global_object_list_t, it, *vertexes)
+		{
+			LevelObject & object = **it;
+
+			if (object.getData().get_dataType() != any_t::OBJMAP_T) continue;
+
+			Vertex v;
+
+			v.x = object.hasObject(name_x) ? convert<sword_t, obj_t>(object.getObject(name_x)).makeInt() : 0;
+			v.y = object.hasObject(name_y) ? convert<sword_t, obj_t>(object.getObject(name_y)).makeInt() : 0;
+
+			_vertices.push_back(v);
+		}
+	}
+
+	_countVertexes = _vertices.size();
+
+	if (global_object_list_t * linedefs = node_objects(type_t::type_linedef()))
+	{
+		FOREACH_T(global_object_list_t, it, *linedefs)
+		{
+			LevelObject & object = **it;
+
+			if (object.getData().get_dataType() != any_t::OBJMAP_T) continue;
+
+			// Every linedef keeps its place, so that segs have its index.
+			Line line;
+
+			line.v1 = object.hasObject(name_v1) ? convert<uword_t, obj_t>(object.getObject(name_v1)).makeInt() : 0xFFFF;
+			line.v2 = object.hasObject(name_v2) ? convert<uword_t, obj_t>(object.getObject(name_v2)).makeInt() : 0xFFFF;
+
+			line.sides[0] = object.hasObject(name_sidefront) && convert<uword_t, obj_t>(object.getObject(name_sidefront)).makeInt() != 0xFFFF;
+			line.sides[1] = object.hasObject(name_sideback)  && convert<uword_t, obj_t>(object.getObject(name_sideback)).makeInt()  != 0xFFFF;
+
+			if (line.v1 >= _countVertexes || line.v2 >= _countVertexes)
+			{
+				std::cerr << "linedef:" << _lines.size() << ":invalid vertex, left out of nodes\n";
+
+				line.v1 = line.v2 = 0;
+				line.sides[0] = line.sides[1] = false;
+			}
+			else if (_vertices[line.v1].x == _vertices[line.v2].x && _vertices[line.v1].y == _vertices[line.v2].y)
+			{
+				std::cerr << "linedef:" << _lines.size() << ":zero length, left out of nodes\n";
+
+				line.sides[0] = line.sides[1] = false;
+			}
+
+			_lines.push_back(line);
+		}
+	}
+}
+
+int NodeBuilder::segSide(Partition const & partition, Seg const & seg) const
+{
+	int side1 = pointSide(partition, _vertices[seg.v1]);
+	int side2 = pointSide(partition, _vertices[seg.v2]);
+
+	// On the partition, it goes in front if it faces the same way.
+	if (!side1 && !side2)
+	{
+		Partition const line = getPartition(seg);
+
+		return line.dx * partition.dx + line.dy * partition.dy > 0 ? 1 : -1;
+	}
+
+	if (side1 >= 0 && side2 >= 0) return 1;
+	if (side1 <= 0 && side2 <= 0) return -1;
+
+	return 0;
+}
+
+void NodeBuilder::writeClassic(std::string & vertexes, std::string & segs, std::string & ssectors, std::string & nodes) const
+{
+	for (size_t index = _countVertexes; index < _vertices.size(); ++index)
+	{
+		node_put_16(vertexes, node_round(_vertices[index].x));
+		node_put_16(vertexes, node_round(_vertices[index].y));
+	}
+
+	FOREACH_T_CONST(std::vector<Seg>, it, _segs)
+	{
+		Partition const line = getPartition(*it);
+
+		Vertex const & start = _vertices[it->v1];
+
+		double angle  = std::atan2(line.dy, line.dx) * 32768 / 3.14159265358979323846;
+		double offset = std::sqrt((start.x - line.x) * (start.x - line.x) + (start.y - line.y) * (start.y - line.y));
+
+		node_put_16(segs, it->v1);
+		node_put_16(segs, it->v2);
+		node_put_16(segs, node_round(angle));
+		node_put_16(segs, it->line);
+		node_put_16(segs, it->side);
+		node_put_16(segs, node_round(offset));
+	}
+
+	FOREACH_T_CONST(std::vector<Subsector>, it, _subsectors)
+	{
+		node_put_16(ssectors, it->count);
+		node_put_16(ssectors, it->first);
+	}
+
+	FOREACH_T_CONST(std::vector<Node>, it, _nodes)
+	{
+		node_put_16(nodes, it->x);
+		node_put_16(nodes, it->y);
+		node_put_16(nodes, it->dx);
+		node_put_16(nodes, it->dy);
+
+		for (int child = 0; child < 2; ++child)
+			for (int edge = 0; edge < 4; ++edge)
+				node_put_16(nodes, it->box[child][edge]);
+
+		for (int child = 0; child < 2; ++child)
+			node_put_16(nodes, it->child[child].index | (it->child[child].subsector ? 0x8000 : 0));
+	}
+}
+
+void NodeBuilder::writeExtended(std::string & nodes, bool compress) const
+{
+	std::string data;
+
+	node_put_32(data, _countVertexes);
+	node_put_32(data, _vertices.size() - _countVertexes);
+
+	// 16.16 fixed point.
+	for (size_t index = _countVertexes; index < _vertices.size(); ++index)
+	{
+		node_put_32(data, node_round(_vertices[index].x * 65536));
+		node_put_32(data, node_round(_vertices[index].y * 65536));
+	}
+
+	node_put_32(data, _subsectors.size());
+
+	FOREACH_T_CONST(std::vector<Subsector>, it, _subsectors)
+		node_put_32(data, it->count);
+
+	node_put_32(data, _segs.size());
+
+	FOREACH_T_CONST(std::vector<Seg>, it, _segs)
+	{
+		node_put_32(data, it->v1);
+		node_put_32(data, it->v2);
+		node_put_16(data, it->line);
+		node_put_8 (data, it->side);
+	}
+
+	node_put_32(data, _nodes.size());
+
+	FOREACH_T_CONST(std::vector<Node>, it, _nodes)
+	{
+		node_put_16(data, it->x);
+		node_put_16(data, it->y);
+		node_put_16(data, it->dx);
+		node_put_16(data, it->dy);
+
+		for (int child = 0; child < 2; ++child)
+			for (int edge = 0; edge < 4; ++edge)
+				node_put_16(data, it->box[child][edge]);
+
+		for (int child = 0; child < 2; ++child)
+			node_put_32(data, it->child[child].index | (it->child[child].subsector ? 0x80000000UL : 0));
+	}
+
+	#if USE_ZLIB
+	if (compress)
+	{
+		uLongf size = compressBound(data.size());
+
+		std::string compressed(size, '\0');
+
+		if (compress2(reinterpret_cast<Bytef *>(&compressed[0]), &size,
+			reinterpret_cast<Bytef const *>(data.data()), data.size(), Z_BEST_COMPRESSION) == Z_OK)
+		{
+			nodes += "ZNOD";
+			nodes.append(compressed, 0, size);
+			return;
+		}
+	}
+	#else
+	(void) compress;
+	#endif
+
+	nodes += "XNOD";
+	nodes += data;
+}
+
+
+
@@ -0,0 +1,173 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Builds the BSP for the binary map formats, for --do-nodes. The vertices,
+	linedefs and sidedefs are read from global_object_map the same way the
+	binary encoders read them, so the nodes match the lumps.
+
+	Partition lines are chosen from the lines of the segs, by fewest splits
+	and then best balance. Large sets of segs have their candidates spread
+	over --jobs threads. The result does not depend on the number of threads.
+
+	2026/10/17 - Original version.
+*/
+
+#ifndef NODEBUILDER_H
+#define NODEBUILDER_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+class NodeBuilder
+{
+	public:
+		NodeBuilder();
+
+		/*
+			Builds the nodes from global_object_map, which must have been
+			compacted. Lines with invalid vertices are left out, with a
+			message to std::cerr.
+		*/
+		void build();
+
+		/*
+			True if the nodes do not fit in the classic lumps, and have to
+			be written with writeExtended.
+		*/
+		bool needsExtended() const;
+
+		/*
+			SEGS, SSECTORS, and NODES. The vertices made by splitting lines
+			are appended to vertexes, which must already hold VERTEXES.
+		*/
+		void writeClassic(std::string & vertexes, std::string & segs, std::string & ssectors, std::string & nodes) const;
+
+		/*
+			ZDoom's extended nodes, which go in NODES and leave SEGS and
+			SSECTORS empty. With compress, and zlib, they are ZNOD instead
+			of XNOD.
+		*/
+		void writeExtended(std::string & nodes, bool compress) const;
+
+	private:
+		struct Vertex
+		{
+			double x, y;
+		};
+
+		struct Line
+		{
+			size_t v1, v2;
+
+			// Which sides have a sidedef, and so get segs.
+			bool sides[2];
+		};
+
+		struct Seg
+		{
+			size_t v1, v2;
+			size_t line;
+			int    side;
+		};
+
+		struct Subsector
+		{
+			size_t first, count;
+		};
+
+		// A node's child. subsector says which list index is in.
+		struct Child
+		{
+			size_t index;
+			bool   subsector;
+		};
+
+		struct Node
+		{
+			// The partition, from the vertices of a line.
+			int x, y, dx, dy;
+
+			// For each child: top, bottom, left, right.
+			int box[2][4];
+
+			Child child[2];
+		};
+
+		// A partition line. Also the line under a seg.
+		struct Partition
+		{
+			double x, y, dx, dy, length;
+		};
+
+		struct Candidate;
+		struct Evaluation;
+
+		Child buildNode(std::vector<Seg> & segs);
+
+		/*
+			Returns the index of the best candidate, or candidates.size() if
+			none of them divides the segs.
+		*/
+		size_t choosePartition(std::vector<Seg> const & segs, std::vector<Candidate> const & candidates) const;
+
+		// Signed distance from the partition. Positive is in front.
+		double distance(Partition const & partition, Vertex const & v) const;
+
+		void getBox(std::vector<Seg> const & segs, int box[4]) const;
+
+		Partition getPartition(Seg const & seg) const;
+
+		size_t getSplitVertex(Seg const & seg, Partition const & partition);
+
+		bool isConvex(std::vector<Seg> const & segs, std::vector<Candidate> const & candidates) const;
+
+		int pointSide(Partition const & partition, Vertex const & v) const;
+
+		void readMap();
+
+		int segSide(Partition const & partition, Seg const & seg) const;
+
+		static void evaluate(Evaluation * evaluation);
+
+		std::vector<Vertex> _vertices;
+		size_t _countVertexes;
+
+		std::vector<Line> _lines;
+
+		std::vector<Seg>       _segs;
+		std::vector<Subsector> _subsectors;
+		std::vector<Node>      _nodes;
+
+		// Split vertices by position, in 16.16 fixed point, so that both
+		// sides of a line share them.
+		std::map<std::pair<long long int, long long int>, size_t> _splitVertices;
+};
+
+
+
+#endif /* NODEBUILDER_H */
+
+
+
@@ -0,0 +1,230 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+*/
+
+#include "RejectBuilder.hpp"
+
+#include "global_object.hpp"
+#include "options.hpp"
+#include "types.hpp"
+
+#include "LevelObject/LevelObject.hpp"
+
+#include "types/binary.hpp"
+
+#include "../common/foreach.hpp"
+
+#if USE_THREADS
+#include <thread>
+#endif
+
+
+
+// Bytes of table at which it is filled on threads.
+static size_t const reject_parallel_bytes = 1 << 17;
+
+static const name_t name_sector   ("sector");
+static const name_t name_sideback ("sideback");
+static const name_t name_sidefront("sidefront");
+
+
+
+// One thread's share of the table's bytes.
+struct RejectBuilder::Fill
+{
+	RejectBuilder const * builder;
+
+	char * data;
+
+	size_t begin, end;
+};
+
+
+
+static size_t reject_get_index(LevelObject & object, name_t const & name)
+{
+	return object.hasObject(name) ? convert<uword_t, obj_t>(object.getObject(name)).makeInt() : 0xFFFF;
+}
+
+static global_object_list_t * reject_objects(type_t const type)
+{
+	global_object_map_t::iterator it(global_object_map.find(type));
+
+	return it == global_object_map.end() ? NULL : &it->second;
+}
+
+
+
+RejectBuilder::RejectBuilder()
+{
+
+}
+
+void RejectBuilder::build()
+{
+	if (global_object_list_t * sectors = reject_objects(type_t::type_sector()))
+	{
+		FOREACH_T(global_object_list_t, it, *sectors)
+		{
+			if ((*it)->getData().get_dataType() == any_t::OBJMAP_T)
+				_groups.push_back(_groups.size());
+		}
+	}
+
+	std::vector<size_t> sidedefs;
+
+	if (global_object_list_t * sides = reject_objects(type_t::type_sidedef()))
+	{
+		FOREACH_T(global_object_list_t, it, *sides)
+		{
+			LevelObject & object = **it;
+
+			if (object.getData().get_dataType() == any_t::OBJMAP_T)
+				sidedefs.push_back(reject_get_index(object, name_sector));
+		}
+	}
+
+	// Sectors on either side of a two-sided linedef are in the same group.
+	if (global_object_list_t * linedefs = reject_objects(type_t::type_linedef()))
+	{
+		FOREACH_T(global_object_list_t, it, *linedefs)
+		{
+			LevelObject & object = **it;
+
+			if (object.getData().get_dataType() != any_t::OBJMAP_T) continue;
+
+			size_t sidefront = reject_get_index(object, name_sidefront);
+			size_t sideback  = reject_get_index(object, name_sideback);
+
+			if (sidefront >= sidedefs.size() || sideback >= sidedefs.size())
+				continue;
+
+			size_t front = sidedefs[sidefront];
+			size_t back  = sidedefs[sideback];
+
+			if (front >= _groups.size() || back >= _groups.size())
+				continue;
+
+			front = find(front);
+			back  = find(back);
+
+			if (front < back)
+				_groups[back] = front;
+			else
+				_groups[front] = back;
+		}
+	}
+
+	for (size_t sector = 0; sector < _groups.size(); ++sector)
+		_groups[sector] = find(sector);
+}
+
+void RejectBuilder::fill(Fill * fill)
+{
+	std::vector<size_t> const & groups = fill->builder->_groups;
+
+	size_t count = groups.size();
+
+	// Bit n is whether sector n / count can see sector n % count.
+	size_t from = fill->begin * 8 / count;
+	size_t to   = fill->begin * 8 % count;
+
+	for (size_t index = fill->begin; index < fill->end; ++index)
+	{
+		unsigned char byte = 0;
+
+		for (int bit = 0; bit < 8 && from < count; ++bit)
+		{
+			if (groups[from] != groups[to])
+				byte |= 1 << bit;
+
+			if (++to == count)
+			{
+				to = 0;
+				++from;
+			}
+		}
+
+		fill->data[index] = static_cast<char>(byte);
+	}
+}
+
+size_t RejectBuilder::find(size_t sector)
+{
+	while (_groups[sector] != sector)
+		sector = _groups[sector] = _groups[_groups[sector]];
+
+	return sector;
+}
+
+void RejectBuilder::write(std::string & reject, bool visible) const
+{
+	size_t count = _groups.size();
+	size_t size  = (count * count + 7) / 8;
+
+	reject.assign(size, '\0');
+
+	if (visible || !size) return;
+
+	size_t jobs = 1;
+
+	#if USE_THREADS
+	if (size >= reject_parallel_bytes)
+	{
+		jobs = option_jobs > 0 ? option_jobs : std::thread::hardware_concurrency();
+
+		if (jobs < 1)
+			jobs = 1;
+	}
+	#endif
+
+	std::vector<Fill> fills(jobs);
+
+	for (size_t index = 0; index < jobs; ++index)
+	{
+		fills[index].builder = this;
+		fills[index].data    = &reject[0];
+		fills[index].begin   = size *  index      / jobs;
+		fills[index].end     = size * (index + 1) / jobs;
+	}
+
+	#if USE_THREADS
+	if (jobs > 1)
+	{
+		std::vector<std::thread> threads;
+
+		// This thread takes the first share.
+		for (size_t index = 1; index < jobs; ++index)
+			threads.push_back(std::thread(fill, &fills[index]));
+
+		fill(&fills[0]);
+
+		FOREACH_T(std::vector<std::thread>, it, threads)
+			it->join();
+	}
+	else
+	#endif
+		fill(&fills[0]);
+}
+
+
+
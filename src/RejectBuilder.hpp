@@ -0,0 +1,71 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Builds REJECT for the binary map formats, for --do-reject. A sector can
+	see another if there is a path between them through two-sided linedefs.
+	Only sectors that can never see each other are rejected, so the lump is
+	always safe to use. Big tables are filled on --jobs threads.
+
+	2026/10/17 - Original version.
+*/
+
+#ifndef REJECTBUILDER_H
+#define REJECTBUILDER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+
+class RejectBuilder
+{
+	public:
+		RejectBuilder();
+
+		/*
+			Finds which sectors can see each other from global_object_map,
+			which must have been compacted.
+		*/
+		void build();
+
+		/*
+			With visible, every sector can see every other, which needs no
+			build.
+		*/
+		void write(std::string & reject, bool visible) const;
+
+	private:
+		struct Fill;
+
+		static void fill(Fill * fill);
+
+		size_t find(size_t sector);
+
+		// For each sector, the first sector of the group it is in.
+		std::vector<size_t> _groups;
+};
+
+
+
+#endif /* REJECTBUILDER_H */
+
+
+
@@ -18,31 +18,86 @@
 */
 
 /*
-
+	2026/10/17 - Copies and copied tokens are counted for --debug-stats.
 */
 
 #include "SourceScanner.hpp"
 
+#include "stats.hpp"
 #include "types.hpp"
 
 #include "exceptions/SyntaxException.hpp"
 
 
 
+static StatsCounter stats_copy  ("SourceScanner", "copy");
+static StatsCounter stats_tokens("SourceScanner", "copy-tokens");
+
+
+
+template <typename TT, typename SS>
+SourceScanner<TT, SS>::SourceScanner() : _in(NULL), _block(NULL), _blockIndex(0), _blockEnd(0), _ungetStack()
+{
+
+}
+template <typename TT, typename SS>
+SourceScanner<TT, SS>::SourceScanner(SourceScanner<TT, SS> const & sc) : _in(NULL), _block(sc._block), _blockIndex(sc._blockIndex), _blockEnd(sc._blockEnd), _ungetStack(sc._ungetStack)
+{
+	block_ref(_block);
+
+	stats_copy.add();
+	stats_tokens.add(_ungetStack.size());
+}
 template <typename TT, typename SS>
-SourceScanner<TT, SS>::SourceScanner() : _in(NULL), _ungetStack()
+SourceScanner<TT, SS>::SourceScanner(SS & in) : _in(&in), _block(NULL), _blockIndex(0), _blockEnd(0), _ungetStack()
 {
 
 }
 template <typename TT, typename SS>
-SourceScanner<TT, SS>::SourceScanner(SourceScanner<TT, SS> const & sc) : _in(NULL), _ungetStack(sc._ungetStack)
+SourceScanner<TT, SS>::SourceScanner(std::vector<TT> const & tokens) : _in(NULL), _block(NULL), _blockIndex(0), _blockEnd(tokens.size()), _ungetStack()
 {
+	if (!tokens.empty())
+	{
+		_block = new Block;
+		_block->tokens = tokens;
+		_block->refCount = 1;
 
+		stats_tokens.add(tokens.size());
+	}
+}
+template <typename TT, typename SS>
+SourceScanner<TT, SS>::~SourceScanner()
+{
+	block_unref(_block);
 }
+
 template <typename TT, typename SS>
-SourceScanner<TT, SS>::SourceScanner(SS & in) : _in(&in), _ungetStack()
+SourceScanner<TT, SS> & SourceScanner<TT, SS>::operator = (SourceScanner<TT, SS> const & sc)
 {
+	block_ref(sc._block);
+	block_unref(_block);
+
+	_in         = sc._in;
+	_block      = sc._block;
+	_blockIndex = sc._blockIndex;
+	_blockEnd   = sc._blockEnd;
+	_ungetStack = sc._ungetStack;
+
+	stats_copy.add();
+	stats_tokens.add(_ungetStack.size());
 
+	return *this;
+}
+
+template <typename TT, typename SS>
+void SourceScanner<TT, SS>::block_ref(Block * block)
+{
+	if (block) ++block->refCount;
+}
+template <typename TT, typename SS>
+void SourceScanner<TT, SS>::block_unref(Block * block)
+{
+	if (block && !--block->refCount) delete block;
 }
 
 template <typename TT, typename SS>
@@ -50,19 +105,23 @@ TT SourceScanner<TT, SS>::get()
 {
 	TT token;
 
-	if (_ungetStack.empty())
+	if (!_ungetStack.empty())
+	{
+		token = _ungetStack.top();
+
+		_ungetStack.pop();
+	}
+	else if (_blockIndex != _blockEnd)
+	{
+		token = _block->tokens[_blockIndex++];
+	}
+	else
 	{
 		if (_in)
 			(*_in) >> token;
 		else
 			token = TT::EOF_token;
 	}
-	else
-	{
-		token = _ungetStack.top();
-
-		_ungetStack.pop();
-	}
 
 	return token;
 }
@@ -94,11 +153,14 @@ template <typename TT, typename SS>
 SourceScanner<TT, SS> SourceScanner<TT, SS>::getblock(typename TT::TokenType typeOpen, typename TT::TokenType typeClose)
 {
 	SourceScanner<TT, SS> sc;
-	std::stack<TT> tempStack;
+	std::vector<TT> prefix;
+	std::vector<TT> tokens;
 
 	int depth = 0;
+	bool done = false;
 
-	while (true)
+	// Anything ungotten comes first. Usually just the opening token.
+	while (!done && !_ungetStack.empty())
 	{
 		TT token(get());
 
@@ -107,23 +169,103 @@ SourceScanner<TT, SS> SourceScanner<TT, SS>::getblock(typename TT::TokenType typ
 		if (type == typeOpen) ++depth;
 		else if (type == typeClose) --depth;
 
-		tempStack.push(token);
+		prefix.push_back(token);
+
+		if (!depth) done = true;
+
+		if (_in && !*_in) done = true;
+	}
+
+	// If the rest is in a block already, the new scanner can refer to it.
+	if (!done && _blockIndex != _blockEnd)
+	{
+		size_t blockBegin = _blockIndex;
+
+		while (!done && _blockIndex != _blockEnd)
+		{
+			typename TT::TokenType type(_block->tokens[_blockIndex++].getType());
+
+			if (type == typeOpen) ++depth;
+			else if (type == typeClose) --depth;
 
-		if (!depth) break;
+			if (!depth) done = true;
+		}
+
+		if (done)
+		{
+			block_ref(_block);
+			sc._block      = _block;
+			sc._blockIndex = blockBegin;
+			sc._blockEnd   = _blockIndex;
+		}
+		else
+		{
+			tokens.assign(_block->tokens.begin() + blockBegin, _block->tokens.begin() + _blockEnd);
 
-		if (_in && !*_in) break;
+			stats_tokens.add(tokens.size());
+		}
 	}
 
-	// Need to reverse the stack.
-	while (tempStack.size())
+	// Otherwise, read it in and keep it for later.
+	while (!done)
 	{
-		sc._ungetStack.push(tempStack.top());
-		tempStack.pop();
+		TT token(get());
+
+		typename TT::TokenType type(token.getType());
+
+		if (type == typeOpen) ++depth;
+		else if (type == typeClose) --depth;
+
+		tokens.push_back(token);
+
+		if (!depth) done = true;
+
+		if (_in && !*_in) done = true;
+	}
+
+	if (!tokens.empty())
+	{
+		sc._block = new Block;
+		sc._block->tokens.swap(tokens);
+		sc._block->refCount = 1;
+		sc._blockEnd = sc._block->tokens.size();
+	}
+
+	// Need to reverse the prefix for the stack.
+	while (!prefix.empty())
+	{
+		sc._ungetStack.push(prefix.back());
+		prefix.pop_back();
 	}
 
 	return sc;
 }
 
+// Returns a scanner over the tokens from begin to end, counting from the
+// current position. Nothing is consumed, and ungotten tokens are not counted.
+template <typename TT, typename SS>
+SourceScanner<TT, SS> SourceScanner<TT, SS>::getrange(size_t begin, size_t end) const
+{
+	SourceScanner<TT, SS> sc;
+
+	if (_block && begin != end)
+	{
+		block_ref(_block);
+		sc._block      = _block;
+		sc._blockIndex = _blockIndex + begin;
+		sc._blockEnd   = _blockIndex + end;
+	}
+
+	return sc;
+}
+
+// Number of tokens left, not counting any from a stream.
+template <typename TT, typename SS>
+size_t SourceScanner<TT, SS>::size() const
+{
+	return _ungetStack.size() + (_blockEnd - _blockIndex);
+}
+
 template <typename TT, typename SS>
 void SourceScanner<TT, SS>::unget(TT token)
 {
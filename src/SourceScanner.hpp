@@ -19,6 +19,10 @@
 
 /*
 	Extracts and manages tokens from a SourceStream.
+
+	Blocks taken with getblock are stored once in a shared, immutable token
+	buffer. A scanner over a block is only a cursor into that buffer, so
+	copying one does not copy any tokens.
 */
 
 #ifndef SOURCESCANNER_H
@@ -27,7 +31,9 @@
 #include "SourceStream.hpp"
 #include "SourceToken.hpp"
 
+#include <cstddef>
 #include <stack>
+#include <vector>
 
 
 
@@ -38,19 +44,39 @@ class SourceScanner
 		SourceScanner();
 		SourceScanner(SourceScanner<TT, SS> const & sc);
 		explicit SourceScanner(SS & in);
+		explicit SourceScanner(std::vector<TT> const & tokens);
+		~SourceScanner();
+
+		SourceScanner<TT, SS> & operator = (SourceScanner<TT, SS> const & sc);
 
 		TT get();
 		TT get(typename TT::TokenType typeMust);
 		TT get(typename TT::TokenType typeMust, typename TT::TokenType typeSkip);
 
 		SourceScanner<TT, SS> getblock(typename TT::TokenType typeOpen, typename TT::TokenType typeClose);
+		SourceScanner<TT, SS> getrange(size_t begin, size_t end) const;
+
+		size_t size() const;
 
 		void unget(TT token);
 
 	private:
+		struct Block
+		{
+			std::vector<TT> tokens;
+			size_t refCount;
+		};
+
+		static void block_ref(Block * block);
+		static void block_unref(Block * block);
+
 		SS * _in;
 
-		std::stack<TT> _ungetStack;
+		Block * _block;
+		size_t _blockIndex;
+		size_t _blockEnd;
+
+		std::stack<TT, std::vector<TT> > _ungetStack;
 };
 
 typedef SourceScanner<SourceTokenDDL,  SourceStream> SourceScannerDDL;
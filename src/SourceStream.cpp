@@ -30,25 +30,52 @@ SourceStream::SourceStream(std::istream & in, SourceType type) :
 	_ungetStack(),
 	_in(&in),
 
+	_inData(NULL),
+	_inEnd(NULL),
+
 	_countLine(1),
 
 	_depthBrace(0),
 	_depthComment(0),
 
-	_doStrip(true),
-	_doStripAuto(true),
-	_doStripComment(true),
-	_doStripQuote(true),
-	_doStripWhitespace(true),
+	_inFail(false)
+{
+	init(type);
+}
+SourceStream::SourceStream(char const * data, size_t size, SourceType type) :
+	_lastData(-2), _thisData(-2), _nextData(-2),
+	_ungetStack(),
+	_in(NULL),
+
+	_inData(data),
+	_inEnd(data + size),
+
+	_countLine(1),
+
+	_depthBrace(0),
+	_depthComment(0),
 
-	_doCompressWhitespace(false),
+	_inFail(false)
+{
+	init(type);
+}
 
-	_inComment(false),
-	_inQuote(false),
-	_inQuote2(false),
-	_inWhitespace(false),
-	_inWhitespaceLast(false)
+void SourceStream::init(SourceType type)
 {
+	_doStrip           = true;
+	_doStripAuto       = true;
+	_doStripComment    = true;
+	_doStripQuote      = true;
+	_doStripWhitespace = true;
+
+	_doCompressWhitespace = false;
+
+	_inComment        = false;
+	_inQuote          = false;
+	_inQuote2         = false;
+	_inWhitespace     = false;
+	_inWhitespaceLast = false;
+
 	switch (type)
 	{
 	case ST_NORMAL:
@@ -75,8 +102,8 @@ int SourceStream::get()
 
 	while (true)
 	{
-		_thisData = _nextData != -2 ? _nextData : _in->get();
-		_nextData = _in->get();
+		_thisData = _nextData != -2 ? _nextData : read();
+		_nextData = read();
 
 		// \n end of line
 		if (_thisData == '\n')
@@ -187,8 +214,8 @@ int SourceStream::get()
 			case 'x':
 			case 'X':
 			{
-				int digit1 = _in->get();
-				int digit2 = _in->get();
+				int digit1 = read();
+				int digit2 = read();
 
 				switch (digit1)
 				{
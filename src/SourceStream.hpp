@@ -18,14 +18,18 @@
 */
 
 /*
-
+	Reads source data a character at a time, tracking comments, quotes, and
+	braces. Data comes from either an in-memory buffer (such as a mapped
+	file) or an istream. The istream form is only needed for stdin.
 */
 
 #ifndef SOURCESTREAM_H
 #define SOURCESTREAM_H
 
+#include <cstddef>
 #include <istream>
 #include <stack>
+#include <string>
 
 
 
@@ -39,6 +43,7 @@ class SourceStream
 		};
 
 		SourceStream(std::istream & in, SourceType type = ST_NORMAL);
+		SourceStream(char const * data, size_t size, SourceType type = ST_NORMAL);
 
 		int get();
 		void unget(int c);
@@ -56,10 +61,18 @@ class SourceStream
 		     operator void* () const;
 
 	private:
+		void init(SourceType type);
+
+		int read();
+
 		int _lastData, _thisData, _nextData;
 		std::stack<int> _ungetStack;
 		std::istream * _in;
 
+		// Buffer source, used when _in is NULL.
+		char const * _inData;
+		char const * _inEnd;
+
 		int _countLine;
 
 		int _depthBrace;   // { }
@@ -78,6 +91,8 @@ class SourceStream
 		unsigned _inQuote2         : 1; // '
 		unsigned _inWhitespace     : 1;
 		unsigned _inWhitespaceLast : 1;
+
+		unsigned _inFail : 1; // buffer source read past the end
 };
 
 
@@ -109,12 +124,26 @@ inline bool SourceStream::isInQuote() const
 
 inline bool SourceStream::operator ! () const
 {
-	return !(*_in);
+	return _in ? _in->fail() : _inFail;
 }
 
 inline SourceStream::operator void* () const
 {
-	return (void*) *_in;
+	return !*this ? NULL : const_cast<SourceStream *>(this);
+}
+
+// Buffer reads behave like istream::get, including the sticky failure at the
+// end of data.
+inline int SourceStream::read()
+{
+	if (_in)
+		return _in->get();
+
+	if (_inData != _inEnd)
+		return static_cast<unsigned char>(*_inData++);
+
+	_inFail = true;
+	return -1;
 }
 
 
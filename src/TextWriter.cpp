@@ -0,0 +1,204 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+*/
+
+#include "TextWriter.hpp"
+
+#include <climits>
+#include <cstdio>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+
+
+// The same precision that the encodeText functions give their streams.
+static int const text_precision = 256;
+
+// Enough for any real at text_precision.
+static size_t const text_real_size = 512;
+
+static char const text_tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
+static char const text_digits[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+
+
+TextWriter::TextWriter() : std::streambuf(), _buffer(), _stream(this)
+{
+
+}
+
+void TextWriter::flush(std::ostream & out)
+{
+	out.write(data(), size());
+
+	setp(pbase(), epptr());
+}
+
+void TextWriter::reserve(size_t n)
+{
+	size_t used = size();
+
+	size_t capacity = _buffer.size() * 2;
+
+	if (capacity < used + n) capacity = used + n;
+	if (capacity < 4096)     capacity = 4096;
+
+	_buffer.resize(capacity);
+
+	char * begin = &_buffer[0];
+
+	setp(begin, begin + _buffer.size());
+
+	for (; used > size_t(INT_MAX); used -= INT_MAX)
+		pbump(INT_MAX);
+
+	pbump(static_cast<int>(used));
+}
+
+void TextWriter::swap(std::string & out)
+{
+	_buffer.resize(size());
+
+	out.swap(_buffer);
+
+	_buffer.clear();
+
+	setp(NULL, NULL);
+}
+
+void TextWriter::writeIndent(int depth)
+{
+	for (; depth > 0; depth -= sizeof(text_tabs) - 1)
+		write(text_tabs, depth < int(sizeof(text_tabs) - 1) ? depth : sizeof(text_tabs) - 1);
+}
+
+void TextWriter::writeInt(long long int i)
+{
+	if (i < 0)
+	{
+		put('-');
+
+		// Negated unsigned, so LLONG_MIN does not overflow.
+		writeUInt(0ULL - static_cast<unsigned long long int>(i));
+	}
+	else
+	{
+		writeUInt(static_cast<unsigned long long int>(i));
+	}
+}
+
+void TextWriter::writeUInt(unsigned long long int i)
+{
+	char buffer[24];
+	char * end = buffer + sizeof(buffer);
+	char * begin = end;
+
+	for (; i >= 100; i /= 100)
+	{
+		begin -= 2;
+		begin[0] = text_digits[(i % 100) * 2    ];
+		begin[1] = text_digits[(i % 100) * 2 + 1];
+	}
+
+	if (i >= 10)
+	{
+		begin -= 2;
+		begin[0] = text_digits[i * 2    ];
+		begin[1] = text_digits[i * 2 + 1];
+	}
+	else
+	{
+		*--begin = static_cast<char>('0' + i);
+	}
+
+	write(begin, end - begin);
+}
+
+void TextWriter::writeQuoted(char const * s, size_t n)
+{
+	put('"');
+
+	for (char const * end = s + n; s != end; ++s)
+	{
+		if (*s == '\\' || *s == '"')
+			put('\\');
+
+		put(*s);
+	}
+
+	put('"');
+}
+
+void TextWriter::writeReal(double f)
+{
+	char buffer[text_real_size];
+
+	#if __cplusplus >= 201703L && defined(__cpp_lib_to_chars)
+	write(buffer, std::to_chars(buffer, buffer + sizeof(buffer), f, std::chars_format::general, text_precision).ptr - buffer);
+	#else
+	write(buffer, snprintf(buffer, sizeof(buffer), "%.*g", text_precision, f));
+	#endif
+}
+
+void TextWriter::writeReal(long double f)
+{
+	char buffer[text_real_size];
+
+	#if __cplusplus >= 201703L && defined(__cpp_lib_to_chars)
+	write(buffer, std::to_chars(buffer, buffer + sizeof(buffer), f, std::chars_format::general, text_precision).ptr - buffer);
+	#else
+	write(buffer, snprintf(buffer, sizeof(buffer), "%.*Lg", text_precision, f));
+	#endif
+}
+
+TextWriter::int_type TextWriter::overflow(int_type c)
+{
+	if (traits_type::eq_int_type(c, traits_type::eof()))
+		return traits_type::not_eof(c);
+
+	put(traits_type::to_char_type(c));
+
+	return c;
+}
+
+std::streamsize TextWriter::xsputn(char const * s, std::streamsize n)
+{
+	write(s, n);
+
+	return n;
+}
+
+
+
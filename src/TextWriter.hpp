@@ -0,0 +1,115 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Output text, kept in one contiguous buffer that grows as needed. Numbers
+	are formatted straight into the buffer, the same as an ostream with
+	precision 256 would format them, but without going through locales and
+	sentries for every value.
+
+	TextWriter is also a streambuf over the same buffer, so that anything
+	that only knows how to write to an ostream can be written with stream().
+
+	2026/10/17 - Original version.
+*/
+
+#ifndef TEXTWRITER_H
+#define TEXTWRITER_H
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+
+
+class TextWriter : private std::streambuf
+{
+	public:
+		TextWriter();
+
+		char const * data() const {return pbase();}
+		size_t       size() const {return pptr() - pbase();}
+
+		// Writes everything to out, in a single write, and empties the buffer.
+		void flush(std::ostream & out);
+
+		std::ostream & stream() {return _stream;}
+
+		// Gives the text to out, and empties the buffer.
+		void swap(std::string & out);
+
+		void put(char c);
+
+		void write(char const * s, size_t n);
+		void write(std::string const & s) {write(s.data(), s.size());}
+
+		// depth tabs.
+		void writeIndent(int depth);
+
+		void writeInt(long long int i);
+		void writeUInt(unsigned long long int i);
+
+		// Quoted, with '\\' and '"' escaped.
+		void writeQuoted(char const * s, size_t n);
+
+		void writeReal(double f);
+		void writeReal(long double f);
+
+	private:
+		TextWriter(TextWriter const &);
+
+		TextWriter & operator = (TextWriter const &);
+
+		// Makes room for at least n more characters.
+		void reserve(size_t n);
+
+		virtual int_type overflow(int_type c);
+
+		virtual std::streamsize xsputn(char const * s, std::streamsize n);
+
+		std::string _buffer;
+
+		std::ostream _stream;
+};
+
+
+
+inline void TextWriter::put(char c)
+{
+	if (pptr() == epptr()) reserve(1);
+
+	*pptr() = c;
+	pbump(1);
+}
+
+inline void TextWriter::write(char const * s, size_t n)
+{
+	if (size_t(epptr() - pptr()) < n) reserve(n);
+
+	std::char_traits<char>::copy(pptr(), s, n);
+	pbump(static_cast<int>(n));
+}
+
+
+
+#endif /* TEXTWRITER_H */
+
+
+
@@ -0,0 +1,271 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+*/
+
+#include "WadWriter.hpp"
+
+#include "../common/foreach.hpp"
+
+#include <cctype>
+#include <cstring>
+
+
+
+// Map lumps, in the order they go in a map.
+static char const * const wad_map_lumps[] =
+{
+	"TEXTMAP",
+	"THINGS",
+	"LINEDEFS",
+	"SIDEDEFS",
+	"VERTEXES",
+	"SEGS",
+	"SSECTORS",
+	"NODES",
+	"SECTORS",
+	"REJECT",
+	"BLOCKMAP",
+	"BEHAVIOR",
+	"SCRIPTS",
+	"ZNODES",
+	"DIALOGUE",
+	"ENDMAP",
+};
+
+static size_t const wad_map_lumps_count = sizeof(wad_map_lumps) / sizeof(*wad_map_lumps);
+
+
+
+static unsigned long wad_get_32(char const * data)
+{
+	unsigned char const * udata = reinterpret_cast<unsigned char const *>(data);
+
+	return udata[0] | (udata[1] << 8) | (udata[2] << 16) | (static_cast<unsigned long>(udata[3]) << 24);
+}
+
+static void wad_put_32(char * data, size_t value)
+{
+	data[0] = static_cast<char>((value      ) & 0xFF);
+	data[1] = static_cast<char>((value >>  8) & 0xFF);
+	data[2] = static_cast<char>((value >> 16) & 0xFF);
+	data[3] = static_cast<char>((value >> 24) & 0xFF);
+}
+
+static std::string wad_lump_name(std::string const & name)
+{
+	std::string lumpName(name, 0, 8);
+
+	FOREACH_T(std::string, it, lumpName)
+		*it = static_cast<char>(std::toupper(static_cast<unsigned char>(*it)));
+
+	return lumpName;
+}
+
+// Returns the lump's place in a map, or -1 if it is not a map lump.
+static int wad_map_rank(std::string const & name)
+{
+	for (size_t index = 0; index < wad_map_lumps_count; ++index)
+	{
+		if (name == wad_map_lumps[index])
+			return static_cast<int>(index);
+	}
+
+	return -1;
+}
+
+
+
+WadWriter::WadWriter() : _lumps(), _map(_lumps.end())
+{
+
+}
+
+void WadWriter::addLump(std::string const & name, std::string & data)
+{
+	std::string lumpName(wad_lump_name(name));
+
+	int rank = wad_map_rank(lumpName);
+
+	if (rank >= 0 && _map != _lumps.end())
+	{
+		lump_list_t::iterator it(_map);
+
+		for (++it; it != _lumps.end(); ++it)
+		{
+			int itRank = wad_map_rank(it->name);
+
+			if (itRank < 0 || itRank > rank)
+				break;
+
+			if (itRank == rank)
+			{
+				it->data.swap(data);
+				return;
+			}
+		}
+
+		insert(it, lumpName)->data.swap(data);
+
+		if (lumpName == "TEXTMAP")
+		{
+			std::string dataENDMAP;
+			addLump("ENDMAP", dataENDMAP);
+		}
+
+		return;
+	}
+
+	lump_list_t::iterator it(_lumps.begin());
+
+	for (; it != _lumps.end(); ++it)
+	{
+		if (it->name != lumpName)
+			continue;
+
+		// A map marker with the same name is not the same lump.
+		lump_list_t::iterator next(it);
+
+		if (++next == _lumps.end() || wad_map_rank(next->name) < 0)
+			break;
+	}
+
+	if (it == _lumps.end())
+		it = insert(it, lumpName);
+
+	it->data.swap(data);
+}
+
+void WadWriter::addMap(std::string const & name)
+{
+	std::string lumpName(wad_lump_name(name));
+
+	for (_map = _lumps.begin(); _map != _lumps.end(); ++_map)
+	{
+		if (_map->name != lumpName)
+			continue;
+
+		lump_list_t::iterator next(_map);
+
+		if (++next == _lumps.end() || wad_map_rank(next->name) < 0)
+			continue;
+
+		// The old map is replaced where it is. A TEXTMAP map runs to its
+		// ENDMAP, whatever is in between.
+		bool textmap = next->name == "TEXTMAP";
+
+		while (next != _lumps.end() && (textmap || wad_map_rank(next->name) >= 0))
+		{
+			bool endmap = next->name == "ENDMAP";
+
+			next = _lumps.erase(next);
+
+			if (endmap) break;
+		}
+
+		_map->data.clear();
+
+		return;
+	}
+
+	_map = insert(_lumps.end(), lumpName);
+}
+
+WadWriter::lump_list_t::iterator WadWriter::insert(lump_list_t::iterator it, std::string const & name)
+{
+	it = _lumps.insert(it, Lump());
+
+	it->name = name;
+
+	return it;
+}
+
+bool WadWriter::read(char const * data, size_t size)
+{
+	if (size < 12 || (std::memcmp(data, "PWAD", 4) != 0 && std::memcmp(data, "IWAD", 4) != 0))
+		return false;
+
+	size_t count     = wad_get_32(data + 4);
+	size_t directory = wad_get_32(data + 8);
+
+	if (directory > size || count > (size - directory) / 16)
+		return false;
+
+	for (char const * entry = data + directory; count; --count, entry += 16)
+	{
+		size_t offset = wad_get_32(entry    );
+		size_t length = wad_get_32(entry + 4);
+
+		if (offset > size || length > size - offset)
+			return false;
+
+		size_t nameLength = 0;
+
+		while (nameLength < 8 && entry[8 + nameLength])
+			++nameLength;
+
+		lump_list_t::iterator it(insert(_lumps.end(), std::string(entry + 8, nameLength)));
+
+		it->data.assign(data + offset, length);
+	}
+
+	return true;
+}
+
+void WadWriter::write(std::ostream & out) const
+{
+	size_t size = 12;
+
+	FOREACH_T_CONST(lump_list_t, it, _lumps)
+		size += it->data.size();
+
+	size_t directory = size;
+
+	size += _lumps.size() * 16;
+
+	std::string buffer(size, '\0');
+
+	char * header = &buffer[0];
+	char * lump   = header + 12;
+	char * entry  = header + directory;
+
+	std::memcpy(header, "PWAD", 4);
+	wad_put_32(header + 4, _lumps.size());
+	wad_put_32(header + 8, directory);
+
+	FOREACH_T_CONST(lump_list_t, it, _lumps)
+	{
+		wad_put_32(entry,     lump - header);
+		wad_put_32(entry + 4, it->data.size());
+		std::memcpy(entry + 8, it->name.data(), it->name.size());
+
+		if (!it->data.empty())
+			std::memcpy(lump, it->data.data(), it->data.size());
+
+		lump  += it->data.size();
+		entry += 16;
+	}
+
+	out.write(buffer.data(), buffer.size());
+}
+
+
+
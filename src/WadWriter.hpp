@@ -0,0 +1,92 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Builds a PWAD in memory, for --wad. The lumps of an existing WAD can be
+	read in first, so that a WAD can be built up one map at a time. Adding a
+	map replaces any map of the same name.
+
+	Map lumps are kept in the order that engines expect, whatever order they
+	are added in. TEXTMAP maps are given an ENDMAP.
+
+	Lump names are made upper case, and cut to eight characters.
+
+	2026/10/17 - Original version.
+*/
+
+#ifndef WADWRITER_H
+#define WADWRITER_H
+
+#include <cstddef>
+#include <list>
+#include <ostream>
+#include <string>
+
+
+
+class WadWriter
+{
+	public:
+		WadWriter();
+
+		/*
+			Starts a map. Lumps with map lump names are put in it until the
+			next addMap.
+		*/
+		void addMap(std::string const & name);
+
+		/*
+			Adds a lump, taking the contents of data. A lump that is not in
+			a map replaces any other such lump with the same name.
+		*/
+		void addLump(std::string const & name, std::string & data);
+
+		/*
+			Reads the lumps from a WAD. Returns false if data is not a WAD.
+		*/
+		bool read(char const * data, size_t size);
+
+		/*
+			Writes the whole WAD with a single write.
+		*/
+		void write(std::ostream & out) const;
+
+	private:
+		struct Lump
+		{
+			std::string name;
+			std::string data;
+		};
+
+		typedef std::list<Lump> lump_list_t;
+
+		lump_list_t::iterator insert(lump_list_t::iterator it, std::string const & name);
+
+		lump_list_t _lumps;
+
+		// The current map's marker, or end.
+		lump_list_t::iterator _map;
+};
+
+
+
+#endif /* WADWRITER_H */
+
+
+
@@ -0,0 +1,106 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+*/
+
+#include "arena.hpp"
+
+#include <new>
+
+
+
+// Blocks are rounded up to this, which is enough for any type.
+static size_t const arena_align = 16;
+
+// Bytes per chunk, unless one block is larger.
+static size_t const arena_chunk = 64 * 1024;
+
+
+
+// Arenas are usually function statics, so this has to be set before any
+// constructor runs. Being zero-initialized, it is.
+Arena * Arena::_first;
+
+Arena::Arena(char const * name, size_t size) : _chunks(NULL), _free(NULL), _begin(NULL), _end(NULL), _name(name), _size(size), _sizeChunk(arena_chunk), _countChunk(0), _countUsed(0), _countPeak(0), _next(_first)
+{
+	if (_size < sizeof(Block)) _size = sizeof(Block);
+
+	_size = (_size + arena_align - 1) / arena_align * arena_align;
+
+	if (_sizeChunk < _size) _sizeChunk = _size;
+
+	// Whole blocks only, so that _begin lands on _end exactly.
+	_sizeChunk -= _sizeChunk % _size;
+
+	_first = this;
+}
+
+// Each chunk starts with a link to the previous one, padded out to
+// arena_align so that the blocks after it stay aligned.
+void Arena::grow()
+{
+	char * chunk = static_cast<char *>(::operator new(arena_align + _sizeChunk));
+
+	reinterpret_cast<Block *>(chunk)->next = _chunks;
+	_chunks = reinterpret_cast<Block *>(chunk);
+
+	++_countChunk;
+
+	_begin = chunk + arena_align;
+	_end   = _begin + _sizeChunk;
+}
+
+
+
+void print_arenas(std::ostream & out)
+{
+	for (Arena * arena = Arena::_first; arena; arena = arena->_next)
+	{
+		out << "arena:" << arena->getName() << ':' << arena->getSize()
+		    << ":bytes=" << arena->getBytes()
+		    << ":used="  << arena->getCount()
+		    << ":peak="  << arena->getPeak() << ";\n";
+	}
+}
+
+void release_arenas()
+{
+	for (Arena * arena = Arena::_first; arena; arena = arena->_next)
+	{
+		while (arena->_chunks)
+		{
+			Arena::Block * chunk = arena->_chunks;
+			arena->_chunks = chunk->next;
+
+			::operator delete(chunk);
+		}
+
+		arena->_free  = NULL;
+		arena->_begin = NULL;
+		arena->_end   = NULL;
+
+		arena->_countChunk = 0;
+		arena->_countUsed  = 0;
+	}
+}
+
+
+
@@ -0,0 +1,142 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Blocks of one size, taken from large chunks that last for the whole
+	compile. A freed block is kept to be given out again, but chunks are
+	never given back until release_arenas(), which frees all of them at once
+	without running any destructors. That is only for when the program is
+	about to exit.
+
+	Arena has no destructor, so that objects freed by static destructors can
+	still go back to an arena that was constructed after them.
+
+	2026/10/17 - Original version.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <ostream>
+
+
+
+class Arena
+{
+	public:
+		Arena(char const * name, size_t size);
+
+		void * alloc();
+
+		void free(void * p);
+
+		size_t getBytes() const {return _countChunk * _sizeChunk;}
+		size_t getCount() const {return _countUsed;}
+		size_t getPeak()  const {return _countPeak;}
+		size_t getSize()  const {return _size;}
+
+		char const * getName() const {return _name;}
+
+		friend void print_arenas(std::ostream &);
+		friend void release_arenas();
+
+	private:
+		struct Block
+		{
+			Block * next;
+		};
+
+		Arena(Arena const &);
+
+		void grow();
+
+		Arena & operator = (Arena const &);
+
+		Block * _chunks;
+		Block * _free;
+
+		// What is left of the newest chunk.
+		char * _begin;
+		char * _end;
+
+		char const * _name;
+
+		size_t _size;
+		size_t _sizeChunk;
+
+		size_t _countChunk;
+		size_t _countUsed;
+		size_t _countPeak;
+
+		Arena * _next;
+
+		static Arena * _first;
+};
+
+/*
+	Prints the counters of every arena.
+*/
+void print_arenas(std::ostream &);
+
+/*
+	Frees every chunk of every arena. Anything still in them is lost.
+*/
+void release_arenas();
+
+
+
+inline void * Arena::alloc()
+{
+	void * p;
+
+	if (_free)
+	{
+		p = _free;
+		_free = _free->next;
+	}
+	else
+	{
+		if (_begin == _end) grow();
+
+		p = _begin;
+		_begin += _size;
+	}
+
+	if (++_countUsed > _countPeak) _countPeak = _countUsed;
+
+	return p;
+}
+
+inline void Arena::free(void * p)
+{
+	Block * block = static_cast<Block *>(p);
+
+	block->next = _free;
+	_free = block;
+
+	--_countUsed;
+}
+
+
+
+#endif /* ARENA_H */
+
+
+
@@ -18,50 +18,68 @@
 */
 
 /*
-
+	2026/10/17 - Compound objects are timed for --debug-time.
+	2026/10/17 - Traced compound objects are labelled with the object's name.
+	2026/10/17 - Compound objects are timed for --profile-source.
 */
 
 #include "compound_objects.hpp"
 
 #include <map>
 
+#include "CodeDDL.hpp"
+#include "CodeDHLX.hpp"
+#include "profile.hpp"
 #include "types.hpp"
 #include "exceptions/InvalidTypeException.hpp"
 
 
 
-std::map<std::string, std::string> compound_object_defines_DDL;
-std::map<std::string, SourceScannerDHLX> compound_object_defines_DHLX;
+std::map<std::string, CodeDDL *> compound_object_defines_DDL;
+std::map<std::string, CodeDHLX *> compound_object_defines_DHLX;
 
 void add_compound_object(std::string const & type, SourceScannerDHLX & sc)
 {
-	compound_object_defines_DHLX[type] = sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C);
+	CodeDHLX *& code = compound_object_defines_DHLX[type];
+
+	delete code;
+
+	code = new CodeDHLX(sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C));
 }
 void add_compound_object(std::string const & type, std::string const & data)
 {
-	compound_object_defines_DDL[type] = data;
+	CodeDDL *& code = compound_object_defines_DDL[type];
+
+	delete code;
+
+	code = new CodeDDL(data);
 }
 
 void do_compound_object(std::string const & type, obj_t const & object)
 {
-	std::map<std::string, std::string>::iterator itDDL = compound_object_defines_DDL.find(type);
+	ProfileScope profile("compound", type);
+
+	if (ProfileScope::trace_enabled && !profile_get_object().empty())
+		profile.setLabel(type + ' ' + profile_get_object());
+
+	ProfileSource profileSource(ProfileSource::KIND_COMPOUND, type);
+
+	std::map<std::string, CodeDDL *>::iterator itDDL = compound_object_defines_DDL.find(type);
 
 	if (itDDL != compound_object_defines_DDL.end())
 	{
-		object->addData(itDDL->second, type);
+		object->addData(*itDDL->second, type);
 
 		object->setCompounded();
 
 		return;
 	}
 
-	std::map<std::string, SourceScannerDHLX>::iterator itDHLX = compound_object_defines_DHLX.find(type);
+	std::map<std::string, CodeDHLX *>::iterator itDHLX = compound_object_defines_DHLX.find(type);
 
 	if (itDHLX != compound_object_defines_DHLX.end())
 	{
-		SourceScannerDHLX data(itDHLX->second);
-
-		object->addData(data);
+		object->addData(*itDHLX->second);
 
 		object->setCompounded();
 
@@ -25,6 +25,7 @@
 		duplicate entires instead of iterating over the entire list of
 		objects.
 	2010/02/28 - Update for lo_type enum.
+	2026/10/17 - Index lookup and removal no longer walk the list.
 */
 
 #include "global_object.hpp"
@@ -65,11 +66,7 @@ void add_object(name_t const & name, obj_t newObject)
 	// Must not have duplicate entries in list...
 	newObject->_addGlobal = false;
 
-	global_object_list_t & typeList = global_object_map[newObject->getType()];
-
-	newObject->_index = typeList.size();
-
-	typeList.push_back(newObject);
+	global_object_map[newObject->getType()].add(newObject);
 }
 
 void clean_objects()
@@ -77,6 +74,12 @@ void clean_objects()
 
 }
 
+void compact_objects()
+{
+	FOREACH_T(global_object_map_t, it, global_object_map)
+		it->second.compact();
+}
+
 obj_t get_object(name_t const & name)
 {
 	FOREACH_REVERSE_T(LevelObjectStack::stack_type, rit, LevelObjectStack::stack)
@@ -101,19 +104,7 @@ obj_t get_object(int_s_t objectIndex, type_t const type)
 	if (objectIndex == -1)
 		return NULL;
 
-	int_s_t typeCount = 0;
-
-	global_object_list_t & objectList = global_object_map[type];
-
-	FOREACH_T(global_object_list_t, it, objectList)
-	{
-		if (typeCount == objectIndex)
-			return *it;
-
-		++typeCount;
-	}
-
-	throw ParsingException("index out of bounds:" + make_string(objectIndex));
+	return global_object_map[type].get(objectIndex);
 }
 
 int_s_t get_object_index(obj_t oldObject)
@@ -121,7 +112,7 @@ int_s_t get_object_index(obj_t oldObject)
 	if (oldObject == NULL)
 		return -1;
 
-	if (oldObject->_index != (size_t)-1) return oldObject->_index;
+	if (oldObject->_index != (size_t)-1) return global_object_map[oldObject->getType()].getIndex(oldObject);
 
 	throw CompilerException("object has no valid index");
 }
@@ -142,31 +133,70 @@ bool rem_object(obj_t oldObject)
 	// And object with an index of -1 is not in an output list.
 	if (oldObject->_index == size_t(-1)) return false;
 
-	bool found = false;
+	global_object_map[oldObject->getType()].rem(oldObject);
 
-	global_object_list_t & objectList = global_object_map[oldObject->getType()];
+	return true;
+}
+
+
+
+GlobalObjectList::GlobalObjectList() : _objects(), _countDead(0)
+{
 
-	global_object_list_t::reverse_iterator it(objectList.rbegin());
+}
 
-	for (; it != objectList.rend(); ++it)
+void GlobalObjectList::add(obj_t newObject)
+{
+	newObject->_index = _objects.size();
+
+	_objects.push_back(newObject);
+}
+
+void GlobalObjectList::compact()
+{
+	if (!_countDead) return;
+
+	size_t index = 0;
+
+	FOREACH_T(std::vector<obj_t>, it, _objects)
 	{
-		if (oldObject == *it)
-		{
-			objectList.erase(--(it.base()));
-			found = true;
-			break;
-		}
-
-		--(*it)->_index;
+		if (*it == NULL) continue;
+
+		(*it)->_index = index;
+		_objects[index++] = *it;
 	}
 
+	_objects.resize(index);
+	_countDead = 0;
+}
+
+obj_t GlobalObjectList::get(int_s_t objectIndex)
+{
+	compact();
+
+	if (objectIndex < 0 || size_t(objectIndex) >= _objects.size())
+		throw ParsingException("index out of bounds:" + make_string(objectIndex));
+
+	return _objects[objectIndex];
+}
+
+int_s_t GlobalObjectList::getIndex(obj_t oldObject)
+{
+	compact();
+
+	return oldObject->_index;
+}
+
+void GlobalObjectList::rem(obj_t oldObject)
+{
 	// At this point, there is no meaningful way to proceed.
-	if (!found)
+	if (oldObject->_index >= _objects.size() || !(_objects[oldObject->_index] == oldObject))
 		throw std::invalid_argument("rem_object(obj_t):oldObject not in objectList");
 
-	oldObject->_index = -1;
+	_objects[oldObject->_index] = NULL;
+	++_countDead;
 
-	return true;
+	oldObject->_index = -1;
 }
 
 
@@ -20,6 +20,8 @@
 /*
 	03/02/2010 - Update for name_t.
 	06/02/2010 - Minor cleanup.
+	2026/10/17 - The output lists are now GlobalObjectList, indexed
+		vectors with tombstones.
 */
 
 #ifndef GLOBAL_OBJECT_H
@@ -32,10 +34,43 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 
 
-typedef std::list<obj_t> global_object_list_t;
+/*
+	The output objects of one type, in order. An object's _index is its slot
+	in the list. Removing leaves a NULL in the slot, so it needs no search
+	and no renumbering. The list is compacted back into output numbering
+	when an index is asked for, and by compact_objects() before encoding.
+	Iterating only makes sense after compacting.
+*/
+class GlobalObjectList
+{
+	public:
+		typedef std::vector<obj_t>::const_iterator const_iterator;
+		typedef std::vector<obj_t>::iterator iterator;
+
+		GlobalObjectList();
+
+		void add(obj_t);
+		void compact();
+		obj_t get(int_s_t);
+		int_s_t getIndex(obj_t);
+		void rem(obj_t);
+
+		const_iterator begin() const {return _objects.begin();}
+		      iterator begin()       {return _objects.begin();}
+		const_iterator end() const {return _objects.end();}
+		      iterator end()       {return _objects.end();}
+
+	private:
+		std::vector<obj_t> _objects;
+
+		size_t _countDead;
+};
+
+typedef GlobalObjectList global_object_list_t;
 typedef std::map<type_t, global_object_list_t> global_object_map_t;
 
 extern obj_t               global_object;
@@ -45,6 +80,11 @@ void add_object(name_t const &, obj_t);
 
 void clean_objects();
 
+/*
+	Compacts every list in global_object_map. Must be called before output.
+*/
+void compact_objects();
+
 obj_t get_object(name_t const &);
 obj_t get_object(name_t const &, type_t const);
 obj_t get_object(int_s_t, type_t const);
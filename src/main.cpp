@@ -21,17 +21,40 @@
 	2010/02/03 - Update for new process_options.h.
 	2010/05/05 - Update limits() to account for *_MAX and *_MIN defines
 		always being defined.
+	2026/10/17 - Added main_exit() for --fast-exit and --debug-arena.
+	2026/10/17 - Output is encoded by OutputJobs, before any of it is written.
+	2026/10/17 - Added --compact-text.
+	2026/10/17 - Added --wad, which writes every lump into a PWAD.
+	2026/10/17 - Added --do-output-multi, which outputs every selected format
+		from the one compile.
+	2026/10/17 - Added --do-nodes, which builds the nodes for binary formats.
+	2026/10/17 - Added --do-blockmap and --do-reject.
+	2026/10/17 - --debug-time prints a profile of the whole run, in wall time.
+	2026/10/17 - Added --trace, which writes the run as a Chrome trace.
+	2026/10/17 - Added --profile-source, which prints the slowest source lines,
+		compound objects, and functions.
+	2026/10/17 - Added --debug-stats, which prints counts of objects made and
+		copied.
 */
 
 #include "main.hpp"
 
+#include "arena.hpp"
+#include "BlockmapBuilder.hpp"
 #include "global_object.hpp"
 #include "math.hpp"
+#include "NodeBuilder.hpp"
 #include "options.hpp"
+#include "output.hpp"
 #include "process_file.hpp"
 #include "process_stream.hpp"
+#include "profile.hpp"
+#include "RejectBuilder.hpp"
 #include "scripts.hpp"
 #include "SourceStream.hpp"
+#include "stats.hpp"
+#include "TextWriter.hpp"
+#include "WadWriter.hpp"
 #include "types.hpp"
 
 #include "exceptions/CompilerException.hpp"
@@ -43,6 +66,7 @@
 #include "../common/IO.hpp"
 #include "../common/process_options.h"
 
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
@@ -119,6 +143,9 @@ void usage()
 		"The Output options (output-*) are mutually exclusive.\n"
 		"If more than one is selected, the first listed here is used.\n"
 		"output-extradata and output-usdf are additive.\n"
+		"With output-multi, every format selected is output, each to a subdirectory\n"
+		"  (or a WAD, with its name before the extension) named after the format.\n"
+		"  UDMF is selected unless no-output-udmf is used.\n"
 		"\n"
 		"Options:\n"
 		"  -h, --help     displays this text and exits\n"
@@ -130,12 +157,18 @@ void usage()
 		"                       terminating\n"
 		"      --do-extensions  makes output files have extensions\n"
 		"  -i, --include        adds to the list of directories to search for files in\n"
+		"  -j, --jobs           sets the number of threads used to encode output and\n"
+		"                       build nodes\n"
+		"                       [default: one per processor]\n"
 		"  -m, --map-name       sets the map name\n"
 		#if USE_GMPLIB
 		"  -p, --precision      sets the precision for floats in bits [default: 128]\n"
 		#else
 		"  -p, --precision      sets the precision for floats in bits [default: UNUSED]\n"
 		#endif
+		"      --no-fast-exit   frees every object before exiting\n"
+		"      --wad            writes a PWAD instead of separate files, keeping any\n"
+		"                       other maps already in it\n"
 		"\n"
 		"Scripts:\n"
 		"      --script-acs        sets the output name for ACS scripts\n"
@@ -162,13 +195,42 @@ void usage()
 		"      --do-output-heretic    output files in Heretic format\n"
 		"      --do-output-doom       output files in Doom format\n"
 		"      --do-output-udmf       output files in UDMF format [default]\n"
+		"      --do-output-multi      output every format selected\n"
+		"      --do-compact-text      output UDMF and USDF without indentation or\n"
+		"                             comments\n"
+		"      --do-nodes             build SEGS, SSECTORS, and NODES for binary\n"
+		"                             formats\n"
+		"      --do-nodes-extended    build the nodes in ZDoom's extended format, which\n"
+		"                             is used anyway if they are too big for the others\n"
+		"      --do-blockmap          build BLOCKMAP for binary formats\n"
+		"      --do-reject            build REJECT for binary formats\n"
+		"      --do-reject-zero       build an all-zero REJECT, without finding which\n"
+		"                             sectors can see each other\n"
 		"\n"
 		"Debugging:\n"
 		"      --debug        enables debugging messages\n"
+		"      --debug-arena  prints the memory used by each arena at exit\n"
 		"      --debug-dump   prints every object at the end of program\n"
 		"                     WARNING: will go into an infinite loop if an object\n"
 		"                     references itself, directly or otherwise\n"
+		"      --debug-stats  prints how many objects were made and freed, by type,\n"
+		"                     and how often maps, scanners, and tokens were copied,\n"
+		"                     values parsed, and strings made\n"
+		"      --debug-stats-json\n"
+		"                     prints the same, as JSON\n"
+		"      --debug-time   prints where the time went, as a tree of files,\n"
+		"                     compound objects, functions, parsing, and output\n"
+		"      --debug-time-json\n"
+		"                     prints the same, as JSON\n"
 		"      --debug-token  prints every token read.\n"
+		"      --profile-source\n"
+		"                     prints the source lines, compound objects, and\n"
+		"                     functions that took the most time\n"
+		"      --profile-source-top\n"
+		"                     sets how many of them are printed [default: 25]\n"
+		"      --trace        writes a Chrome trace-event file of files, statements,\n"
+		"                     compound objects, functions, and output lumps, for\n"
+		"                     a timeline viewer\n"
 	;
 }
 
@@ -177,11 +239,332 @@ void version()
 	std::cerr << "DH-dlc 1.0\n";
 }
 
-int main(int argc, char** argv)
+/*
+	With --fast-exit, everything still in use is dropped at once here instead
+	of being freed one object at a time by the static destructors.
+*/
+static int main_exit(int code)
+{
+	if (option_debug_time || option_debug_time_json)
+		print_profile(std::cerr, option_debug_time_json);
+
+	if (option_profile_source)
+		print_profile_source(std::cerr, option_profile_source_top);
+
+	if (option_debug_stats || option_debug_stats_json)
+		print_stats(std::cerr, option_debug_stats_json);
+
+	if (!option_trace.empty())
+	{
+		std::ofstream fileTrace(option_trace.c_str());
+
+		if (fileTrace)
+			print_trace(fileTrace);
+		else
+			std::cerr << "unable to open:" << option_trace << '\n';
+	}
+
+	if (option_debug_arena)
+		print_arenas(std::cerr);
+
+	if (!option_fast_exit)
+		return code;
+
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(NULL);
+
+	release_arenas();
+
+	_Exit(code);
+}
+
+/*
+	One output format, and where its jobs are in the list of OutputJobs.
+*/
+struct OutputFormat
+{
+	OutputFormat(char const * _name, OutputJob::encoder_t _encoder) : name(_name), encoder(_encoder), jobsLumps(0), jobsLumpsEnd(0), jobsExtraData(0), jobsExtraDataEnd(0) {}
+
+	// NULL if there are no map lumps, only USDF, ExtraData and scripts.
+	char const * name;
+
+	// NULL for UDMF.
+	OutputJob::encoder_t encoder;
+
+	// The binary lumps, in the order of output_lump_names, or TEXTMAP.
+	size_t jobsLumps, jobsLumpsEnd;
+
+	size_t jobsExtraData, jobsExtraDataEnd;
+};
+
+/*
+	The lumps built for every binary format. NULL for those not built.
+*/
+struct OutputBuilders
+{
+	OutputBuilders() : nodes(NULL), blockmap(NULL), reject(NULL) {}
+
+	NodeBuilder     const * nodes;
+	BlockmapBuilder const * blockmap;
+	RejectBuilder   const * reject;
+};
+
+static char const * const output_lump_names[] = {"LINEDEFS", "SECTORS", "SIDEDEFS", "THINGS", "VERTEXES"};
+
+static size_t const output_lump_count = sizeof(output_lump_names) / sizeof(*output_lump_names);
+
+// Nodes add vertices to it.
+static size_t const output_lump_vertexes = 4;
+
+/*
+	Writes a lump to its own file in directory, adding ext if --do-extensions
+	is used, or adds it to wad if there is one.
+*/
+static bool output_lump(WadWriter * wad, std::string const & directory, std::string const & name, char const * ext, std::string & data)
+{
+	ProfileScope profile("lump", name);
+
+	if (wad)
+	{
+		wad->addLump(name, data);
+		return true;
+	}
+
+	std::string filename(name);
+	if (option_use_file_extensions && ext)
+		filename += ext;
+
+	std::ofstream file((directory + filename).c_str(), std::ios_base::out | std::ios_base::binary);
+
+	if (!file)
+	{
+		std::cerr << "unable to open:" << filename << "\n";
+		return false;
+	}
+
+	file.write(data.data(), data.size());
+
+	return true;
+}
+
+/*
+	Writes everything for one format to directory, or to the WAD wadName if
+	it is not empty. The jobs must have been run. Returns the exit code.
+*/
+static int output_format(OutputFormat const & format, std::string const & directory, std::string const & wadName, std::vector<OutputJob> const & jobs, size_t jobsDIALOG, size_t jobsDIALOGEnd, OutputBuilders const & builders)
 {
-	clock_t clock_start(clock());
-	clock_t clock_total(0);
+	// With --wad, every lump goes in wad instead of in its own file.
+	WadWriter wad;
+	WadWriter * wadOut = wadName.empty() ? NULL : &wad;
+
+	if (wadOut)
+	{
+		IO::MappedFile fileWad;
+
+		// An existing WAD keeps its other maps and lumps.
+		if (fileWad.open(wadName) && !wad.read(fileWad.data(), fileWad.size()))
+		{
+			std::cerr << "not a WAD:" << wadName << '\n';
+			return 1;
+		}
+
+		wad.addMap(option_map_name);
+	}
+	else
+	{
+		IO::mkdir(directory, true);
+	}
+
+	if (format.encoder)
+	{
+		std::string dataLumps[output_lump_count];
+
+		bool written = true;
+
+		// An error in one lump stops the ones after it.
+		for (size_t index = 0; index < output_lump_count; ++index)
+		{
+			if (!jobs[format.jobsLumps + index].write(dataLumps[index]))
+			{
+				written = false;
+				break;
+			}
+		}
+
+		// The built lumps only go with lumps that were all written.
+		NodeBuilder     const * nodes    = written ? builders.nodes    : NULL;
+		BlockmapBuilder const * blockmap = written ? builders.blockmap : NULL;
+		RejectBuilder   const * reject   = written ? builders.reject   : NULL;
+
+		std::string dataSEGS, dataSSECTORS, dataNODES, dataBLOCKMAP, dataREJECT;
+
+		if (nodes)
+		{
+			if (option_nodes_extended || nodes->needsExtended())
+				nodes->writeExtended(dataNODES, true);
+			else
+				nodes->writeClassic(dataLumps[output_lump_vertexes], dataSEGS, dataSSECTORS, dataNODES);
+		}
+
+		if (blockmap && !blockmap->write(dataBLOCKMAP))
+		{
+			std::cerr << "BLOCKMAP too big, left out\n";
+			blockmap = NULL;
+		}
+
+		if (reject)
+			reject->write(dataREJECT, option_reject_zero);
+
+		for (size_t index = 0; index < output_lump_count; ++index)
+		{
+			if (!output_lump(wadOut, directory, output_lump_names[index], ".lmp", dataLumps[index]))
+				exit(1);
+		}
+
+		if (nodes)
+		{
+			if (!output_lump(wadOut, directory, "SEGS",     ".lmp", dataSEGS)     ||
+			    !output_lump(wadOut, directory, "SSECTORS", ".lmp", dataSSECTORS) ||
+			    !output_lump(wadOut, directory, "NODES",    ".lmp", dataNODES))
+				exit(1);
+		}
+
+		if (reject && !output_lump(wadOut, directory, "REJECT", ".lmp", dataREJECT))
+			exit(1);
+
+		if (blockmap && !output_lump(wadOut, directory, "BLOCKMAP", ".lmp", dataBLOCKMAP))
+			exit(1);
+
+		if (format.encoder == encode_hexen)
+		{
+			// ZDoom requires a BEHAVIOR lump to signify a Hexen map.
+			// TODO: Make this an option.
+			std::string nameBEHAVIOR("BEHAVIOR");
+			if (option_use_file_extensions)
+				nameBEHAVIOR += ".o";
+
+			if (wadOut)
+			{
+				// One already in the directory is used, if there is one.
+				IO::MappedFile fileBEHAVIOR;
+				std::string    dataBEHAVIOR;
+
+				if (fileBEHAVIOR.open(directory + nameBEHAVIOR))
+					dataBEHAVIOR.assign(fileBEHAVIOR.data(), fileBEHAVIOR.size());
+
+				wad.addLump("BEHAVIOR", dataBEHAVIOR);
+			}
+			else
+			{
+				// Opened as append so as to not delete existing content, if any.
+				std::ofstream fileBEHAVIOR((directory + nameBEHAVIOR).c_str(), std::ios_base::app);
+
+				fileBEHAVIOR.close();
+			}
+		}
+	}
+	else if (format.name)
+	{
+		std::string dataTEXTMAP("/* Compiled by DH-dlc. */\n\n");
+
+		// TODO make a command for this
+		if (global_object->hasObject(name_t("namespace")))
+		{
+			obj_t namespaceObj = global_object->getObject(name_t("namespace"));
+
+			TextWriter text;
+
+			if (namespaceObj->getType() == type_t::type_string())
+				dataTEXTMAP += "namespace = "; namespaceObj->encodeUDMF(text, 1); dataTEXTMAP.append(text.data(), text.size()); dataTEXTMAP += ";\n\n";
+		}
+
+		write_output_jobs(dataTEXTMAP, jobs, format.jobsLumps, format.jobsLumpsEnd);
+
+		if (!output_lump(wadOut, directory, "TEXTMAP", ".txt", dataTEXTMAP))
+			exit(1);
+	}
+
+	if (option_output_usdf)
+	{
+		std::string dataDIALOG("/* Compiled by DH-dlc. */\n\n");
+
+		// TODO make a command for this
+		if (global_object->hasObject(name_t("namespace")))
+		{
+			obj_t namespaceObj = global_object->getObject(name_t("namespace"));
+
+			TextWriter text;
+
+			if (namespaceObj->getType() == type_t::type_string())
+				dataDIALOG += "namespace = "; namespaceObj->encodeUSDF(text, 1); dataDIALOG.append(text.data(), text.size()); dataDIALOG += ";\n\n";
+		}
+
+		write_output_jobs(dataDIALOG, jobs, jobsDIALOG, jobsDIALOGEnd);
+
+		// In a WAD, the lump has the name that ZDoom looks for.
+		if (!output_lump(wadOut, directory, wadOut ? "DIALOGUE" : "DIALOG", ".txt", dataDIALOG))
+			exit(1);
+	}
+
+	if (option_output_extradata)
+	{
+		std::string dataExtraData;
+
+		write_output_jobs(dataExtraData, jobs, format.jobsExtraData, format.jobsExtraDataEnd);
+
+		if (!output_lump(wadOut, directory, option_script_extradata, NULL, dataExtraData))
+			return 1;
+	}
+
+	FOREACH_T(scripts_data_type, it, scripts_data)
+	{
+		if (wadOut)
+		{
+			std::string dataSCRIPT(it->second);
+
+			wad.addLump(it->first, dataSCRIPT);
+
+			continue;
+		}
+
+		std::string nameSCRIPT = it->first;
+		if (option_use_file_extensions && nameSCRIPT.find('.') == std::string::npos)
+			nameSCRIPT += ".txt";
 
+		std::ofstream fileSCRIPT((directory + it->first).c_str());
+
+		if (!fileSCRIPT)
+		{
+			std::cerr << "unable to write script:\n  " << it->first << '\n';
+			continue;
+		}
+
+		fileSCRIPT << it->second;
+
+		fileSCRIPT.close();
+	}
+
+	if (wadOut)
+	{
+		std::ofstream fileWad(wadName.c_str(), std::ios_base::out | std::ios_base::binary);
+
+		if (!fileWad)
+		{
+			std::cerr << "unable to open:" << wadName << '\n';
+			return 1;
+		}
+
+		wad.write(fileWad);
+
+		fileWad.close();
+	}
+
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
 	PROCESS_OPTIONS();
 
 	if (option_arg.size() == 0)
@@ -191,6 +574,14 @@ int main(int argc, char** argv)
 		return 0;
 	}
 
+	ProfileScope::profile_enabled = option_debug_time || option_debug_time_json;
+	ProfileScope::trace_enabled   = !option_trace.empty();
+	ProfileSource::enabled        = option_profile_source;
+
+	StatsCounter::enabled = option_debug_stats || option_debug_stats_json;
+
+	ProfileScope profileOptions("options");
+
 	if (option_arg.size() == 1 && option_arg[0] == "-")
 	{
 		if (option_error_limit_default) option_error_limit = 0;
@@ -312,16 +703,12 @@ int main(int argc, char** argv)
 
 
 
-	clock_t clock_options((clock() - clock_start) - clock_total);
-	clock_total += clock_options;
-	if (option_debug_time)
-	{
-		std::cerr.precision(8);
-		std::cerr << "Toptions = " << (clock_options / double(CLOCKS_PER_SEC)) << ";\n";
-	}
+	profileOptions.stop();
 
 
 
+	ProfileScope profileCompile("compile");
+
 	if (option_lib_std)
 		process_file("lib-std.ddl");
 
@@ -354,15 +741,12 @@ int main(int argc, char** argv)
 
 
 
-	clock_t clock_compile((clock() - clock_start) - clock_total);
-	clock_total += clock_compile;
-	if (option_debug_time)
-	{
-		std::cerr.precision(8);
-		std::cerr << "Tcompile = " << (clock_compile / double(CLOCKS_PER_SEC)) << ";\n";
-	}
+	profileCompile.stop();
+
 
 
+	// Objects removed while compiling are only dropped here, once.
+	compact_objects();
 
 	if (option_debug_dump)
 	{
@@ -381,328 +765,182 @@ int main(int argc, char** argv)
 
 
 	if (!option_output_any)
-	{
-		clock_t clock_output((clock() - clock_start) - clock_total);
-		clock_total += clock_output;
+		return main_exit(0);
 
-		if (option_debug_time)
-		{
-			std::cerr.precision(8);
-			std::cerr << "Toutput  = " << (clock_output  / double(CLOCKS_PER_SEC)) << ";\n";
-			std::cerr << "Ttotal   = " << (clock_total   / double(CLOCKS_PER_SEC)) << ";\n";
-		}
+	ProfileScope profileOutput("output");
 
-		return 0;
-	}
-
-	#define OPENFILE(NAME, EXT) \
-	std::string name##NAME(#NAME); \
-	if (option_use_file_extensions) \
-		name##NAME += EXT; \
-	\
-	std::ofstream file##NAME( \
-		(option_directory + name##NAME).c_str(), \
-		std::ios_base::out | std::ios_base::binary); \
-	\
-	if (!file##NAME) \
-	{ \
-		std::cerr << "unable to open:" << name##NAME << "\n"; \
-		exit(1); \
-	}
-
-	IO::mkdir(option_directory, true);
+	/*
+		Normally, only the first format listed in usage() is output. With
+		--do-output-multi, every one selected is, each to its own
+		subdirectory or WAD.
+	*/
+	std::vector<OutputFormat> formats;
 
 	if (option_output_hexen)
+		formats.push_back(OutputFormat("hexen", encode_hexen));
+	if (option_output_strife)
+		formats.push_back(OutputFormat("strife", encode_strife));
+	if (option_output_heretic)
+		formats.push_back(OutputFormat("heretic", encode_heretic));
+	if (option_output_doom)
+		formats.push_back(OutputFormat("doom", encode_doom));
+	if (option_output_udmf)
+		formats.push_back(OutputFormat("udmf", NULL));
+
+	if (formats.empty())
+		formats.push_back(OutputFormat(NULL, NULL));
+
+	if (!option_output_multi)
+		formats.resize(1, OutputFormat(NULL, NULL));
+
+	// Everything is encoded before anything is written, and in any order.
+	// Each file's jobs are kept together. Every format is encoded from the
+	// same objects, which encoding does not change.
+	std::vector<OutputJob> jobs;
+
+	FOREACH_T(std::vector<OutputFormat>, it, formats)
 	{
-		OPENFILE(LINEDEFS, ".lmp");
-		OPENFILE(SECTORS,  ".lmp");
-		OPENFILE(SIDEDEFS, ".lmp");
-		OPENFILE(THINGS,   ".lmp");
-		OPENFILE(VERTEXES, ".lmp");
+		it->jobsLumps = jobs.size();
 
-		try
+		if (it->encoder)
 		{
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_linedef()])
-				(*it)->encodeHexen(fileLINEDEFS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sector()])
-				(*it)->encodeHexen(fileSECTORS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sidedef()])
-				(*it)->encodeHexen(fileSIDEDEFS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_thing()])
-				(*it)->encodeHexen(fileTHINGS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_vertex()])
-				(*it)->encodeHexen(fileVERTEXES);
+			jobs.push_back(OutputJob(global_object_map[type_t::type_linedef()], it->encoder));
+			jobs.push_back(OutputJob(global_object_map[type_t::type_sector()],  it->encoder));
+			jobs.push_back(OutputJob(global_object_map[type_t::type_sidedef()], it->encoder));
+			jobs.push_back(OutputJob(global_object_map[type_t::type_thing()],   it->encoder));
+			jobs.push_back(OutputJob(global_object_map[type_t::type_vertex()],  it->encoder));
 		}
-		catch (CompilerException & e)
+		else if (it->name)
 		{
-			std::cerr << e << '\n';
+			FOREACH_T(global_object_map_t, mapIt, global_object_map)
+				jobs.push_back(OutputJob(mapIt->second, encode_udmf));
 		}
 
-		fileLINEDEFS.close();
-		fileSECTORS.close();
-		fileSIDEDEFS.close();
-		fileTHINGS.close();
-		fileVERTEXES.close();
-
-		// ZDoom requires a BEHAVIOR lump to signify a Hexen map.
-		// TODO: Make this an option.
-		std::string nameBEHAVIOR("BEHAVIOR");
-		if (option_use_file_extensions)
-			nameBEHAVIOR += ".o";
-
-		// Opened as append so as to not delete existing content, if any.
-		std::ofstream fileBEHAVIOR((option_directory + nameBEHAVIOR).c_str(), std::ios_base::app);
-
-		fileBEHAVIOR.close();
+		it->jobsLumpsEnd = jobs.size();
 	}
-	else if (option_output_strife)
-	{
-		OPENFILE(LINEDEFS, ".lmp");
-		OPENFILE(SECTORS,  ".lmp");
-		OPENFILE(SIDEDEFS, ".lmp");
-		OPENFILE(THINGS,   ".lmp");
-		OPENFILE(VERTEXES, ".lmp");
-
-		try
-		{
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_linedef()])
-				(*it)->encodeStrife(fileLINEDEFS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sector()])
-				(*it)->encodeStrife(fileSECTORS);
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sidedef()])
-				(*it)->encodeStrife(fileSIDEDEFS);
+	// USDF is the same for every format.
+	size_t jobsDIALOG = jobs.size();
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_thing()])
-				(*it)->encodeStrife(fileTHINGS);
+	if (option_output_usdf)
+	{
+		FOREACH_T(global_object_map_t, mapIt, global_object_map)
+			jobs.push_back(OutputJob(mapIt->second, encode_usdf));
+	}
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_vertex()])
-				(*it)->encodeStrife(fileVERTEXES);
-		}
-		catch (CompilerException & e)
-		{
-			std::cerr << e << '\n';
-		}
+	size_t jobsDIALOGEnd = jobs.size();
 
-		fileLINEDEFS.close();
-		fileSECTORS.close();
-		fileSIDEDEFS.close();
-		fileTHINGS.close();
-		fileVERTEXES.close();
-	}
-	else if (option_output_heretic)
+	// ExtraData is only different for Doom, so it is shared otherwise.
+	if (option_output_extradata)
 	{
-		OPENFILE(LINEDEFS, ".lmp");
-		OPENFILE(SECTORS,  ".lmp");
-		OPENFILE(SIDEDEFS, ".lmp");
-		OPENFILE(THINGS,   ".lmp");
-		OPENFILE(VERTEXES, ".lmp");
-
-		try
+		for (size_t index = 0; index < formats.size(); ++index)
 		{
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_linedef()])
-				(*it)->encodeHeretic(fileLINEDEFS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sector()])
-				(*it)->encodeHeretic(fileSECTORS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sidedef()])
-				(*it)->encodeHeretic(fileSIDEDEFS);
+			bool doom = formats[index].encoder == encode_doom;
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_thing()])
-				(*it)->encodeHeretic(fileTHINGS);
-
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_vertex()])
-				(*it)->encodeHeretic(fileVERTEXES);
-		}
-		catch (CompilerException & e)
-		{
-			std::cerr << e << '\n';
-		}
+			size_t other = 0;
 
-		fileLINEDEFS.close();
-		fileSECTORS.close();
-		fileSIDEDEFS.close();
-		fileTHINGS.close();
-		fileVERTEXES.close();
-	}
-	else if (option_output_doom)
-	{
-		OPENFILE(LINEDEFS, ".lmp");
-		OPENFILE(SECTORS,  ".lmp");
-		OPENFILE(SIDEDEFS, ".lmp");
-		OPENFILE(THINGS,   ".lmp");
-		OPENFILE(VERTEXES, ".lmp");
+			while (other < index && (formats[other].encoder == encode_doom) != doom)
+				++other;
 
-		try
-		{
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_linedef()])
-				(*it)->encodeDoom(fileLINEDEFS);
+			if (other < index)
+			{
+				formats[index].jobsExtraData    = formats[other].jobsExtraData;
+				formats[index].jobsExtraDataEnd = formats[other].jobsExtraDataEnd;
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sector()])
-				(*it)->encodeDoom(fileSECTORS);
+				continue;
+			}
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_sidedef()])
-				(*it)->encodeDoom(fileSIDEDEFS);
+			formats[index].jobsExtraData = jobs.size();
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_thing()])
-				(*it)->encodeDoom(fileTHINGS);
+			FOREACH_T(global_object_map_t, mapIt, global_object_map)
+				jobs.push_back(OutputJob(mapIt->second, doom ? encode_extradata_doom : encode_extradata));
 
-			FOREACH_T(global_object_list_t, it, global_object_map[type_t::type_vertex()])
-				(*it)->encodeDoom(fileVERTEXES);
-		}
-		catch (CompilerException & e)
-		{
-			std::cerr << e << '\n';
+			formats[index].jobsExtraDataEnd = jobs.size();
 		}
-
-		fileLINEDEFS.close();
-		fileSECTORS.close();
-		fileSIDEDEFS.close();
-		fileTHINGS.close();
-		fileVERTEXES.close();
 	}
-	else if (option_output_udmf)
-	{
-		OPENFILE(TEXTMAP, ".txt");
 
-		fileTEXTMAP << "/* Compiled by DH-dlc. */\n\n";
+	// The built lumps are the same for every binary format, and are built
+	// before the output jobs run, which must have the objects to themselves.
+	NodeBuilder     nodes;
+	BlockmapBuilder blockmap;
+	RejectBuilder   reject;
+	OutputBuilders  builders;
 
-		// TODO make a command for this
-		if (global_object->hasObject(name_t("namespace")))
-		{
-			obj_t namespaceObj = global_object->getObject(name_t("namespace"));
+	bool binary = false;
 
-			if (namespaceObj->getType() == type_t::type_string())
-				fileTEXTMAP << "namespace = "; namespaceObj->encodeUDMF(fileTEXTMAP, 1); fileTEXTMAP << ";\n\n";
-		}
+	FOREACH_T(std::vector<OutputFormat>, it, formats)
+		binary = binary || it->encoder;
 
-		try
-		{
-			FOREACH_T(global_object_map_t, mapIt, global_object_map)
-			{
-				FOREACH_T(global_object_list_t, listIt, mapIt->second)
-					(*listIt)->encodeUDMF(fileTEXTMAP);
-			}
-		}
-		catch (CompilerException & e)
-		{
-			std::cerr << e << '\n';
-		}
-
-		fileTEXTMAP.close();
-	}
-
-	if (option_output_usdf)
+	if (binary) try
 	{
-		OPENFILE(DIALOG, ".txt");
-
-		fileDIALOG << "/* Compiled by DH-dlc. */\n\n";
-
-		// TODO make a command for this
-		if (global_object->hasObject(name_t("namespace")))
+		if (option_nodes)
 		{
-			obj_t namespaceObj = global_object->getObject(name_t("namespace"));
+			ProfileScope profile("nodes");
 
-			if (namespaceObj->getType() == type_t::type_string())
-				fileDIALOG << "namespace = "; namespaceObj->encodeUSDF(fileDIALOG, 1); fileDIALOG << ";\n\n";
+			nodes.build();
+			builders.nodes = &nodes;
 		}
 
-		try
+		if (option_blockmap)
 		{
-			FOREACH_T(global_object_map_t, mapIt, global_object_map)
-			{
-				FOREACH_T(global_object_list_t, listIt, mapIt->second)
-					(*listIt)->encodeUSDF(fileDIALOG);
-			}
+			ProfileScope profile("blockmap");
+
+			blockmap.build();
+			builders.blockmap = &blockmap;
 		}
-		catch (CompilerException & e)
+
+		if (option_reject || option_reject_zero)
 		{
-			std::cerr << e << '\n';
-		}
+			ProfileScope profile("reject");
 
-		fileDIALOG.close();
+			reject.build();
+			builders.reject = &reject;
+		}
+	}
+	catch (CompilerException & e)
+	{
+		std::cerr << e << '\n';
 	}
 
-	#undef OPENFILE
+	run_output_jobs(jobs);
 
-	if (option_output_extradata)
+	FOREACH_T(std::vector<OutputFormat>, it, formats)
 	{
-		std::string nameExtraData(option_script_extradata);
-
-		std::ofstream fileExtraData((option_directory + nameExtraData).c_str());
+		std::string directory(option_directory);
+		std::string wadName(option_wad);
 
-		if (!fileExtraData)
+		// MAP01/hexen/ and maps.hexen.wad, for instance.
+		if (option_output_multi && it->name)
 		{
-			std::cerr << "unable to open:" << nameExtraData << '\n';
-			return 1;
-		}
+			directory += it->name;
+			directory += PATHSEP;
 
-		FOREACH_T(global_object_map_t, mapIt, global_object_map)
-		{
-			FOREACH_T(global_object_list_t, listIt, mapIt->second)
+			if (!wadName.empty())
 			{
-				obj_t thisObj(*listIt);
-
-				try
-				{
-					thisObj->encodeExtraData(fileExtraData);
-				}
-				catch (CompilerException& e)
-				{
-					std::cerr << thisObj->getType().makeString() << ':' << get_object_index(thisObj) << ':' << e << '\n';
-				}
-			}
-		}
-
-		fileExtraData.close();
-	}
-
-	FOREACH_T(scripts_data_type, it, scripts_data)
-	{
-		std::string nameSCRIPT = it->first;
-		if (option_use_file_extensions && nameSCRIPT.find('.') == std::string::npos)
-			nameSCRIPT += ".txt";
+				size_t ext = wadName.find_last_of('.');
 
-		std::ofstream fileSCRIPT((option_directory + it->first).c_str());
+				if (ext == std::string::npos || wadName.find(PATHSEP, ext) != std::string::npos)
+					ext = wadName.size();
 
-		if (!fileSCRIPT)
-		{
-			std::cerr << "unable to write script:\n  " << it->first << '\n';
-			continue;
+				wadName.insert(ext, std::string(".") + it->name);
+			}
 		}
 
-		fileSCRIPT << it->second;
-
-		fileSCRIPT.close();
-	}
-
+		ProfileScope profile("write", it->name ? it->name : "");
 
+		int result = output_format(*it, directory, wadName, jobs, jobsDIALOG, jobsDIALOGEnd, builders);
 
-	clock_t clock_output((clock() - clock_start) - clock_total);
-	clock_total += clock_output;
-	if (option_debug_time)
-	{
-		std::cerr.precision(8);
-		std::cerr << "Toutput  = " << (clock_output  / double(CLOCKS_PER_SEC)) << ";\n";
+		if (result)
+			return result;
 	}
 
 
 
-	if (option_debug_time)
-	{
-		std::cerr.precision(8);
-		std::cerr << "Ttotal   = " << (clock_total   / double(CLOCKS_PER_SEC)) << ";\n";
-	}
+	profileOutput.stop();
 
 
 
-	return 0;
+	return main_exit(0);
 }
 
 
@@ -155,7 +155,7 @@ template<> real_t random<real_t>(real_t const & min, real_t const & max)
 template<> real_l_t random<real_l_t>()
 {
 	#if USE_GMPLIB
-	return real_l_t(random_source.get_f(option_precision));
+	return real_l_t(mpq_class(mpf_class(random_source.get_f(option_precision))));
 	#else
 	return real_l_t(rand()) / real_l_t(RAND_MAX);
 	#endif
@@ -181,7 +181,7 @@ template<> int_s_t random<int_s_t>(int_s_t const & min, int_s_t const & max)
 template<> int_t random<int_t>(int_t const & max)
 {
 	#if USE_GMPLIB
-	return int_t(random_source.get_z_range(max._data + 1));
+	return int_t(int_gmp_t(mpz_class(random_source.get_z_range(max._data.get_mpz() + 1))));
 	#else
 	return random__int<int_t>(max);
 	#endif
@@ -194,7 +194,7 @@ template<> int_t random<int_t>(int_t const & min, int_t const & max)
 template<> int_l_t random<int_l_t>(int_l_t const & max)
 {
 	#if USE_GMPLIB
-	return int_l_t(random_source.get_z_range(max._data + 1));
+	return int_l_t(int_gmp_t(mpz_class(random_source.get_z_range(max._data.get_mpz() + 1))));
 	#else
 	return random__int<int_l_t>(max);
 	#endif
@@ -21,6 +21,17 @@
 	2010/02/03 - Update for new process_options.h.
 	2010/02/06 - Added --debug-token option for debugging.
 	2010/06/24 - Added option_lib_udmf_strict.
+	2026/10/17 - Added --debug-arena and --fast-exit.
+	2026/10/17 - Added --jobs.
+	2026/10/17 - Added --compact-text.
+	2026/10/17 - Added --wad.
+	2026/10/17 - Added --output-multi.
+	2026/10/17 - Added --nodes and --nodes-extended.
+	2026/10/17 - Added --blockmap, --reject, and --reject-zero.
+	2026/10/17 - Added --debug-time-json.
+	2026/10/17 - Added --trace.
+	2026/10/17 - Added --profile-source and --profile-source-top.
+	2026/10/17 - Added --debug-stats and --debug-stats-json.
 */
 
 #define PROCESS_OPTION_USER_ERROR usage(); exit(2);
@@ -40,14 +51,25 @@
 
 
 PROCESS_OPTION_DEFINE_bool(debug,       false)
+PROCESS_OPTION_DEFINE_bool(debug_arena, false)
 PROCESS_OPTION_DEFINE_bool(debug_dump,  false)
 PROCESS_OPTION_DEFINE_bool(debug_seed,  false)
+PROCESS_OPTION_DEFINE_bool(debug_stats, false)
 PROCESS_OPTION_DEFINE_bool(debug_time,  false)
 PROCESS_OPTION_DEFINE_bool(debug_token, false)
 
+PROCESS_OPTION_DEFINE_bool(debug_stats_json, false)
+PROCESS_OPTION_DEFINE_bool(debug_time_json,  false)
+
+PROCESS_OPTION_DEFINE_bool(fast_exit, true)
+
+PROCESS_OPTION_DEFINE_bool(blockmap, false)
+
 PROCESS_OPTION_DEFINE_bool(case_sensitive, true)
 PROCESS_OPTION_DEFINE_bool(case_upper,     false)
 
+PROCESS_OPTION_DEFINE_bool(compact_text, false)
+
 PROCESS_OPTION_DEFINE_bool(force_default_types, false)
 
 PROCESS_OPTION_DEFINE_bool(lib_std,         true)
@@ -56,21 +78,33 @@ PROCESS_OPTION_DEFINE_bool(lib_udmf_strict, false)
 PROCESS_OPTION_DEFINE_bool(lib_usdf,        false)
 PROCESS_OPTION_DEFINE_bool(lib_usdf_strict, false)
 
+PROCESS_OPTION_DEFINE_bool(nodes,          false)
+PROCESS_OPTION_DEFINE_bool(nodes_extended, false)
+
 PROCESS_OPTION_DEFINE_bool(output_any,       true)
 PROCESS_OPTION_DEFINE_bool(output_doom,      false)
 PROCESS_OPTION_DEFINE_bool(output_extradata, false)
 PROCESS_OPTION_DEFINE_bool(output_heretic,   false)
 PROCESS_OPTION_DEFINE_bool(output_hexen,     false)
+PROCESS_OPTION_DEFINE_bool(output_multi,     false)
 PROCESS_OPTION_DEFINE_bool(output_strife,    false)
 PROCESS_OPTION_DEFINE_bool(output_udmf,      true)
 PROCESS_OPTION_DEFINE_bool(output_usdf,      false)
 
+PROCESS_OPTION_DEFINE_bool(profile_source, false)
+
+PROCESS_OPTION_DEFINE_bool(reject,      false)
+PROCESS_OPTION_DEFINE_bool(reject_zero, false)
+
 PROCESS_OPTION_DEFINE_bool(strict_strings, true)
 PROCESS_OPTION_DEFINE_bool(strict_types,   false)
 
 PROCESS_OPTION_DEFINE_bool(use_file_extensions, false)
 
 PROCESS_OPTION_DEFINE_int(error_limit, 1)
+PROCESS_OPTION_DEFINE_int(jobs,        0)
+
+PROCESS_OPTION_DEFINE_int(profile_source_top, 25)
 PROCESS_OPTION_DECLARE_int(precision, 128)
 {
 	option_precision_default = false;
@@ -86,6 +120,8 @@ PROCESS_OPTION_DEFINE_string(directory,        "")
 PROCESS_OPTION_DEFINE_string(map_name,         "")
 PROCESS_OPTION_DEFINE_string(script_acs,       "SCRIPTS")
 PROCESS_OPTION_DEFINE_string(script_extradata, "EXTRADAT")
+PROCESS_OPTION_DEFINE_string(trace,            "")
+PROCESS_OPTION_DEFINE_string(wad,              "")
 
 PROCESS_OPTION_DEFINE_string_multi(include)
 
@@ -112,14 +148,25 @@ PROCESS_OPTION_LONG_DECLARE
 	}
 
 	PROCESS_OPTION_HANDLE_LONG_bool(debug,       "debug",        6);
+	PROCESS_OPTION_HANDLE_LONG_bool(debug_arena, "debug-arena", 12);
 	PROCESS_OPTION_HANDLE_LONG_bool(debug_dump,  "debug-dump",  11);
 	PROCESS_OPTION_HANDLE_LONG_bool(debug_seed,  "debug-seed",  11);
+	PROCESS_OPTION_HANDLE_LONG_bool(debug_stats, "debug-stats", 12);
 	PROCESS_OPTION_HANDLE_LONG_bool(debug_time,  "debug-time",  11);
 	PROCESS_OPTION_HANDLE_LONG_bool(debug_token, "debug-token", 12);
 
+	PROCESS_OPTION_HANDLE_LONG_bool(debug_stats_json, "debug-stats-json", 17);
+	PROCESS_OPTION_HANDLE_LONG_bool(debug_time_json,  "debug-time-json",  16);
+
+	PROCESS_OPTION_HANDLE_LONG_bool(fast_exit, "fast-exit", 10);
+
+	PROCESS_OPTION_HANDLE_LONG_bool(blockmap, "blockmap", 9);
+
 	PROCESS_OPTION_HANDLE_LONG_bool(case_sensitive, "case-sensitive", 15);
 	PROCESS_OPTION_HANDLE_LONG_bool(case_upper,     "case-upper",     11);
 
+	PROCESS_OPTION_HANDLE_LONG_bool(compact_text, "compact-text", 13);
+
 	PROCESS_OPTION_HANDLE_LONG_bool(force_default_types, "force-default-types", 20);
 
 	PROCESS_OPTION_HANDLE_LONG_bool(lib_std,         "lib-std",          8);
@@ -128,28 +175,42 @@ PROCESS_OPTION_LONG_DECLARE
 	PROCESS_OPTION_HANDLE_LONG_bool(lib_usdf,        "lib-usdf",         9);
 	PROCESS_OPTION_HANDLE_LONG_bool(lib_usdf_strict, "lib-usdf-strict", 16);
 
+	PROCESS_OPTION_HANDLE_LONG_bool(nodes,          "nodes",           6);
+	PROCESS_OPTION_HANDLE_LONG_bool(nodes_extended, "nodes-extended", 15);
+
 	PROCESS_OPTION_HANDLE_LONG_bool(output_any,       "output-any",       11);
 	PROCESS_OPTION_HANDLE_LONG_bool(output_doom,      "output-doom",      12);
 	PROCESS_OPTION_HANDLE_LONG_bool(output_extradata, "output-extradata", 17);
 	PROCESS_OPTION_HANDLE_LONG_bool(output_heretic,   "output-heretic",   15);
 	PROCESS_OPTION_HANDLE_LONG_bool(output_hexen,     "output-hexen",     13);
+	PROCESS_OPTION_HANDLE_LONG_bool(output_multi,     "output-multi",     13);
 	PROCESS_OPTION_HANDLE_LONG_bool(output_strife,    "output-strife",    14);
 	PROCESS_OPTION_HANDLE_LONG_bool(output_udmf,      "output-udmf",      12);
 	PROCESS_OPTION_HANDLE_LONG_bool(output_usdf,      "output-usdf",      12);
 
+	PROCESS_OPTION_HANDLE_LONG_bool(profile_source, "profile-source", 15);
+
+	PROCESS_OPTION_HANDLE_LONG_bool(reject,      "reject",       7);
+	PROCESS_OPTION_HANDLE_LONG_bool(reject_zero, "reject-zero", 12);
+
 	PROCESS_OPTION_HANDLE_LONG_bool(strict_strings, "strict-strings", 15);
 	PROCESS_OPTION_HANDLE_LONG_bool(strict_types,   "strict-types",   13);
 
 	PROCESS_OPTION_HANDLE_LONG_bool(use_file_extensions, "extensions", 3);
 
 	PROCESS_OPTION_HANDLE_LONG_int(error_limit, "error-limit", 12);
+	PROCESS_OPTION_HANDLE_LONG_int(jobs,        "jobs",         5);
 	PROCESS_OPTION_HANDLE_LONG_int(precision,   "precision",    4);
 	PROCESS_OPTION_HANDLE_LONG_int(seed,        "seed",         5);
 
+	PROCESS_OPTION_HANDLE_LONG_int(profile_source_top, "profile-source-top", 19);
+
 	PROCESS_OPTION_HANDLE_LONG_string(directory,        "directory",         3);
 	PROCESS_OPTION_HANDLE_LONG_string(map_name,         "map-name",          3);
 	PROCESS_OPTION_HANDLE_LONG_string(script_acs,       "script-acs",       11);
 	PROCESS_OPTION_HANDLE_LONG_string(script_extradata, "script-extradata", 17);
+	PROCESS_OPTION_HANDLE_LONG_string(trace,            "trace",             6);
+	PROCESS_OPTION_HANDLE_LONG_string(wad,              "wad",               4);
 
 	PROCESS_OPTION_HANDLE_LONG_string_multi(include, "include", 3);
 
@@ -167,6 +228,7 @@ PROCESS_OPTION_SHORT_DECLARE
 	PROCESS_OPTION_HANDLE_SHORT_bool(case_sensitive, 'c');
 
 	PROCESS_OPTION_HANDLE_SHORT_int(error_limit, 'e');
+	PROCESS_OPTION_HANDLE_SHORT_int(jobs,        'j');
 	PROCESS_OPTION_HANDLE_SHORT_int(precision,   'p');
 
 	PROCESS_OPTION_HANDLE_SHORT_string(directory, 'd');
@@ -26,6 +26,17 @@
 		command_name_for(), and command_name_do().
 	2010/06/24 - Added several type_*().
 	2010/06/24 - Added option_lib_udmf_strict.
+	2026/10/17 - Added option_debug_arena and option_fast_exit.
+	2026/10/17 - Added option_jobs.
+	2026/10/17 - Added option_compact_text.
+	2026/10/17 - Added option_wad.
+	2026/10/17 - Added option_output_multi.
+	2026/10/17 - Added option_nodes and option_nodes_extended.
+	2026/10/17 - Added option_blockmap, option_reject, and option_reject_zero.
+	2026/10/17 - Added option_debug_time_json.
+	2026/10/17 - Added option_trace.
+	2026/10/17 - Added option_profile_source and option_profile_source_top.
+	2026/10/17 - Added option_debug_stats and option_debug_stats_json.
 */
 
 #ifndef OPTIONS_H
@@ -36,14 +47,25 @@
 
 
 PROCESS_OPTION_EXTERN_bool(debug);
+PROCESS_OPTION_EXTERN_bool(debug_arena);
 PROCESS_OPTION_EXTERN_bool(debug_dump);
 PROCESS_OPTION_EXTERN_bool(debug_seed);
+PROCESS_OPTION_EXTERN_bool(debug_stats);
 PROCESS_OPTION_EXTERN_bool(debug_time);
 PROCESS_OPTION_EXTERN_bool(debug_token);
 
+PROCESS_OPTION_EXTERN_bool(debug_stats_json);
+PROCESS_OPTION_EXTERN_bool(debug_time_json);
+
+PROCESS_OPTION_EXTERN_bool(fast_exit);
+
+PROCESS_OPTION_EXTERN_bool(blockmap);
+
 PROCESS_OPTION_EXTERN_bool(case_sensitive);
 PROCESS_OPTION_EXTERN_bool(case_upper);
 
+PROCESS_OPTION_EXTERN_bool(compact_text);
+
 PROCESS_OPTION_EXTERN_bool(force_default_types);
 
 PROCESS_OPTION_EXTERN_bool(lib_std);
@@ -52,28 +74,42 @@ PROCESS_OPTION_EXTERN_bool(lib_udmf_strict);
 PROCESS_OPTION_EXTERN_bool(lib_usdf);
 PROCESS_OPTION_EXTERN_bool(lib_usdf_strict);
 
+PROCESS_OPTION_EXTERN_bool(nodes);
+PROCESS_OPTION_EXTERN_bool(nodes_extended);
+
 PROCESS_OPTION_EXTERN_bool(output_any);
 PROCESS_OPTION_EXTERN_bool(output_doom);
 PROCESS_OPTION_EXTERN_bool(output_extradata);
 PROCESS_OPTION_EXTERN_bool(output_heretic);
 PROCESS_OPTION_EXTERN_bool(output_hexen);
+PROCESS_OPTION_EXTERN_bool(output_multi);
 PROCESS_OPTION_EXTERN_bool(output_strife);
 PROCESS_OPTION_EXTERN_bool(output_udmf);
 PROCESS_OPTION_EXTERN_bool(output_usdf);
 
+PROCESS_OPTION_EXTERN_bool(profile_source);
+
+PROCESS_OPTION_EXTERN_bool(reject);
+PROCESS_OPTION_EXTERN_bool(reject_zero);
+
 PROCESS_OPTION_EXTERN_bool(strict_strings);
 PROCESS_OPTION_EXTERN_bool(strict_types);
 
 PROCESS_OPTION_EXTERN_bool(use_file_extensions);
 
 PROCESS_OPTION_EXTERN_int(error_limit);
+PROCESS_OPTION_EXTERN_int(jobs);
 PROCESS_OPTION_EXTERN_int(precision);
 PROCESS_OPTION_EXTERN_int(seed);
 
+PROCESS_OPTION_EXTERN_int(profile_source_top);
+
 PROCESS_OPTION_EXTERN_string(directory);
 PROCESS_OPTION_EXTERN_string(map_name);
 PROCESS_OPTION_EXTERN_string(script_acs);
 PROCESS_OPTION_EXTERN_string(script_extradata);
+PROCESS_OPTION_EXTERN_string(trace);
+PROCESS_OPTION_EXTERN_string(wad);
 
 PROCESS_OPTION_EXTERN_string_multi(include);
 
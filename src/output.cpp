@@ -0,0 +1,246 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+	2026/10/17 - Jobs encode into a TextWriter.
+	2026/10/17 - Jobs can be written to a string, for --wad.
+	2026/10/17 - Jobs are timed for --debug-time.
+*/
+
+#include "output.hpp"
+
+#include "options.hpp"
+#include "profile.hpp"
+#include "TextWriter.hpp"
+
+#include "exceptions/CompilerException.hpp"
+
+#include "LevelObject/LevelObject.hpp"
+
+#include "../common/foreach.hpp"
+
+#include <iostream>
+#include <sstream>
+
+#if USE_THREADS
+#include <atomic>
+#include <thread>
+#endif
+
+
+
+OutputJob::OutputJob(global_object_list_t const & objects, encoder_t encoder) : _objects(&objects), _encoder(encoder), _out(), _err(), _failed(false)
+{
+
+}
+
+// For the profile.
+static char const * output_encoder_name(OutputJob::encoder_t encoder)
+{
+	if (encoder == encode_doom)           return "doom";
+	if (encoder == encode_heretic)        return "heretic";
+	if (encoder == encode_hexen)          return "hexen";
+	if (encoder == encode_strife)         return "strife";
+	if (encoder == encode_udmf)           return "udmf";
+	if (encoder == encode_usdf)           return "usdf";
+	if (encoder == encode_extradata)      return "extradata";
+	if (encoder == encode_extradata_doom) return "extradata_doom";
+
+	return "";
+}
+
+
+
+void OutputJob::run()
+{
+	ProfileScope profile("encode", output_encoder_name(_encoder));
+
+	TextWriter         out;
+	std::ostringstream err;
+
+	try
+	{
+		FOREACH_T_CONST(global_object_list_t, it, *_objects)
+			_encoder(**it, out, err);
+	}
+	catch (CompilerException & e)
+	{
+		err << e << '\n';
+		_failed = true;
+	}
+	#if USE_THREADS
+	catch (...)
+	{
+		// Anything else is passed on by write(), on the main thread.
+		_exception = std::current_exception();
+		_failed = true;
+	}
+	#endif
+
+	out.swap(_out);
+	_err = err.str();
+}
+
+bool OutputJob::write(std::ostream & out) const
+{
+	#if USE_THREADS
+	if (_exception) std::rethrow_exception(_exception);
+	#endif
+
+	out.write(_out.data(), _out.size());
+
+	std::cerr << _err;
+
+	return !_failed;
+}
+bool OutputJob::write(std::string & out) const
+{
+	#if USE_THREADS
+	if (_exception) std::rethrow_exception(_exception);
+	#endif
+
+	out += _out;
+
+	std::cerr << _err;
+
+	return !_failed;
+}
+
+
+
+void encode_doom(LevelObject & object, TextWriter & out, std::ostream &)
+{
+	object.encodeDoom(out.stream());
+}
+
+void encode_heretic(LevelObject & object, TextWriter & out, std::ostream &)
+{
+	object.encodeHeretic(out.stream());
+}
+
+void encode_hexen(LevelObject & object, TextWriter & out, std::ostream &)
+{
+	object.encodeHexen(out.stream());
+}
+
+void encode_strife(LevelObject & object, TextWriter & out, std::ostream &)
+{
+	object.encodeStrife(out.stream());
+}
+
+void encode_udmf(LevelObject & object, TextWriter & out, std::ostream &)
+{
+	object.encodeUDMF(out);
+}
+
+void encode_usdf(LevelObject & object, TextWriter & out, std::ostream &)
+{
+	object.encodeUSDF(out);
+}
+
+static void encode_extradata(LevelObject & object, TextWriter & out, std::ostream & err, bool doom)
+{
+	try
+	{
+		object.encodeExtraData(out.stream(), doom);
+	}
+	catch (CompilerException & e)
+	{
+		err << object.getType().makeString() << ':' << get_object_index(&object) << ':' << e << '\n';
+	}
+}
+
+void encode_extradata(LevelObject & object, TextWriter & out, std::ostream & err)
+{
+	encode_extradata(object, out, err, false);
+}
+
+void encode_extradata_doom(LevelObject & object, TextWriter & out, std::ostream & err)
+{
+	encode_extradata(object, out, err, true);
+}
+
+
+
+#if USE_THREADS
+static void run_output_worker(std::vector<OutputJob> * jobs, std::atomic<size_t> * next, ProfileNode * profile)
+{
+	profile_set_current(profile);
+
+	for (size_t index; (index = (*next)++) < jobs->size();)
+		(*jobs)[index].run();
+}
+#endif
+
+void run_output_jobs(std::vector<OutputJob> & jobs)
+{
+	#if USE_THREADS
+	size_t count = option_jobs > 0 ? option_jobs : std::thread::hardware_concurrency();
+
+	if (count > jobs.size())
+		count = jobs.size();
+
+	if (count > 1)
+	{
+		std::atomic<size_t> next(0);
+		std::vector<std::thread> threads;
+
+		LevelObjectPointer::setShared(true);
+		profile_set_shared(true);
+
+		// This thread is one of the workers.
+		for (size_t index = 1; index < count; ++index)
+			threads.push_back(std::thread(run_output_worker, &jobs, &next, profile_get_current()));
+
+		run_output_worker(&jobs, &next, profile_get_current());
+
+		FOREACH_T(std::vector<std::thread>, it, threads)
+			it->join();
+
+		profile_set_shared(false);
+		LevelObjectPointer::setShared(false);
+
+		return;
+	}
+	#endif
+
+	FOREACH_T(std::vector<OutputJob>, it, jobs)
+		it->run();
+}
+
+void write_output_jobs(std::ostream & out, std::vector<OutputJob> const & jobs, size_t begin, size_t end)
+{
+	for (size_t index = begin; index < end; ++index)
+	{
+		if (!jobs[index].write(out))
+			break;
+	}
+}
+void write_output_jobs(std::string & out, std::vector<OutputJob> const & jobs, size_t begin, size_t end)
+{
+	for (size_t index = begin; index < end; ++index)
+	{
+		if (!jobs[index].write(out))
+			break;
+	}
+}
+
+
+
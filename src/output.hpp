@@ -0,0 +1,121 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Encoding of the output. Each lump, TEXTMAP section and so on is encoded
+	into its own buffer by an OutputJob. Encoding does not change any
+	object, so the jobs can all be run at once. Afterwards, the buffers are
+	written out in the order they would have been encoded in, which gives
+	the same output as encoding them one after another.
+
+	2026/10/17 - Original version.
+	2026/10/17 - Jobs encode into a TextWriter.
+	2026/10/17 - Jobs can be written to a string, for --wad.
+*/
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include "global_object.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+class TextWriter;
+
+#if USE_THREADS
+#include <exception>
+#endif
+
+
+
+class OutputJob
+{
+	public:
+		/*
+			Encodes one object to out. Errors that should not stop the job
+			can be written to err instead of being thrown.
+
+			The binary formats use out.stream().
+		*/
+		typedef void (*encoder_t)(LevelObject &, TextWriter & out, std::ostream & err);
+
+		OutputJob(global_object_list_t const & objects, encoder_t encoder);
+
+		/*
+			Encodes every object. A CompilerException stops the job, and is
+			kept for write() to print.
+		*/
+		void run();
+
+		/*
+			Writes what was encoded to out, and any errors to std::cerr.
+
+			Returns false if the job was stopped by an error.
+		*/
+		bool write(std::ostream & out) const;
+		bool write(std::string  & out) const;
+
+	private:
+		global_object_list_t const * _objects;
+		encoder_t _encoder;
+
+		std::string _out;
+		std::string _err;
+
+		bool _failed;
+
+		#if USE_THREADS
+		std::exception_ptr _exception;
+		#endif
+};
+
+void encode_doom     (LevelObject &, TextWriter &, std::ostream &);
+void encode_heretic  (LevelObject &, TextWriter &, std::ostream &);
+void encode_hexen    (LevelObject &, TextWriter &, std::ostream &);
+void encode_strife   (LevelObject &, TextWriter &, std::ostream &);
+void encode_udmf     (LevelObject &, TextWriter &, std::ostream &);
+void encode_usdf     (LevelObject &, TextWriter &, std::ostream &);
+
+/*
+	These two write errors to err, prefixed with the object's type and
+	index. encode_extradata_doom is for when the lumps are in Doom format.
+*/
+void encode_extradata     (LevelObject &, TextWriter &, std::ostream &);
+void encode_extradata_doom(LevelObject &, TextWriter &, std::ostream &);
+
+/*
+	Runs every job, on as many threads as --jobs allows.
+*/
+void run_output_jobs(std::vector<OutputJob> & jobs);
+
+/*
+	Writes jobs [begin, end) to out, in order. Stops after the first one that
+	was stopped by an error.
+*/
+void write_output_jobs(std::ostream & out, std::vector<OutputJob> const & jobs, size_t begin, size_t end);
+void write_output_jobs(std::string  & out, std::vector<OutputJob> const & jobs, size_t begin, size_t end);
+
+
+
+#endif /* OUTPUT_H */
+
+
+
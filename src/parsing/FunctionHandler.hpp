@@ -18,7 +18,7 @@
 */
 
 /*
-
+	2026/10/17 - Added getKind().
 */
 
 #ifndef HPP_FunctionHandler__PARSING_
@@ -39,6 +39,9 @@ class FunctionHandler
 		virtual T operator () (SourceScannerDHLX & sc) const = 0;
 		virtual T operator () (std::vector<std::string> const & args) const = 0;
 
+		// The kind of profile scope that calls of it are timed in.
+		virtual char const * getKind() const {return "function";}
+
 		static FunctionHandler<T> const * add_function(std::string const & name, FunctionHandler<T> const * func);
 		static FunctionHandler<T> const & get_function(std::string const & name);
 		static bool                       has_function(std::string const & name);
@@ -39,7 +39,7 @@
 
 
 template<typename T>
-FunctionHandlerDDL<T>::FunctionHandlerDDL() : _argt(), _data()
+FunctionHandlerDDL<T>::FunctionHandlerDDL() : _argt(), _data("")
 {
 
 }
@@ -26,6 +26,7 @@
 
 #include "FunctionHandler.hpp"
 
+#include "../CodeDDL.hpp"
 #include "../types.hpp"
 
 #include "../LevelObject/LevelObjectType.hpp"
@@ -46,7 +47,7 @@ class FunctionHandlerDDL : public FunctionHandler<T>
 
 	private:
 		std::vector<type_t> _argt;
-		std::string _data;
+		CodeDDL _data;
 };
 
 
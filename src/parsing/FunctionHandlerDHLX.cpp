@@ -25,6 +25,7 @@
 
 #include "parsing.hpp"
 
+#include "../CodeDHLX.hpp"
 #include "../options.hpp"
 
 #include "../exceptions/UnknownFunctionException.hpp"
@@ -39,23 +40,24 @@
 
 
 template<typename T>
-FunctionHandlerDHLX<T>::FunctionHandlerDHLX() : _argt(), _data()
+FunctionHandlerDHLX<T>::FunctionHandlerDHLX() : _argt(), _code(new CodeDHLX(SourceScannerDHLX()))
 {
 
 }
 template<typename T>
-FunctionHandlerDHLX<T>::FunctionHandlerDHLX(SourceScannerDHLX & sc) : _argt(), _data(sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C))
+FunctionHandlerDHLX<T>::FunctionHandlerDHLX(SourceScannerDHLX & sc) : _argt(), _code(new CodeDHLX(sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C)))
 {
 
 }
 template<typename T>
-FunctionHandlerDHLX<T>::FunctionHandlerDHLX(SourceScannerDHLX & sc, std::vector<type_t> const & argt) : _argt(argt), _data(sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C))
+FunctionHandlerDHLX<T>::FunctionHandlerDHLX(SourceScannerDHLX & sc, std::vector<type_t> const & argt) : _argt(argt), _code(new CodeDHLX(sc.getblock(SourceTokenDHLX::TT_OP_BRACE_O, SourceTokenDHLX::TT_OP_BRACE_C)))
 {
 
 }
 template<typename T>
 FunctionHandlerDHLX<T>::~FunctionHandlerDHLX()
 {
+	delete _code;
 
 }
 
@@ -106,8 +108,7 @@ T FunctionHandlerDHLX<T>::operator () (SourceScannerDHLX & sc) const
 	obj_t argcObj = LevelObject::create(type_t::type_shortint(), argc);
 	funcObj->addObject(name_t(key_name_argc()), argcObj);
 
-	SourceScannerDHLX data(_data);
-	funcObj->addData(data);
+	funcObj->addData(*_code);
 
 	obj_t returnValue = funcObj->getObject(name_t::name_return_value);
 	return convert<T, obj_t>(returnValue);
@@ -30,6 +30,7 @@
 
 #include "../LevelObject/LevelObjectType.hpp"
 
+class CodeDHLX;
 
 
 template<typename T>
@@ -45,8 +46,12 @@ class FunctionHandlerDHLX : public FunctionHandler<T>
 		virtual T operator () (std::vector<std::string> const & args) const;
 
 	private:
+		FunctionHandlerDHLX(FunctionHandlerDHLX<T> const &);
+
+		FunctionHandlerDHLX<T> & operator = (FunctionHandlerDHLX<T> const &);
+
 		std::vector<type_t> _argt;
-		SourceScannerDHLX _data;
+		CodeDHLX * _code;
 };
 
 
@@ -18,7 +18,7 @@
 */
 
 /*
-
+	2026/10/17 - Native functions are their own kind of profile scope.
 */
 
 #ifndef HPP_FunctionHandlerNative__PARSING_
@@ -48,6 +48,8 @@ class FunctionHandlerNative : public FunctionHandler<T>
 		virtual T operator () (SourceScannerDHLX & sc) const;
 		virtual T operator () (std::vector<std::string> const & args) const;
 
+		virtual char const * getKind() const {return "native";}
+
 	private:
 		funcDDL_t  _funcDDL;
 		funcDHLX_t _funcDHLX;
@@ -24,6 +24,12 @@
 		still be an error anyways. I'll re-add the check if I can think
 		of a good way of doing it.
 	2010/05/25 - Replaced the function generating macros with templates.
+	2026/10/17 - Expressions are compiled once into trees and kept by
+		text, so repeated values no longer re-scan their operators.
+	2026/10/17 - parse<T> and function calls are timed for --debug-time.
+	2026/10/17 - Native function calls are timed apart from user ones.
+	2026/10/17 - Function calls are timed for --profile-source.
+	2026/10/17 - parse<T> is counted for --debug-stats.
 */
 
 #include "parsing.hpp"
@@ -33,6 +39,8 @@
 #include "../global_object.hpp"
 #include "../math.hpp"
 #include "../options.hpp"
+#include "../profile.hpp"
+#include "../stats.hpp"
 #include "../types.hpp"
 
 #include "../exceptions/FunctionException.hpp"
@@ -48,6 +56,43 @@
 #include "../../common/string_funcs.hpp"
 
 #include <cmath>
+#include <map>
+
+
+
+template<typename T> T parse(std::string const & value);
+
+// The name of each T, for the profile.
+template<typename T> char const * parse_type_name();
+template<> char const * parse_type_name<bool_t>()      {return "bool_t";     }
+template<> char const * parse_type_name<int_s_t>()     {return "int_s_t";    }
+template<> char const * parse_type_name<int_t>()       {return "int_t";      }
+template<> char const * parse_type_name<int_l_t>()     {return "int_l_t";    }
+template<> char const * parse_type_name<real_s_t>()    {return "real_s_t";   }
+template<> char const * parse_type_name<real_t>()      {return "real_t";     }
+template<> char const * parse_type_name<real_l_t>()    {return "real_l_t";   }
+template<> char const * parse_type_name<string_t>()    {return "string_t";   }
+template<> char const * parse_type_name<string8_t>()   {return "string8_t";  }
+template<> char const * parse_type_name<string16_t>()  {return "string16_t"; }
+template<> char const * parse_type_name<string32_t>()  {return "string32_t"; }
+template<> char const * parse_type_name<string80_t>()  {return "string80_t"; }
+template<> char const * parse_type_name<string320_t>() {return "string320_t";}
+template<> char const * parse_type_name<ubyte_t>()     {return "ubyte_t";    }
+template<> char const * parse_type_name<sword_t>()     {return "sword_t";    }
+template<> char const * parse_type_name<uword_t>()     {return "uword_t";    }
+template<> char const * parse_type_name<sdword_t>()    {return "sdword_t";   }
+template<> char const * parse_type_name<udword_t>()    {return "udword_t";   }
+
+
+
+// Compiled form of a DDL expression. See parse_tree.
+template <class T>
+struct ParsingTreeDDL
+{
+	virtual ~ParsingTreeDDL() {}
+
+	virtual T eval() const = 0;
+};
 
 
 
@@ -56,6 +101,7 @@ struct ParsingDataDDL
 {
 	ParsingDataDDL(std::string const & valueIn) :
 	valueReturn(), value(valueIn), valueLeft(), valueRight(),
+	treeLeft(NULL), treeRight(NULL),
 	operatorChar(-2),
 	hasBracket(0), hasExponent(0)
 	{
@@ -115,12 +161,28 @@ struct ParsingDataDDL
 			throw ParsingException("unbalanced parentheses:" + value);
 	}
 
+	// For evaluating compiled trees. Operands come from the trees.
+	ParsingDataDDL(int operatorIn, ParsingTreeDDL<T> const * treeLeftIn, ParsingTreeDDL<T> const * treeRightIn) :
+	valueReturn(), value(), valueLeft(), valueRight(),
+	treeLeft(treeLeftIn), treeRight(treeRightIn),
+	operatorChar(operatorIn),
+	hasBracket(0), hasExponent(0)
+	{
+
+	}
+
+	T left()  {return treeLeft  ? treeLeft->eval()  : parse<T>(valueLeft);}
+	T right() {return treeRight ? treeRight->eval() : parse<T>(valueRight);}
+
 	T valueReturn;
 
 	std::string value;
 	std::string valueLeft;
 	std::string valueRight;
 
+	ParsingTreeDDL<T> const * treeLeft;
+	ParsingTreeDDL<T> const * treeRight;
+
 	int operatorChar;
 
 	unsigned hasBracket  : 1;
@@ -129,7 +191,6 @@ struct ParsingDataDDL
 
 
 
-template<typename T> T    parse         (std::string const & value);
 template<typename T> T    parse         (SourceScannerDHLX & sc);
 template<typename T> T    parse_const   (std::string const & function);
 template<typename T> bool parse_function(ParsingDataDDL<T> & data);
@@ -137,10 +198,11 @@ template<typename T> void parse_init    (T & data);
 template<typename T> T    parse_part    (SourceScannerDHLX & sc);
 template<typename T> bool parse_special (ParsingDataDDL<T> & data, std::string const & value);
 template<typename T> bool parse_typecast(ParsingDataDDL<T> & data);
+template<typename T> T    parse_typecast(type_t const type, std::string const & value);
 template<typename T> void parse_typecast(T & data, type_t const type, SourceScannerDHLX & sc);
 template<typename T> bool parse_unary   (ParsingDataDDL<T> & data);
 template<typename T> T    parse_unary   (std::string const & function, SourceScannerDHLX & sc);
-template<typename T> T    parse_unary   (std::string const & function, std::string const & value);
+template<typename T> T    parse_unary   (std::string const & function, ParsingDataDDL<T> & data);
 template<typename T> bool parse_value   (ParsingDataDDL<T> & data);
 
 
@@ -342,7 +404,12 @@ inline bool parse_function(ParsingDataDDL<T> & data)
 
 	std::vector<std::string> args(parse_args(value));
 
-	data.valueReturn = FunctionHandler<T>::get_function(function)(args);
+	FunctionHandler<T> const & handler = FunctionHandler<T>::get_function(function);
+
+	ProfileScope profile(handler.getKind(), function);
+	ProfileSource profileSource(ProfileSource::KIND_FUNCTION, function);
+
+	data.valueReturn = handler(args);
 
 	return true;
 }
@@ -387,8 +454,8 @@ inline bool parse_math__bool(ParsingDataDDL<T> & data)
 	{
 		case -2: return false;
 
-		case '&': data.valueReturn = parse<T>(data.valueLeft) && parse<T>(data.valueRight); return true;
-		case '|': data.valueReturn = parse<T>(data.valueLeft) || parse<T>(data.valueRight); return true;
+		case '&': data.valueReturn = data.left() && data.right(); return true;
+		case '|': data.valueReturn = data.left() || data.right(); return true;
 
 		default: throw ParsingException(std::string("non-bool operator:") + (char)data.operatorChar);
 	}
@@ -423,13 +490,13 @@ inline bool parse_math__int(ParsingDataDDL<T> & data)
 	{
 		case -2: return false;
 
-		case '*': data.valueReturn = parse<T>(data.valueLeft) * parse<T>(data.valueRight); return true;
-		case '/': data.valueReturn = parse<T>(data.valueLeft) / parse<T>(data.valueRight); return true;
-		case '%': data.valueReturn = parse<T>(data.valueLeft) % parse<T>(data.valueRight); return true;
-		case '+': data.valueReturn = parse<T>(data.valueLeft) + parse<T>(data.valueRight); return true;
-		case '-': data.valueReturn = parse<T>(data.valueLeft) - parse<T>(data.valueRight); return true;
-		case '&': data.valueReturn = parse<T>(data.valueLeft) & parse<T>(data.valueRight); return true;
-		case '|': data.valueReturn = parse<T>(data.valueLeft) | parse<T>(data.valueRight); return true;
+		case '*': data.valueReturn = data.left() * data.right(); return true;
+		case '/': data.valueReturn = data.left() / data.right(); return true;
+		case '%': data.valueReturn = data.left() % data.right(); return true;
+		case '+': data.valueReturn = data.left() + data.right(); return true;
+		case '-': data.valueReturn = data.left() - data.right(); return true;
+		case '&': data.valueReturn = data.left() & data.right(); return true;
+		case '|': data.valueReturn = data.left() | data.right(); return true;
 
 		default: throw ParsingException(std::string("non-int operator:") + (char)data.operatorChar);
 	}
@@ -484,10 +551,10 @@ inline bool parse_math__real(ParsingDataDDL<T> & data)
 	{
 		case -2: return false;
 
-		case '*': data.valueReturn = parse<T>(data.valueLeft) * parse<T>(data.valueRight); return true;
-		case '/': data.valueReturn = parse<T>(data.valueLeft) / parse<T>(data.valueRight); return true;
-		case '+': data.valueReturn = parse<T>(data.valueLeft) + parse<T>(data.valueRight); return true;
-		case '-': data.valueReturn = parse<T>(data.valueLeft) - parse<T>(data.valueRight); return true;
+		case '*': data.valueReturn = data.left() * data.right(); return true;
+		case '/': data.valueReturn = data.left() / data.right(); return true;
+		case '+': data.valueReturn = data.left() + data.right(); return true;
+		case '-': data.valueReturn = data.left() - data.right(); return true;
 
 		default: throw ParsingException(std::string("non-float operator:") + (char)data.operatorChar);
 	}
@@ -530,7 +597,7 @@ inline bool parse_math__string(ParsingDataDDL<T> & data)
 	{
 		case -2: return false;
 
-		case '+': data.valueReturn = parse<T>(data.valueLeft) + parse<T>(data.valueRight); return true;
+		case '+': data.valueReturn = data.left() + data.right(); return true;
 
 		default: throw ParsingException(std::string("non-string operator:") + (char)data.operatorChar);
 	}
@@ -970,7 +1037,14 @@ inline T parse_part(SourceScannerDHLX & sc)
 			if (type_t::has_type(function))
 				parse_typecast<T>(data, type_t::get_type(function), sc);
 			else
-				data = FunctionHandler<T>::get_function(function)(sc);
+			{
+				FunctionHandler<T> const & handler = FunctionHandler<T>::get_function(function);
+
+				ProfileScope profile(handler.getKind(), function);
+				ProfileSource profileSource(ProfileSource::KIND_FUNCTION, function);
+
+				data = handler(sc);
+			}
 
 			sc.get(SourceTokenDHLX::TT_OP_PARENTHESIS_C);
 			break;
@@ -1114,37 +1188,40 @@ inline bool parse_typecast(ParsingDataDDL<T> & data)
 
 	if (bracketIndex == data.value.size()-1) return true;
 
-	type_t type(type_t::get_type(typeString));
+	data.valueReturn = parse_typecast<T>(type_t::get_type(typeString), std::string(data.value, bracketIndex + 1));
 
-	std::string value(data.value, bracketIndex + 1);
+	return true;
+}
 
-	     if (type == type_t::type_bool())       data.valueReturn = convert<T, bool_t>(parse<bool_t>(value));
+/* parse -> typecast -> value */
+template<typename T>
+inline T parse_typecast(type_t const type, std::string const & value)
+{
+	     if (type == type_t::type_bool())       return convert<T, bool_t>(parse<bool_t>(value));
 
-	else if (type == type_t::type_shortint())   data.valueReturn = convert<T, int_s_t>(parse<int_s_t>(value));
-	else if (type == type_t::type_int())        data.valueReturn = convert<T, int_t>(parse<int_t>(value));
-	else if (type == type_t::type_longint())    data.valueReturn = convert<T, int_l_t>(parse<int_l_t>(value));
+	else if (type == type_t::type_shortint())   return convert<T, int_s_t>(parse<int_s_t>(value));
+	else if (type == type_t::type_int())        return convert<T, int_t>(parse<int_t>(value));
+	else if (type == type_t::type_longint())    return convert<T, int_l_t>(parse<int_l_t>(value));
 
-	else if (type == type_t::type_shortfloat()) data.valueReturn = convert<T, real_s_t>(parse<real_s_t>(value));
-	else if (type == type_t::type_float())      data.valueReturn = convert<T, real_t>(parse<real_t>(value));
-	else if (type == type_t::type_longfloat())  data.valueReturn = convert<T, real_l_t>(parse<real_l_t>(value));
+	else if (type == type_t::type_shortfloat()) return convert<T, real_s_t>(parse<real_s_t>(value));
+	else if (type == type_t::type_float())      return convert<T, real_t>(parse<real_t>(value));
+	else if (type == type_t::type_longfloat())  return convert<T, real_l_t>(parse<real_l_t>(value));
 
-	else if (type == type_t::type_string())     data.valueReturn = convert<T, string_t>(parse<string_t>(value));
-	else if (type == type_t::type_string8())    data.valueReturn = convert<T, string8_t>(parse<string8_t>(value));
-	else if (type == type_t::type_string16())   data.valueReturn = convert<T, string16_t>(parse<string16_t>(value));
-	else if (type == type_t::type_string32())   data.valueReturn = convert<T, string32_t>(parse<string32_t>(value));
-	else if (type == type_t::type_string80())   data.valueReturn = convert<T, string80_t>(parse<string80_t>(value));
-	else if (type == type_t::type_string320())  data.valueReturn = convert<T, string320_t>(parse<string320_t>(value));
+	else if (type == type_t::type_string())     return convert<T, string_t>(parse<string_t>(value));
+	else if (type == type_t::type_string8())    return convert<T, string8_t>(parse<string8_t>(value));
+	else if (type == type_t::type_string16())   return convert<T, string16_t>(parse<string16_t>(value));
+	else if (type == type_t::type_string32())   return convert<T, string32_t>(parse<string32_t>(value));
+	else if (type == type_t::type_string80())   return convert<T, string80_t>(parse<string80_t>(value));
+	else if (type == type_t::type_string320())  return convert<T, string320_t>(parse<string320_t>(value));
 
-	else if (type == type_t::type_ubyte())      data.valueReturn = convert<T, ubyte_t>(parse<ubyte_t>(value));
-	else if (type == type_t::type_sword())      data.valueReturn = convert<T, sword_t>(parse<sword_t>(value));
-	else if (type == type_t::type_uword())      data.valueReturn = convert<T, uword_t>(parse<uword_t>(value));
-	else if (type == type_t::type_sdword())     data.valueReturn = convert<T, sdword_t>(parse<sdword_t>(value));
-	else if (type == type_t::type_udword())     data.valueReturn = convert<T, udword_t>(parse<udword_t>(value));
+	else if (type == type_t::type_ubyte())      return convert<T, ubyte_t>(parse<ubyte_t>(value));
+	else if (type == type_t::type_sword())      return convert<T, sword_t>(parse<sword_t>(value));
+	else if (type == type_t::type_uword())      return convert<T, uword_t>(parse<uword_t>(value));
+	else if (type == type_t::type_sdword())     return convert<T, sdword_t>(parse<sdword_t>(value));
+	else if (type == type_t::type_udword())     return convert<T, udword_t>(parse<udword_t>(value));
 
 	else
 		throw ParsingException("unknown typecast:" + type.makeString());
-
-	return true;
 }
 template<typename T>
 inline void parse_typecast(T & data, type_t const type, SourceScannerDHLX & sc)
@@ -1180,13 +1257,13 @@ inline void parse_typecast(T & data, type_t const type, SourceScannerDHLX & sc)
 
 /* parse -> unary -> bool */
 template<typename T>
-inline T parse_unary__bool(std::string const & function, std::string const & value)
+inline T parse_unary__bool(std::string const & function, ParsingDataDDL<T> & data)
 {
 	if (function == function_name_exists())
-		return has_object(parse_name(value));
+		return has_object(parse_name(data.valueRight));
 
 	if (function == function_name_not())
-		return !parse<T>(value);
+		return !data.right();
 
 	throw UnknownFunctionException(function);
 }
@@ -1194,18 +1271,18 @@ inline T parse_unary__bool(std::string const & function, std::string const & val
 
 /* parse -> unary -> byte */
 template<typename T>
-inline T parse_unary__byte(std::string const & function, std::string const & value)
+inline T parse_unary__byte(std::string const & function, ParsingDataDDL<T> & data)
 {
 	// Bytes are too small for certain operations.
 
 	if (function == function_name_abs())
-		return abs(parse<T>(value));
+		return abs(data.right());
 
 	if (function == function_name_random())
-		return random<T>(parse<T>(value));
+		return random<T>(data.right());
 
 	if (function == function_name_sqrt())
-		return sqrt(parse<T>(value));
+		return sqrt(data.right());
 
 	throw UnknownFunctionException(function);
 }
@@ -1213,28 +1290,28 @@ inline T parse_unary__byte(std::string const & function, std::string const & val
 
 /* parse -> unary -> int */
 template<typename T>
-inline T parse_unary__int(std::string const & function, std::string const & value)
+inline T parse_unary__int(std::string const & function, ParsingDataDDL<T> & data)
 {
 	if (function == function_name_abs())
-		return abs(parse<T>(value));
+		return abs(data.right());
 
 	if (function == function_name_byte2deg())
-		return (parse<T>(value) * T(360)) / T(256);
+		return (data.right() * T(360)) / T(256);
 
 	if (function == function_name_byteangle())
-		return clamp<T>(parse<T>(value), T(0), T(256));
+		return clamp<T>(data.right(), T(0), T(256));
 
 	if (function == function_name_deg2byte())
-		return (parse<T>(value) * T(256)) / T(360);
+		return (data.right() * T(256)) / T(360);
 
 	if (function == function_name_degrees())
-		return clamp<T>(parse<T>(value), T(0), T(360));
+		return clamp<T>(data.right(), T(0), T(360));
 
 	if (function == function_name_random())
-		return random<T>(parse<T>(value));
+		return random<T>(data.right());
 
 	if (function == function_name_sqrt())
-		return sqrt(parse<T>(value));
+		return sqrt(data.right());
 
 	throw UnknownFunctionException(function);
 }
@@ -1242,64 +1319,64 @@ inline T parse_unary__int(std::string const & function, std::string const & valu
 
 /* parse -> unary -> real */
 template<typename T>
-inline T parse_unary__real(std::string const & function, std::string const & value)
+inline T parse_unary__real(std::string const & function, ParsingDataDDL<T> & data)
 {
 	if (function == function_name_abs())
-		return abs(parse<T>(value));
+		return abs(data.right());
 
 	if (function == function_name_acos())
-		return acos(parse<T>(value));
+		return acos(data.right());
 
 	if (function == function_name_asin())
-		return asin(parse<T>(value));
+		return asin(data.right());
 
 	if (function == function_name_atan())
-		return atan(parse<T>(value));
+		return atan(data.right());
 
 	if (function == function_name_byte2deg())
-		return (parse<T>(value) * T(360)) / T(256);
+		return (data.right() * T(360)) / T(256);
 
 	if (function == function_name_byte2rad())
-		return (parse<T>(value) * convert<T, real_t>(pi())) / T(128);
+		return (data.right() * convert<T, real_t>(pi())) / T(128);
 
 	if (function == function_name_byteangle())
-		return clamp<T>(parse<T>(value), T(0), T(256));
+		return clamp<T>(data.right(), T(0), T(256));
 
 	if (function == function_name_cos())
-		return cos(parse<T>(value));
+		return cos(data.right());
 
 	if (function == function_name_deg2byte())
-		return (parse<T>(value) * T(256)) / T(360);
+		return (data.right() * T(256)) / T(360);
 
 	if (function == function_name_deg2rad())
-		return (parse<T>(value) * convert<T, real_t>(pi())) / T(180);
+		return (data.right() * convert<T, real_t>(pi())) / T(180);
 
 	if (function == function_name_degrees())
-		return clamp<T>(parse<T>(value), T(0), T(360));
+		return clamp<T>(data.right(), T(0), T(360));
 
 	if (function == function_name_rad2byte())
-		return (parse<T>(value) * T(128)) / convert<T, real_t>(pi());
+		return (data.right() * T(128)) / convert<T, real_t>(pi());
 
 	if (function == function_name_rad2deg())
-		return (parse<T>(value) * T(180)) / convert<T, real_t>(pi());
+		return (data.right() * T(180)) / convert<T, real_t>(pi());
 
 	if (function == function_name_radians())
-		return clamp<T>(parse<T>(value), T(0), convert<T, real_t>(pi() * real_t(2)));
+		return clamp<T>(data.right(), T(0), convert<T, real_t>(pi() * real_t(2)));
 
 	if (function == function_name_random())
-		return random<T>(parse<T>(value));
+		return random<T>(data.right());
 
 	if (function == function_name_round())
-		return round(parse<T>(value));
+		return round(data.right());
 
 	if (function == function_name_sin())
-		return sin(parse<T>(value));
+		return sin(data.right());
 
 	if (function == function_name_sqrt())
-		return sqrt(parse<T>(value));
+		return sqrt(data.right());
 
 	if (function == function_name_tan())
-		return tan(parse<T>(value));
+		return tan(data.right());
 
 	throw UnknownFunctionException(function);
 }
@@ -1307,15 +1384,15 @@ inline T parse_unary__real(std::string const & function, std::string const & val
 
 /* parse -> unary -> string */
 template<typename T>
-inline T parse_unary__string(std::string const & function, std::string const & value)
+inline T parse_unary__string(std::string const & function, ParsingDataDDL<T> & data)
 {
 	if (function == function_name_lower())
-		return T(tolower(parse<T>(value).makeString()));
+		return T(tolower(data.right().makeString()));
 
 	if (function == function_name_quote())
 	{
 		std::ostringstream oss;
-		std::istringstream iss(parse<T>(value).makeString());
+		std::istringstream iss(data.right().makeString());
 
 		oss.put('"');
 
@@ -1356,7 +1433,7 @@ inline T parse_unary__string(std::string const & function, std::string const & v
 	}
 
 	if (function == function_name_upper())
-		return T(toupper(parse<T>(value).makeString()));
+		return T(toupper(data.right().makeString()));
 
 	throw UnknownFunctionException(function);
 }
@@ -1377,7 +1454,10 @@ inline bool parse_unary(ParsingDataDDL<T> & data)
 	if (bracketIndex == (data.value.size() - 1))
 		data.valueReturn = parse_const<T>(function);
 	else
-		data.valueReturn = parse_unary<T>(function, data.value.substr(bracketIndex + 1));
+	{
+		data.valueRight  = data.value.substr(bracketIndex + 1);
+		data.valueReturn = parse_unary<T>(function, data);
+	}
 
 	return true;
 }
@@ -1387,135 +1467,135 @@ inline T parse_unary(std::string const & function, SourceScannerDHLX & sc)
 	throw UnknownFunctionException(function);
 }
 template<typename T>
-inline T parse_unary(std::string const & function, std::string const & value)
+inline T parse_unary(std::string const & function, ParsingDataDDL<T> & data)
 {
 	throw UnknownFunctionException(function);
 }
 
 /* parse -> unary <bool_t> */
 template<>
-inline bool_t parse_unary<bool_t>(std::string const & function, std::string const & value)
+inline bool_t parse_unary<bool_t>(std::string const & function, ParsingDataDDL<bool_t> & data)
 {
-	return parse_unary__bool<bool_t>(function, value);
+	return parse_unary__bool<bool_t>(function, data);
 }
 
 /* parse -> unary <int_s_t> */
 template<>
-inline int_s_t parse_unary<int_s_t>(std::string const & function, std::string const & value)
+inline int_s_t parse_unary<int_s_t>(std::string const & function, ParsingDataDDL<int_s_t> & data)
 {
-	return parse_unary__int<int_s_t>(function, value);
+	return parse_unary__int<int_s_t>(function, data);
 }
 
 /* parse -> unary <int_t> */
 template<>
-inline int_t parse_unary<int_t>(std::string const & function, std::string const & value)
+inline int_t parse_unary<int_t>(std::string const & function, ParsingDataDDL<int_t> & data)
 {
-	return parse_unary__int<int_t>(function, value);
+	return parse_unary__int<int_t>(function, data);
 }
 
 /* parse -> unary <int_l_t> */
 template<>
-inline int_l_t parse_unary<int_l_t>(std::string const & function, std::string const & value)
+inline int_l_t parse_unary<int_l_t>(std::string const & function, ParsingDataDDL<int_l_t> & data)
 {
-	return parse_unary__int<int_l_t>(function, value);
+	return parse_unary__int<int_l_t>(function, data);
 }
 
 /* parse -> unary <real_s_t> */
 template<>
-inline real_s_t parse_unary<real_s_t>(std::string const & function, std::string const & value)
+inline real_s_t parse_unary<real_s_t>(std::string const & function, ParsingDataDDL<real_s_t> & data)
 {
-	return parse_unary__real<real_s_t>(function, value);
+	return parse_unary__real<real_s_t>(function, data);
 }
 
 /* parse -> unary <real_t> */
 template<>
-inline real_t parse_unary<real_t>(std::string const & function, std::string const & value)
+inline real_t parse_unary<real_t>(std::string const & function, ParsingDataDDL<real_t> & data)
 {
-	return parse_unary__real<real_t>(function, value);
+	return parse_unary__real<real_t>(function, data);
 }
 
 /* parse -> unary <real_l_t> */
 template<>
-inline real_l_t parse_unary<real_l_t>(std::string const & function, std::string const & value)
+inline real_l_t parse_unary<real_l_t>(std::string const & function, ParsingDataDDL<real_l_t> & data)
 {
-	return parse_unary__real<real_l_t>(function, value);
+	return parse_unary__real<real_l_t>(function, data);
 }
 
 /* parse -> unary <string_t> */
 template<>
-inline string_t parse_unary<string_t>(std::string const & function, std::string const & value)
+inline string_t parse_unary<string_t>(std::string const & function, ParsingDataDDL<string_t> & data)
 {
-	return parse_unary__string<string_t>(function, value);
+	return parse_unary__string<string_t>(function, data);
 }
 
 /* parse -> unary <string8_t> */
 template<>
-inline string8_t parse_unary<string8_t>(std::string const & function, std::string const & value)
+inline string8_t parse_unary<string8_t>(std::string const & function, ParsingDataDDL<string8_t> & data)
 {
-	return parse_unary__string<string8_t>(function, value);
+	return parse_unary__string<string8_t>(function, data);
 }
 
 /* parse -> unary <string16_t> */
 template<>
-inline string16_t parse_unary<string16_t>(std::string const & function, std::string const & value)
+inline string16_t parse_unary<string16_t>(std::string const & function, ParsingDataDDL<string16_t> & data)
 {
-	return parse_unary__string<string16_t>(function, value);
+	return parse_unary__string<string16_t>(function, data);
 }
 
 /* parse -> unary <string32_t> */
 template<>
-inline string32_t parse_unary<string32_t>(std::string const & function, std::string const & value)
+inline string32_t parse_unary<string32_t>(std::string const & function, ParsingDataDDL<string32_t> & data)
 {
-	return parse_unary__string<string32_t>(function, value);
+	return parse_unary__string<string32_t>(function, data);
 }
 
 /* parse -> unary <string80_t> */
 template<>
-inline string80_t parse_unary<string80_t>(std::string const & function, std::string const & value)
+inline string80_t parse_unary<string80_t>(std::string const & function, ParsingDataDDL<string80_t> & data)
 {
-	return parse_unary__string<string80_t>(function, value);
+	return parse_unary__string<string80_t>(function, data);
 }
 
 /* parse -> unary <string320t> */
 template<>
-inline string320_t parse_unary<string320_t>(std::string const & function, std::string const & value)
+inline string320_t parse_unary<string320_t>(std::string const & function, ParsingDataDDL<string320_t> & data)
 {
-	return parse_unary__string<string320_t>(function, value);
+	return parse_unary__string<string320_t>(function, data);
 }
 
 /* parse -> unary <ubyte_t> */
 template<>
-inline ubyte_t parse_unary<ubyte_t>(std::string const & function, std::string const & value)
+inline ubyte_t parse_unary<ubyte_t>(std::string const & function, ParsingDataDDL<ubyte_t> & data)
 {
-	return parse_unary__byte<ubyte_t>(function, value);
+	return parse_unary__byte<ubyte_t>(function, data);
 }
 
 /* parse -> unary <sword_t> */
 template<>
-inline sword_t parse_unary<sword_t>(std::string const & function, std::string const & value)
+inline sword_t parse_unary<sword_t>(std::string const & function, ParsingDataDDL<sword_t> & data)
 {
-	return parse_unary__int<sword_t>(function, value);
+	return parse_unary__int<sword_t>(function, data);
 }
 
 /* parse -> unary <uword_t> */
 template<>
-inline uword_t parse_unary<uword_t>(std::string const & function, std::string const & value)
+inline uword_t parse_unary<uword_t>(std::string const & function, ParsingDataDDL<uword_t> & data)
 {
-	return parse_unary__int<uword_t>(function, value);
+	return parse_unary__int<uword_t>(function, data);
 }
 
 /* parse -> unary <sdword_t> */
 template<>
-inline sdword_t parse_unary<sdword_t>(std::string const & function, std::string const & value)
+inline sdword_t parse_unary<sdword_t>(std::string const & function, ParsingDataDDL<sdword_t> & data)
 {
-	return parse_unary__int<sdword_t>(function, value);
+	return parse_unary__int<sdword_t>(function, data);
 }
 
 /* parse -> unary <udword_t> */
 template<>
-inline udword_t parse_unary<udword_t>(std::string const & function, std::string const & value)
+inline udword_t parse_unary<udword_t>(std::string const & function, ParsingDataDDL<udword_t> & data)
 {
-	return parse_unary__int<udword_t>(function, value);
+	return parse_unary__int<udword_t>(function, data);
 }
 
 
@@ -1709,9 +1789,11 @@ inline bool parse_value<udword_t>(ParsingDataDDL<udword_t> & data)
 
 
 
-/* parse */
+/* parse -> text */
+// Parses directly from the text, without using the tree cache for the top
+// level. Used for the cases that the trees do not handle themselves.
 template<typename T>
-T parse(std::string const & value)
+T parse_text(std::string const & value)
 {
 	if (value.empty()) return T();
 
@@ -1740,9 +1822,377 @@ T parse(std::string const & value)
 
 	return convert<T, obj_t>(get_object(parse_name(value)));
 }
+
+
+
+/* parse -> tree -> nodes */
+template<typename T>
+struct ParsingTreeDDL_Const : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Const(std::string const & functionIn) : function(functionIn) {}
+
+	virtual T eval() const {return parse_const<T>(function);}
+
+	std::string function;
+};
+
+template<typename T>
+struct ParsingTreeDDL_Function : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Function(std::string const & functionIn, std::vector<std::string> const & argsIn) : function(functionIn), args(argsIn) {}
+
+	virtual T eval() const
+	{
+		FunctionHandler<T> const & handler = FunctionHandler<T>::get_function(function);
+
+		ProfileScope profile(handler.getKind(), function);
+		ProfileSource profileSource(ProfileSource::KIND_FUNCTION, function);
+
+		return handler(args);
+	}
+
+	std::string function;
+	std::vector<std::string> args;
+};
+
+template<typename T>
+struct ParsingTreeDDL_Math : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Math(int operatorIn, ParsingTreeDDL<T> const * treeLeftIn, ParsingTreeDDL<T> const * treeRightIn) :
+	operatorChar(operatorIn), treeLeft(treeLeftIn), treeRight(treeRightIn) {}
+
+	virtual T eval() const
+	{
+		ParsingDataDDL<T> data(operatorChar, treeLeft, treeRight);
+
+		parse_math<T>(data);
+
+		return data.valueReturn;
+	}
+
+	int operatorChar;
+
+	ParsingTreeDDL<T> const * treeLeft;
+	ParsingTreeDDL<T> const * treeRight;
+};
+
+template<typename T>
+struct ParsingTreeDDL_Object : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Object(std::string const & valueIn) : value(valueIn) {}
+
+	virtual T eval() const {return convert<T, obj_t>(get_object(parse_name(value)));}
+
+	std::string value;
+};
+
+template<typename T>
+struct ParsingTreeDDL_String : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_String(std::string const & valueIn) : value(valueIn) {}
+
+	virtual T eval() const
+	{
+		if (!option_strict_strings && !has_object(parse_name(value)))
+			return T(value);
+
+		return convert<T, obj_t>(get_object(parse_name(value)));
+	}
+
+	std::string value;
+};
+
+template<typename T>
+struct ParsingTreeDDL_Text : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Text(std::string const & valueIn) : value(valueIn) {}
+
+	virtual T eval() const {return parse_text<T>(value);}
+
+	std::string value;
+};
+
+// The type name is only checked when evaluated, since types can be added
+// after the tree is made.
+template<typename T>
+struct ParsingTreeDDL_Typecast : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Typecast(std::string const & typeIn, std::string const & valueIn, bool hasValueIn, ParsingTreeDDL<T> * treeElseIn) :
+	type(typeIn), value(valueIn), hasValue(hasValueIn), treeElse(treeElseIn) {}
+
+	virtual ~ParsingTreeDDL_Typecast() {delete treeElse;}
+
+	virtual T eval() const
+	{
+		if (!type_t::has_type(type))
+			return treeElse->eval();
+
+		if (!hasValue)
+			return T();
+
+		return parse_typecast<T>(type_t::get_type(type), value);
+	}
+
+	std::string type;
+	std::string value;
+	bool hasValue;
+
+	ParsingTreeDDL<T> * treeElse;
+
+	private:
+		ParsingTreeDDL_Typecast(ParsingTreeDDL_Typecast<T> const &);
+		ParsingTreeDDL_Typecast & operator = (ParsingTreeDDL_Typecast<T> const &);
+};
+
+template<typename T>
+struct ParsingTreeDDL_Unary : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Unary(std::string const & functionIn, std::string const & valueIn, ParsingTreeDDL<T> const * treeIn) :
+	function(functionIn), value(valueIn), tree(treeIn) {}
+
+	virtual T eval() const
+	{
+		ParsingDataDDL<T> data(-2, NULL, tree);
+
+		data.valueRight = value;
+
+		return parse_unary<T>(function, data);
+	}
+
+	std::string function;
+	std::string value;
+
+	ParsingTreeDDL<T> const * tree;
+};
+
+template<typename T>
+struct ParsingTreeDDL_Value : public ParsingTreeDDL<T>
+{
+	ParsingTreeDDL_Value(T const & valueIn) : value(valueIn) {}
+
+	virtual T eval() const {return value;}
+
+	T value;
+};
+
+
+/* parse -> tree -> value */
+template<typename T>
+inline ParsingTreeDDL<T> * parse_tree_value(ParsingDataDDL<T> & data)
+{
+	try
+	{
+		if (parse_value<T>(data))
+			return new ParsingTreeDDL_Value<T>(data.valueReturn);
+	}
+	catch (CompilerException &)
+	{
+		// Leave the error for when it gets evaluated.
+		return new ParsingTreeDDL_Text<T>(data.value);
+	}
+
+	return new ParsingTreeDDL_Object<T>(data.value);
+}
+
+/* parse -> tree -> value -> string */
+template<typename T>
+inline ParsingTreeDDL<T> * parse_tree_value__string(ParsingDataDDL<T> & data)
+{
+	if (data.value[0] == '$')
+		return new ParsingTreeDDL_Value<T>(T(data.value.substr(1)));
+
+	return new ParsingTreeDDL_String<T>(data.value);
+}
+
+/* parse -> tree -> value <string_t> */
+template<>
+inline ParsingTreeDDL<string_t> * parse_tree_value<string_t>(ParsingDataDDL<string_t> & data)
+{
+	return parse_tree_value__string<string_t>(data);
+}
+
+/* parse -> tree -> value <string8_t> */
+template<>
+inline ParsingTreeDDL<string8_t> * parse_tree_value<string8_t>(ParsingDataDDL<string8_t> & data)
+{
+	return parse_tree_value__string<string8_t>(data);
+}
+
+/* parse -> tree -> value <string16_t> */
+template<>
+inline ParsingTreeDDL<string16_t> * parse_tree_value<string16_t>(ParsingDataDDL<string16_t> & data)
+{
+	return parse_tree_value__string<string16_t>(data);
+}
+
+/* parse -> tree -> value <string32_t> */
+template<>
+inline ParsingTreeDDL<string32_t> * parse_tree_value<string32_t>(ParsingDataDDL<string32_t> & data)
+{
+	return parse_tree_value__string<string32_t>(data);
+}
+
+/* parse -> tree -> value <string80_t> */
+template<>
+inline ParsingTreeDDL<string80_t> * parse_tree_value<string80_t>(ParsingDataDDL<string80_t> & data)
+{
+	return parse_tree_value__string<string80_t>(data);
+}
+
+/* parse -> tree -> value <string320_t> */
+template<>
+inline ParsingTreeDDL<string320_t> * parse_tree_value<string320_t>(ParsingDataDDL<string320_t> & data)
+{
+	return parse_tree_value__string<string320_t>(data);
+}
+
+
+template<typename T> ParsingTreeDDL<T> const & parse_tree    (std::string const & value);
+template<typename T> ParsingTreeDDL<T> *       parse_tree_new(std::string const & value);
+
+/* parse -> tree -> make */
+// Follows the same steps as parse_text, but builds nodes instead of values.
+// Nothing here may depend on state that can change during compiling.
+template<typename T>
+ParsingTreeDDL<T> * parse_tree_make(ParsingDataDDL<T> & data)
+{
+	std::string const & value(data.value);
+
+	if (value[0] == '[')
+	{
+		size_t bracketIndex = value.find(']');
+
+		if (bracketIndex != std::string::npos)
+		{
+			std::string function(value.substr(1, bracketIndex-1));
+
+			if (bracketIndex == (value.size() - 1))
+				return new ParsingTreeDDL_Const<T>(function);
+
+			std::string operand(value.substr(bracketIndex + 1));
+
+			return new ParsingTreeDDL_Unary<T>(function, operand, &parse_tree<T>(operand));
+		}
+	}
+
+	if (value[0] == '<')
+	{
+		size_t bracketIndex = value.find('>');
+
+		if (bracketIndex != std::string::npos)
+		{
+			if (bracketIndex == (value.size() - 1))
+				return new ParsingTreeDDL_Text<T>(value);
+
+			std::string function(value, 1, bracketIndex - 1);
+			std::string args(value, bracketIndex + 2, (value.size() - 1) - (bracketIndex + 2));
+
+			return new ParsingTreeDDL_Function<T>(function, parse_args(args));
+		}
+	}
+
+	if (data.hasBracket && value[0] == '(')
+		return parse_tree_new<T>(value.substr(1, value.length()-2));
+
+	return parse_tree_value<T>(data);
+}
+
+/* parse -> tree -> new */
+template<typename T>
+ParsingTreeDDL<T> * parse_tree_new(std::string const & value)
+{
+	if (value.empty()) return new ParsingTreeDDL_Value<T>(T());
+
+	try
+	{
+		ParsingDataDDL<T> data(value);
+
+		if (parse_special<T>(data, value))
+			return new ParsingTreeDDL_Value<T>(data.valueReturn);
+
+		if (data.operatorChar != -2)
+			return new ParsingTreeDDL_Math<T>(data.operatorChar, &parse_tree<T>(data.valueLeft), &parse_tree<T>(data.valueRight));
+
+		if (value[0] == '(')
+		{
+			size_t bracketIndex = value.find(')');
+
+			if (bracketIndex != std::string::npos)
+			{
+				bool hasValue(bracketIndex != value.size()-1);
+
+				return new ParsingTreeDDL_Typecast<T>(std::string(value, 1, bracketIndex-1), hasValue ? std::string(value, bracketIndex + 1) : std::string(), hasValue, parse_tree_make<T>(data));
+			}
+		}
+
+		return parse_tree_make<T>(data);
+	}
+	catch (CompilerException &)
+	{
+		return new ParsingTreeDDL_Text<T>(value);
+	}
+}
+
+/* parse -> tree */
+// Each expression is compiled once into a tree, which is kept by text. Trees
+// hold numeric literals, so they are thrown out if the precision changes.
+template<typename T>
+ParsingTreeDDL<T> const & parse_tree(std::string const & value)
+{
+	typedef std::map<std::string, ParsingTreeDDL<T> *> tree_map_t;
+
+	static tree_map_t tree_map;
+	static int        tree_precision = option_precision;
+
+	if (tree_precision != option_precision)
+	{
+		for (typename tree_map_t::iterator it = tree_map.begin(); it != tree_map.end(); ++it)
+			delete it->second;
+
+		tree_map.clear();
+		tree_precision = option_precision;
+	}
+
+	typename tree_map_t::iterator it = tree_map.find(value);
+
+	if (it != tree_map.end())
+		return *it->second;
+
+	ParsingTreeDDL<T> * tree = parse_tree_new<T>(value);
+
+	tree_map[value] = tree;
+
+	return *tree;
+}
+
+
+
+/* parse */
+// Made only once counting is on, so that only the types parsed are printed.
+template<typename T>
+static void parse_count()
+{
+	static StatsCounter counter("parse", parse_type_name<T>());
+
+	counter.add();
+}
+
+template<typename T>
+T parse(std::string const & value)
+{
+	if (StatsCounter::enabled) parse_count<T>();
+
+	ProfileScope profile("parse", parse_type_name<T>());
+
+	return parse_tree<T>(value).eval();
+}
 template<typename T>
 T parse(SourceScannerDHLX & sc)
 {
+	if (StatsCounter::enabled) parse_count<T>();
+
+	ProfileScope profile("parse", parse_type_name<T>());
+
 	T data;
 
 	parse_init<T>(data);
@@ -1795,10 +2245,24 @@ name_t parse_name(SourceScannerDHLX & sc)
 
 	bool hasDynamic(false);
 
+	// A single [index] is kept back, so that name_t can look it up
+	// without making the string.
+	bool    hasIndex(false);
+	int_s_t nameIndex(0);
+
 	while (true)
 	{
 		nameToken = sc.get();
 
+		if (hasIndex && (
+			nameToken.getType() == SourceTokenDHLX::TT_OP_PERIOD ||
+			nameToken.getType() == SourceTokenDHLX::TT_OP_BRACKET_O ||
+			nameToken.getType() == SourceTokenDHLX::TT_OP_CMP_LT))
+		{
+			nameElement += make_string(nameIndex);
+			hasIndex     = false;
+		}
+
 		if (nameToken.getType() == SourceTokenDHLX::TT_OP_PERIOD)
 		{
 			nameVector.push_back(nameElement);
@@ -1808,9 +2272,13 @@ name_t parse_name(SourceScannerDHLX & sc)
 		else if (nameToken.getType() == SourceTokenDHLX::TT_OP_BRACKET_O)
 		{
 			if (hasDynamic)
-				nameElement += '.';
-			nameElement += make_string(parse<int_s_t>(sc));
-			hasDynamic   = true;
+				nameElement += '.' + make_string(parse<int_s_t>(sc));
+			else
+			{
+				nameIndex = parse<int_s_t>(sc);
+				hasIndex  = true;
+			}
+			hasDynamic = true;
 
 			sc.get(SourceTokenDHLX::TT_OP_BRACKET_C);
 		}
@@ -1832,6 +2300,9 @@ name_t parse_name(SourceScannerDHLX & sc)
 
 	nameVector.push_back(nameElement);
 
+	if (hasIndex)
+		return name_t(nameVector).getIndexed(nameIndex);
+
 	return name_t(nameVector);
 }
 name_t parse_name(std::string const & value)
@@ -1854,6 +2325,10 @@ name_t parse_name(std::string const & value)
 
 	bool skipChar(false);
 
+	// As above, a single [index] is kept back.
+	bool    hasIndex(false);
+	int_s_t nameIndex(0);
+
 	for (size_t index = 0; index < value.size(); ++index)
 	{
 		char indexChar = value[index];
@@ -1861,6 +2336,12 @@ name_t parse_name(std::string const & value)
 		     if ((indexChar == '[') || (indexChar == '<') || (indexChar == '(')) ++bracketCount;
 		else if ((indexChar == ']') || (indexChar == '>') || (indexChar == ')')) --bracketCount;
 
+		if (hasIndex && (bracketCount != 0 || indexChar != ']'))
+		{
+			nameElement += make_string(nameIndex);
+			hasIndex     = false;
+		}
+
 		if (bracketCount == 0)
 		{
 			if (indexChar == '.')
@@ -1876,8 +2357,12 @@ name_t parse_name(std::string const & value)
 				skipChar   = true;
 
 				if (hasDynamic)
-					nameElement += '.';
-				nameElement += make_string(parse<int_s_t>(nameDynamic));
+					nameElement += '.' + make_string(parse<int_s_t>(nameDynamic));
+				else
+				{
+					nameIndex = parse<int_s_t>(nameDynamic);
+					hasIndex  = true;
+				}
 				nameDynamic.clear();
 
 				hasDynamic = true;
@@ -1931,6 +2416,9 @@ name_t parse_name(std::string const & value)
 
 	nameVector.push_back(nameElement);
 
+	if (hasIndex)
+		return name_t(nameVector).getIndexed(nameIndex);
+
 	return name_t(nameVector);
 }
 
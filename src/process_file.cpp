@@ -18,18 +18,21 @@
 */
 
 /*
-
+	2026/10/17 - Files are timed for --debug-time.
 */
 
 #include "process_file.hpp"
 
 #include "options.hpp"
 #include "process_stream.hpp"
+#include "profile.hpp"
 #include "SourceStream.hpp"
 #include "SourceToken.hpp"
 
+#include "../common/IO.hpp"
+
+#include <algorithm>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <string>
@@ -48,17 +51,15 @@ void process_file(std::string const & filename)
 
 	filenameLoaded[filename] = true;
 
-	std::ifstream sourceFile(filename.c_str());
+	ProfileScope profile("file", filename);
+
+	IO::MappedFile sourceFile;
 
-	if (!sourceFile)
+	if (!sourceFile.open(filename))
 	{
 		for (size_t index = 0; index < option_include.size(); ++index)
 		{
-			sourceFile.close();
-			sourceFile.clear();
-			sourceFile.open((option_include[index] + filename).c_str());
-
-			if (sourceFile)
+			if (sourceFile.open(option_include[index] + filename))
 				break;
 		}
 
@@ -69,30 +70,29 @@ void process_file(std::string const & filename)
 		}
 	}
 
-	std::string idstring;
-	std::getline(sourceFile, idstring);
-	sourceFile.seekg(0);
+	char const * sourceData = sourceFile.data();
+	size_t       sourceSize = sourceFile.size();
+
+	std::string idstring(sourceData, std::find(sourceData, sourceData + sourceSize, '\n'));
 
 	if (idstring == "//DDL")
 	{
-		SourceStream ss(sourceFile);
+		SourceStream ss(sourceData, sourceSize);
 
 		process_stream<SourceTokenDDL>(ss, filename);
 	}
 	else if (idstring == "//DHLX")
 	{
-		SourceStream ss(sourceFile, SourceStream::ST_DHLX);
+		SourceStream ss(sourceData, sourceSize, SourceStream::ST_DHLX);
 
 		process_stream<SourceTokenDHLX>(ss, filename);
 	}
 	else
 	{
-		SourceStream ss(sourceFile);
+		SourceStream ss(sourceData, sourceSize);
 
 		process_stream<SourceTokenDDL>(ss, filename);
 	}
-
-	sourceFile.close();
 }
 
 
@@ -18,14 +18,18 @@
 */
 
 /*
-
+	2026/10/17 - Streams are timed for --debug-time.
+	2026/10/17 - So is each statement, which --trace labels with its line.
+	2026/10/17 - Statements are timed by line for --profile-source.
 */
 
 #include "process_stream.hpp"
 
 #include "options.hpp"
 #include "process_token.hpp"
+#include "profile.hpp"
 #include "SourceToken.hpp"
+#include "types.hpp"
 
 #include <cstdlib>
 #include <iostream>
@@ -35,14 +39,26 @@
 template <class TokenClass>
 void process_stream(SourceStream & ss, std::string const & filename)
 {
+	ProfileScope profile("stream", filename);
+
 	SourceScanner<TokenClass, SourceStream> sc(ss);
 	TokenClass st;
 
+	std::string const * profileFile = ProfileSource::enabled ? profile_source_file(filename) : NULL;
+
 	while (ss)
 	{
 		try
 		{
+			ProfileScope profileStatement("statement");
+
 			st = sc.get();
+
+			if (ProfileScope::trace_enabled)
+				profileStatement.setLabel(filename + ':' + make_string(static_cast<int_s_t>(ss.getLineCount())));
+
+			ProfileSource profileSource(profileFile, ss.getLineCount());
+
 			process_token(st, sc);
 		}
 		catch (CompilerException & e)
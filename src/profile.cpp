@@ -0,0 +1,570 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+	2026/10/17 - Added the trace for --trace.
+	2026/10/17 - Added ProfileSource for --profile-source.
+*/
+
+#include "profile.hpp"
+
+#include "types.hpp"
+
+#include "LevelObject/LevelObjectName.hpp"
+
+#include "../common/foreach.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#if __cplusplus >= 201103L
+#include <chrono>
+#endif
+
+#if USE_THREADS
+#include <mutex>
+#define PROFILE_THREAD_LOCAL thread_local
+#else
+#define PROFILE_THREAD_LOCAL
+#endif
+
+
+
+struct ProfileNode
+{
+	char const * kind;
+	std::string  detail;
+
+	unsigned long int count;
+
+	// Nanoseconds.
+	long long int time;
+
+	std::vector<ProfileNode *> children;
+};
+
+struct ProfileEvent
+{
+	char const * kind;
+	std::string  name;
+
+	// Nanoseconds, from the start of the run. A time of -1 is still open.
+	long long int start;
+	long long int time;
+
+	int thread;
+};
+
+struct ProfileSourceEntry
+{
+	unsigned long int count;
+
+	// Nanoseconds.
+	long long int total;
+	long long int self;
+
+	// Scopes of it that are still open, so that recursion is timed once.
+	unsigned long int active;
+};
+
+// For sorting the source profile.
+struct ProfileSourceRow
+{
+	ProfileSourceEntry const * entry;
+
+	std::string source;
+};
+
+
+
+static long long int profile_now()
+{
+	#if __cplusplus >= 201103L
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	#else
+	// CPU time, which is all C++98 has.
+	return static_cast<long long int>(clock()) * (1000000000 / CLOCKS_PER_SEC);
+	#endif
+}
+
+static long long int profile_start = profile_now();
+
+static ProfileNode profile_root = {"total", "", 1, 0, std::vector<ProfileNode *>()};
+
+static PROFILE_THREAD_LOCAL ProfileNode * profile_current = &profile_root;
+
+static bool profile_shared = false;
+
+// Deque, so that scopes can keep a pointer to their event.
+static std::deque<ProfileEvent> profile_events;
+
+// Threads are numbered from 1 in the order they make their first scope.
+static PROFILE_THREAD_LOCAL int profile_thread = 0;
+static int profile_threads = 0;
+
+static PROFILE_THREAD_LOCAL std::vector<std::string> * profile_objects = NULL;
+
+// Scopes made too often to be worth an event each.
+static char const * const profile_untraced[] = {"native", "parse", "stream"};
+
+#if USE_THREADS
+static std::mutex profile_mutex;
+#endif
+
+static std::set<std::string> profile_source_files;
+
+// By line, in a deque so that scopes can keep a pointer to their entry.
+static std::map<std::string const *, std::deque<ProfileSourceEntry> > profile_source_lines;
+
+static std::map<std::string, ProfileSourceEntry> profile_source_compounds;
+static std::map<std::string, ProfileSourceEntry> profile_source_functions;
+
+static ProfileSource * profile_source_current = NULL;
+
+
+
+bool ProfileScope::profile_enabled = false;
+bool ProfileScope::trace_enabled   = false;
+
+ProfileScope::ProfileScope(char const * kind, char const * detail) : _node(NULL)
+{
+	if (profile_enabled || trace_enabled) begin(kind, detail, std::strlen(detail));
+}
+
+void ProfileScope::begin(char const * kind, char const * detail, size_t length)
+{
+	#if USE_THREADS
+	if (profile_shared) profile_mutex.lock();
+	#endif
+
+	_outer = profile_current;
+
+	FOREACH_T(std::vector<ProfileNode *>, it, _outer->children)
+	{
+		ProfileNode * child = *it;
+
+		if ((child->kind == kind || std::strcmp(child->kind, kind) == 0) &&
+			child->detail.size() == length && std::memcmp(child->detail.data(), detail, length) == 0)
+		{
+			_node = child;
+			break;
+		}
+	}
+
+	if (!_node)
+	{
+		_node = new ProfileNode;
+
+		_node->kind = kind;
+		_node->detail.assign(detail, length);
+		_node->count = 0;
+		_node->time  = 0;
+
+		_outer->children.push_back(_node);
+	}
+
+	++_node->count;
+
+	profile_current = _node;
+
+	_event = NULL;
+
+	if (trace_enabled)
+	{
+		bool traced = true;
+
+		for (size_t index = 0; index < sizeof(profile_untraced) / sizeof(*profile_untraced); ++index)
+		{
+			if (std::strcmp(kind, profile_untraced[index]) == 0)
+			{
+				traced = false;
+				break;
+			}
+		}
+
+		if (traced)
+		{
+			if (!profile_thread)
+				profile_thread = ++profile_threads;
+
+			profile_events.push_back(ProfileEvent());
+
+			_event = &profile_events.back();
+
+			_event->kind = kind;
+			_event->time = -1;
+			_event->thread = profile_thread;
+
+			if (length)
+				_event->name.assign(detail, length);
+			else
+				_event->name = kind;
+		}
+	}
+
+	#if USE_THREADS
+	if (profile_shared) profile_mutex.unlock();
+	#endif
+
+	_start = profile_now();
+
+	if (_event) _event->start = _start - profile_start;
+}
+
+void ProfileScope::stop()
+{
+	if (!_node) return;
+
+	long long int time = profile_now() - _start;
+
+	#if USE_THREADS
+	if (profile_shared) profile_mutex.lock();
+	#endif
+
+	_node->time += time;
+
+	if (_event) _event->time = time;
+
+	profile_current = _outer;
+
+	#if USE_THREADS
+	if (profile_shared) profile_mutex.unlock();
+	#endif
+
+	_node = NULL;
+}
+
+void ProfileScope::setLabel(std::string const & label)
+{
+	if (_event) _event->name = label;
+}
+
+
+
+void ProfileObject::begin(LevelObjectName const & name)
+{
+	if (!profile_objects)
+		profile_objects = new std::vector<std::string>;
+
+	std::ostringstream out;
+	out << name;
+
+	profile_objects->push_back(out.str());
+
+	_begun = true;
+}
+
+void ProfileObject::end()
+{
+	profile_objects->pop_back();
+}
+
+
+
+bool ProfileSource::enabled = false;
+
+void ProfileSource::begin(std::string const * file, int line)
+{
+	if (line < 0) line = 0;
+
+	std::deque<ProfileSourceEntry> & lines = profile_source_lines[file];
+
+	if (lines.size() <= static_cast<size_t>(line))
+	{
+		ProfileSourceEntry entry = {0, 0, 0, 0};
+		lines.resize(line + 1, entry);
+	}
+
+	begin(&lines[line]);
+
+	_file = file;
+	_line = line;
+}
+
+void ProfileSource::begin(Kind kind, std::string const & name)
+{
+	std::map<std::string, ProfileSourceEntry> & entries = kind == KIND_COMPOUND ? profile_source_compounds : profile_source_functions;
+
+	std::map<std::string, ProfileSourceEntry>::iterator it(entries.find(name));
+
+	if (it == entries.end())
+	{
+		ProfileSourceEntry entry = {0, 0, 0, 0};
+		it = entries.insert(std::make_pair(name, entry)).first;
+	}
+
+	begin(&it->second);
+}
+
+void ProfileSource::begin(ProfileSourceEntry * entry)
+{
+	_entry = entry;
+
+	++_entry->count;
+	++_entry->active;
+
+	_outer = profile_source_current;
+	profile_source_current = this;
+
+	_file  = NULL;
+	_line  = 0;
+	_inner = 0;
+
+	_start = profile_now();
+}
+
+void ProfileSource::end()
+{
+	long long int time = profile_now() - _start;
+
+	if (!--_entry->active)
+		_entry->total += time;
+
+	_entry->self += time - _inner;
+
+	if (_outer)
+		_outer->_inner += time;
+
+	profile_source_current = _outer;
+}
+
+void ProfileSource::locate(std::string const & data, std::string const * & file, int & line)
+{
+	for (ProfileSource * scope = profile_source_current; scope; scope = scope->_outer)
+	{
+		if (scope->_file)
+		{
+			file = scope->_file;
+			line = scope->_line - static_cast<int>(std::count(data.begin(), data.end(), '\n'));
+
+			return;
+		}
+	}
+
+	file = NULL;
+	line = 0;
+}
+
+std::string const * profile_source_file(std::string const & name)
+{
+	return &*profile_source_files.insert(name).first;
+}
+
+
+
+ProfileNode * profile_get_current()
+{
+	return profile_current;
+}
+
+void profile_set_current(ProfileNode * node)
+{
+	profile_current = node;
+}
+
+void profile_set_shared(bool shared)
+{
+	profile_shared = shared;
+}
+
+std::string const & profile_get_object()
+{
+	static std::string const empty;
+
+	return profile_objects && !profile_objects->empty() ? profile_objects->back() : empty;
+}
+
+static void print_json_string(std::ostream & out, std::string const & s)
+{
+	out << '"';
+
+	FOREACH_T_CONST(std::string, it, s)
+	{
+		if (*it == '"' || *it == '\\')
+			out << '\\' << *it;
+		else if (static_cast<unsigned char>(*it) < 0x20)
+		{
+			char buffer[8];
+			std::sprintf(buffer, "\\u%04x", static_cast<unsigned char>(*it));
+			out << buffer;
+		}
+		else
+			out << *it;
+	}
+
+	out << '"';
+}
+
+static void print_profile_json(std::ostream & out, ProfileNode const & node)
+{
+	long long int self = node.time;
+
+	FOREACH_T_CONST(std::vector<ProfileNode *>, it, node.children)
+		self -= (*it)->time;
+
+	// Children on several threads can take longer than their parent.
+	if (self < 0) self = 0;
+
+	out << "{\"kind\":\"" << node.kind << "\",\"detail\":";
+
+	print_json_string(out, node.detail);
+
+	out << ",\"count\":" << node.count << ",\"total\":" << node.time << ",\"self\":" << self << ",\"children\":[";
+
+	FOREACH_T_CONST(std::vector<ProfileNode *>, it, node.children)
+	{
+		if (it != node.children.begin()) out << ',';
+
+		print_profile_json(out, **it);
+	}
+
+	out << "]}";
+}
+
+static void print_profile_text(std::ostream & out, ProfileNode const & node, int depth)
+{
+	long long int self = node.time;
+
+	FOREACH_T_CONST(std::vector<ProfileNode *>, it, node.children)
+		self -= (*it)->time;
+
+	// Children on several threads can take longer than their parent.
+	if (self < 0) self = 0;
+
+	char buffer[64];
+	std::sprintf(buffer, "%12.6f %12.6f %10lu  ", node.time / 1e9, self / 1e9, node.count);
+
+	out << buffer << std::string(depth * 2, ' ') << node.kind;
+
+	if (!node.detail.empty())
+		out << ':' << node.detail;
+
+	out << '\n';
+
+	FOREACH_T_CONST(std::vector<ProfileNode *>, it, node.children)
+		print_profile_text(out, **it, depth + 1);
+}
+
+void print_profile(std::ostream & out, bool json)
+{
+	profile_root.time = profile_now() - profile_start;
+
+	if (json)
+	{
+		// Times are in nanoseconds.
+		print_profile_json(out, profile_root);
+		out << '\n';
+	}
+	else
+	{
+		out << "       total         self      count  scope\n";
+		print_profile_text(out, profile_root, 0);
+	}
+}
+
+void print_trace(std::ostream & out)
+{
+	long long int now = profile_now() - profile_start;
+
+	out << "{\"traceEvents\":[\n";
+
+	FOREACH_T_CONST(std::deque<ProfileEvent>, it, profile_events)
+	{
+		// Scopes still open, like the one for the whole compile, end now.
+		long long int time = it->time < 0 ? now - it->start : it->time;
+
+		// Times are in microseconds.
+		char buffer[96];
+		std::sprintf(buffer, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}", it->start / 1e3, time / 1e3, it->thread);
+
+		if (it != profile_events.begin()) out << ",\n";
+
+		out << "{\"name\":";
+		print_json_string(out, it->name);
+		out << ",\"cat\":\"" << it->kind << '"' << buffer;
+	}
+
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+static bool profile_source_compare(ProfileSourceRow const & left, ProfileSourceRow const & right)
+{
+	return left.entry->total > right.entry->total;
+}
+
+static void profile_source_rows(std::vector<ProfileSourceRow> & rows, std::map<std::string, ProfileSourceEntry> const & entries, char const * kind)
+{
+	typedef std::map<std::string, ProfileSourceEntry> entries_t;
+
+	FOREACH_T_CONST(entries_t, it, entries)
+	{
+		ProfileSourceRow row = {&it->second, std::string(kind) + ' ' + it->first};
+		rows.push_back(row);
+	}
+}
+
+void print_profile_source(std::ostream & out, size_t count)
+{
+	typedef std::map<std::string const *, std::deque<ProfileSourceEntry> > lines_t;
+
+	std::vector<ProfileSourceRow> rows;
+
+	FOREACH_T_CONST(lines_t, it, profile_source_lines)
+	{
+		for (size_t line = 0; line < it->second.size(); ++line)
+		{
+			if (!it->second[line].count) continue;
+
+			std::ostringstream source;
+			source << *it->first << ':' << line;
+
+			ProfileSourceRow row = {&it->second[line], source.str()};
+			rows.push_back(row);
+		}
+	}
+
+	profile_source_rows(rows, profile_source_compounds, "compound");
+	profile_source_rows(rows, profile_source_functions, "function");
+
+	std::stable_sort(rows.begin(), rows.end(), profile_source_compare);
+
+	if (rows.size() > count)
+		rows.resize(count);
+
+	out << "       total         self      count  source\n";
+
+	FOREACH_T_CONST(std::vector<ProfileSourceRow>, it, rows)
+	{
+		char buffer[64];
+		std::sprintf(buffer, "%12.6f %12.6f %10lu  ", it->entry->total / 1e9, it->entry->self / 1e9, it->entry->count);
+
+		out << buffer << it->source << '\n';
+	}
+}
+
+
+
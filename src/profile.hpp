@@ -0,0 +1,234 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Wall time profile, for --debug-time. A ProfileScope times the code from
+	its construction to its destruction, as a child of the scope it is in.
+	Scopes of the same kind and detail in the same parent are one node, with
+	a count. The tree is printed with the total and self time of each node.
+
+	Scopes cost a single test while profiling is off.
+
+	With --trace, each scope is also kept as an event, with the thread it ran
+	on, and written as Chrome trace-event JSON for a timeline viewer.
+
+	2026/10/17 - Original version.
+	2026/10/17 - Added the trace for --trace.
+	2026/10/17 - Added ProfileSource for --profile-source.
+*/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+
+
+class LevelObjectName;
+
+struct ProfileNode;
+struct ProfileEvent;
+struct ProfileSourceEntry;
+
+class ProfileScope
+{
+	public:
+		explicit ProfileScope(char const * kind) : _node(NULL)
+		{
+			if (profile_enabled || trace_enabled) begin(kind, "", 0);
+		}
+		ProfileScope(char const * kind, char const * detail);
+		ProfileScope(char const * kind, std::string const & detail) : _node(NULL)
+		{
+			if (profile_enabled || trace_enabled) begin(kind, detail.data(), detail.size());
+		}
+
+		~ProfileScope() {if (_node) stop();}
+
+		/*
+			Ends the scope before its destruction.
+		*/
+		void stop();
+
+		/*
+			Names the scope's trace event, which is otherwise named by its
+			detail. Only the trace uses it, so callers that have to make the
+			label can leave it out unless trace_enabled.
+		*/
+		void setLabel(std::string const & label);
+
+		// Set once the options are read.
+		static bool profile_enabled;
+		static bool trace_enabled;
+
+	private:
+		ProfileScope(ProfileScope const &);
+
+		void begin(char const * kind, char const * detail, size_t length);
+
+		ProfileScope & operator = (ProfileScope const &);
+
+		ProfileNode * _node;
+		ProfileNode * _outer;
+
+		ProfileEvent * _event;
+
+		long long int _start;
+};
+
+/*
+	Names the object being added on this thread, while it is in scope, for
+	the labels of the trace events it causes.
+*/
+class ProfileObject
+{
+	public:
+		explicit ProfileObject(LevelObjectName const & name) : _begun(false)
+		{
+			if (ProfileScope::trace_enabled) begin(name);
+		}
+
+		~ProfileObject() {if (_begun) end();}
+
+	private:
+		ProfileObject(ProfileObject const &);
+
+		void begin(LevelObjectName const & name);
+		void end();
+
+		ProfileObject & operator = (ProfileObject const &);
+
+		bool _begun;
+};
+
+/*
+	The name of the innermost ProfileObject, or an empty string.
+*/
+std::string const & profile_get_object();
+
+/*
+	Source profile, for --profile-source. Unlike the tree, it is flat: each
+	source line, compound type, and function has one entry, with the time
+	spent in it (counted once, however deeply it recurses), the time spent
+	in it but not in other entries, and a count.
+
+	Lines are those that statements end on, the same as in errors. DDL
+	blocks know where they start, so their statements have the line in the
+	file and not in the block.
+
+	Scopes cost a single test while it is off. Only the compiling thread may
+	make them.
+*/
+class ProfileSource
+{
+	public:
+		enum Kind
+		{
+			KIND_COMPOUND,
+			KIND_FUNCTION
+		};
+
+		/*
+			A statement that ends on line of file, which must come from
+			profile_source_file(). Nothing is timed if file is NULL.
+		*/
+		ProfileSource(std::string const * file, int line) : _entry(NULL)
+		{
+			if (enabled && file) begin(file, line);
+		}
+		ProfileSource(Kind kind, std::string const & name) : _entry(NULL)
+		{
+			if (enabled) begin(kind, name);
+		}
+
+		~ProfileSource() {if (_entry) end();}
+
+		/*
+			Finds where a block made in the current statement starts, from
+			the block's text, which ends on the statement's last line. Sets
+			file to NULL if there is no current statement.
+		*/
+		static void locate(std::string const & data, std::string const * & file, int & line);
+
+		// Set once the options are read.
+		static bool enabled;
+
+	private:
+		ProfileSource(ProfileSource const &);
+
+		void begin(std::string const * file, int line);
+		void begin(Kind kind, std::string const & name);
+		void begin(ProfileSourceEntry * entry);
+		void end();
+
+		ProfileSource & operator = (ProfileSource const &);
+
+		ProfileSourceEntry * _entry;
+		ProfileSource      * _outer;
+
+		// The statement's line, or NULL for compound objects and functions.
+		std::string const * _file;
+		int                 _line;
+
+		long long int _start;
+
+		// Time spent in the entries made inside this one.
+		long long int _inner;
+};
+
+/*
+	Returns the name used for a file in the source profile.
+*/
+std::string const * profile_source_file(std::string const & name);
+
+/*
+	For scopes on other threads: the node they go in, for the thread that
+	calls them.
+*/
+ProfileNode * profile_get_current();
+void profile_set_current(ProfileNode * node);
+
+/*
+	While threads are making scopes, they have to lock the tree.
+*/
+void profile_set_shared(bool shared);
+
+/*
+	Prints the tree as text, or as JSON.
+*/
+void print_profile(std::ostream & out, bool json);
+
+/*
+	Writes every traced scope as Chrome trace-event JSON.
+*/
+void print_trace(std::ostream & out);
+
+/*
+	Prints the count entries of the source profile with the most time.
+*/
+void print_profile_source(std::ostream & out, size_t count);
+
+
+
+#endif /* PROFILE_H */
+
+
+
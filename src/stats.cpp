@@ -0,0 +1,230 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	2026/10/17 - Original version.
+*/
+
+#include "stats.hpp"
+
+#include "types.hpp"
+
+#include "LevelObject/LevelObjectType.hpp"
+
+#include "../common/foreach.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#if USE_THREADS
+#include <mutex>
+#endif
+
+
+
+struct StatsObjects
+{
+	unsigned long int created;
+	unsigned long int destroyed;
+};
+
+
+
+// Counters are usually statics, so this has to be set before any
+// constructor runs. Being zero-initialized, it is.
+StatsCounter * StatsCounter::_first;
+
+bool StatsCounter::enabled = false;
+
+typedef std::map<type_t, StatsObjects> stats_objects_t;
+
+static stats_objects_t stats_objects;
+
+static unsigned long int stats_objects_live = 0;
+static unsigned long int stats_objects_peak = 0;
+
+#if USE_THREADS
+// Counters made as function statics are added while threads run.
+static std::mutex & stats_mutex()
+{
+	static std::mutex mutex;
+
+	return mutex;
+}
+#endif
+
+
+
+StatsCounter::StatsCounter(char const * group, char const * name) : _group(group), _name(name), _count(0)
+{
+	#if USE_THREADS
+	std::lock_guard<std::mutex> lock(stats_mutex());
+	#endif
+
+	_next  = _first;
+	_first = this;
+}
+
+void StatsCounter::increase(unsigned long int count)
+{
+	#if USE_THREADS
+	std::lock_guard<std::mutex> lock(stats_mutex());
+	#endif
+
+	_count += count;
+}
+
+
+
+static StatsObjects & stats_object_find(type_t const & type)
+{
+	stats_objects_t::iterator it(stats_objects.find(type));
+
+	if (it == stats_objects.end())
+	{
+		StatsObjects objects = {0, 0};
+		it = stats_objects.insert(std::make_pair(type, objects)).first;
+	}
+
+	return it->second;
+}
+
+void stats_object_count(type_t const & type, bool create)
+{
+	StatsObjects & objects = stats_object_find(type);
+
+	if (create)
+	{
+		++objects.created;
+
+		if (++stats_objects_live > stats_objects_peak)
+			stats_objects_peak = stats_objects_live;
+	}
+	else
+	{
+		++objects.destroyed;
+
+		// Objects made before counting started can still be freed.
+		if (stats_objects_live) --stats_objects_live;
+	}
+}
+
+
+
+static bool stats_compare(StatsCounter const * left, StatsCounter const * right)
+{
+	int group = std::strcmp(left->getGroup(), right->getGroup());
+
+	if (group) return group < 0;
+
+	return std::strcmp(left->getName(), right->getName()) < 0;
+}
+
+static void print_stats_json_string(std::ostream & out, std::string const & s)
+{
+	out << '"';
+
+	FOREACH_T_CONST(std::string, it, s)
+	{
+		if (*it == '"' || *it == '\\')
+			out << '\\';
+
+		out << *it;
+	}
+
+	out << '"';
+}
+
+void print_stats(std::ostream & out, bool json)
+{
+	std::vector<StatsCounter const *> counters;
+
+	for (StatsCounter const * counter = StatsCounter::_first; counter; counter = counter->_next)
+		counters.push_back(counter);
+
+	std::stable_sort(counters.begin(), counters.end(), stats_compare);
+
+	unsigned long int created = 0, destroyed = 0;
+
+	FOREACH_T_CONST(stats_objects_t, it, stats_objects)
+	{
+		created   += it->second.created;
+		destroyed += it->second.destroyed;
+	}
+
+	if (json)
+	{
+		out << "{\"objects\":{\"created\":" << created << ",\"destroyed\":" << destroyed
+		    << ",\"peak\":" << stats_objects_peak << ",\"types\":{";
+
+		FOREACH_T_CONST(stats_objects_t, it, stats_objects)
+		{
+			if (it != stats_objects.begin()) out << ',';
+
+			print_stats_json_string(out, it->first.makeString());
+			out << ":{\"created\":" << it->second.created << ",\"destroyed\":" << it->second.destroyed << '}';
+		}
+
+		out << "}},\"counters\":{";
+
+		FOREACH_T_CONST(std::vector<StatsCounter const *>, it, counters)
+		{
+			bool first = it == counters.begin();
+			bool group = first || std::strcmp((*it)->_group, it[-1]->_group) != 0;
+
+			if (group)
+			{
+				if (!first) out << "},";
+
+				print_stats_json_string(out, (*it)->_group);
+				out << ":{";
+			}
+			else
+				out << ',';
+
+			print_stats_json_string(out, (*it)->_name);
+			out << ':' << (*it)->_count;
+		}
+
+		if (!counters.empty()) out << '}';
+
+		out << "}}\n";
+	}
+	else
+	{
+		out << "stats:LevelObject:created=" << created << ":destroyed=" << destroyed
+		    << ":peak=" << stats_objects_peak << ";\n";
+
+		FOREACH_T_CONST(stats_objects_t, it, stats_objects)
+		{
+			out << "stats:LevelObject:" << it->first.makeString()
+			    << ":created="   << it->second.created
+			    << ":destroyed=" << it->second.destroyed << ";\n";
+		}
+
+		FOREACH_T_CONST(std::vector<StatsCounter const *>, it, counters)
+			out << "stats:" << (*it)->_group << ':' << (*it)->_name << '=' << (*it)->_count << ";\n";
+	}
+}
+
+
+
@@ -0,0 +1,107 @@
+/*
+    Copyright 2010 David Hill
+
+    This file is part of DH-dlc.
+
+    DH-dlc is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DH-dlc is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DH-dlc.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+	Counts of what the compile does, for --debug-stats. A StatsCounter is
+	made as a static, and adds itself to the list that print_stats() prints,
+	like an Arena. Counting costs a single test while it is off, and may be
+	done on any thread.
+
+	LevelObjects are also counted by their type, with the most that were
+	alive at once. They are only made and freed on the compiling thread, the
+	same as their arena.
+
+	2026/10/17 - Original version.
+*/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <ostream>
+
+
+
+class LevelObjectType;
+
+class StatsCounter
+{
+	public:
+		/*
+			Counters are printed by group, then name. Neither is copied.
+		*/
+		StatsCounter(char const * group, char const * name);
+
+		void add(unsigned long int count = 1)
+		{
+			if (enabled) increase(count);
+		}
+
+		unsigned long int getCount() const {return _count;}
+
+		char const * getGroup() const {return _group;}
+		char const * getName()  const {return _name;}
+
+		// Set once the options are read.
+		static bool enabled;
+
+		friend void print_stats(std::ostream &, bool);
+
+	private:
+		StatsCounter(StatsCounter const &);
+
+		void increase(unsigned long int count);
+
+		StatsCounter & operator = (StatsCounter const &);
+
+		char const * _group;
+		char const * _name;
+
+		unsigned long int _count;
+
+		StatsCounter * _next;
+
+		static StatsCounter * _first;
+};
+
+/*
+	LevelObjects count themselves with these, by the type they have when they
+	are made and when they are freed.
+*/
+void stats_object_count(LevelObjectType const & type, bool create);
+
+inline void stats_object_create(LevelObjectType const & type)
+{
+	if (StatsCounter::enabled) stats_object_count(type, true);
+}
+inline void stats_object_destroy(LevelObjectType const & type)
+{
+	if (StatsCounter::enabled) stats_object_count(type, false);
+}
+
+/*
+	Prints every counter as text, or as JSON.
+*/
+void print_stats(std::ostream & out, bool json);
+
+
+
+#endif /* STATS_H */
+
+
+
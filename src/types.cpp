@@ -27,6 +27,9 @@
 	2010/05/07 - Removed bounds checking from converters. Not sure how
 		useful they were to begin with. If someone comes up with a
 		convincing reason, they'll be added back as an option.
+	2026/10/17 - make_string<int_s_t> no longer uses a stream, as it makes
+		every dynamic name.
+	2026/10/17 - make_string is counted for --debug-stats.
 */
 
 #include "types.hpp"
@@ -66,41 +69,74 @@ T from_obj_t(obj_t o)
 		return convert<T, any_t>(o->getData());
 }
 
+StatsCounter stats_make_string("types", "make_string");
+
 template<class T>
 std::string make_string(T const & in);
 template<>
 std::string make_string<bool_t>(bool_t const & in)
 {
+	stats_make_string.add();
+
 	return in ? misc_name_true() : misc_name_false();
 }
 template<>
+std::string make_string<int_s_t>(int_s_t const & in)
+{
+	stats_make_string.add();
+
+	char buffer[24];
+	char * begin = buffer + sizeof(buffer);
+
+	// Unsigned, so that the lowest value can be negated.
+	unsigned long long value = in < 0 ? 0ULL - (unsigned long long)in : in;
+
+	do *--begin = char('0' + value % 10); while (value /= 10);
+
+	if (in < 0) *--begin = '-';
+
+	return std::string(begin, buffer + sizeof(buffer));
+}
+template<>
 std::string make_string<string_t>(string_t const & in)
 {
+	stats_make_string.add();
+
 	return in.makeString();
 }
 template<>
 std::string make_string<string8_t>(string8_t const & in)
 {
+	stats_make_string.add();
+
 	return in.makeString();
 }
 template<>
 std::string make_string<string16_t>(string16_t const & in)
 {
+	stats_make_string.add();
+
 	return in.makeString();
 }
 template<>
 std::string make_string<string32_t>(string32_t const & in)
 {
+	stats_make_string.add();
+
 	return in.makeString();
 }
 template<>
 std::string make_string<string80_t>(string80_t const & in)
 {
+	stats_make_string.add();
+
 	return in.makeString();
 }
 template<>
 std::string make_string<string320_t>(string320_t const & in)
 {
+	stats_make_string.add();
+
 	return in.makeString();
 }
 
@@ -332,6 +368,17 @@ template<> int_s_t convert<int_s_t, uword_t>    (uword_t     const & value) {ret
 template<> int_s_t convert<int_s_t, sdword_t>   (sdword_t    const & value) {return int_s_t(value.makeInt());}
 template<> int_s_t convert<int_s_t, udword_t>   (udword_t    const & value) {return int_s_t(value.makeInt());}
 
+#if USE_GMPLIB
+// Truncates, the same as mpz_class.
+template<typename T>
+static int_gmp_t int_from_real(real_gmp_t<T> const & value)
+{
+	if (value.fits_sll()) return int_gmp_t((int_s_t)value.get_d());
+
+	return int_gmp_t(value.get_mpz());
+}
+#endif
+
 template<> int_t convert<int_t, any_t>      (any_t       const & value) {return value.toInt();}
 template<> int_t convert<int_t, bool_t>     (bool_t      const & value) {return int_t((int_s_t)value);}
 template<> int_t convert<int_t, int_s_t>    (int_s_t     const & value) {return int_t(value);}
@@ -339,8 +386,13 @@ template<> int_t convert<int_t, int_t>      (int_t       const & value) {return
 template<> int_t convert<int_t, int_l_t>    (int_l_t     const & value) {return int_t(value._data);}
 template<> int_t convert<int_t, obj_t>      (obj_t       const & value) {return from_obj_t<int_t>(value);}
 template<> int_t convert<int_t, real_s_t>   (real_s_t    const & value) {return int_t(value);}
+#if USE_GMPLIB
+template<> int_t convert<int_t, real_t>     (real_t      const & value) {return int_t(int_from_real(value._data));}
+template<> int_t convert<int_t, real_l_t>   (real_l_t    const & value) {return int_t(int_from_real(value._data));}
+#else
 template<> int_t convert<int_t, real_t>     (real_t      const & value) {return int_t(value._data);}
 template<> int_t convert<int_t, real_l_t>   (real_l_t    const & value) {return int_t(value._data);}
+#endif
 template<> int_t convert<int_t, string_t>   (string_t    const & value) {return num_from_string<int_t>(value.makeString());}
 template<> int_t convert<int_t, string8_t>  (string8_t   const & value) {return num_from_string<int_t>(value.makeString());}
 template<> int_t convert<int_t, string16_t> (string16_t  const & value) {return num_from_string<int_t>(value.makeString());}
@@ -360,8 +412,13 @@ template<> int_l_t convert<int_l_t, int_t>      (int_t       const & value) {ret
 template<> int_l_t convert<int_l_t, int_l_t>    (int_l_t     const & value) {return value;}
 template<> int_l_t convert<int_l_t, obj_t>      (obj_t       const & value) {return from_obj_t<int_l_t>(value);}
 template<> int_l_t convert<int_l_t, real_s_t>   (real_s_t    const & value) {return int_l_t(value);}
+#if USE_GMPLIB
+template<> int_l_t convert<int_l_t, real_t>     (real_t      const & value) {return int_l_t(int_from_real(value._data));}
+template<> int_l_t convert<int_l_t, real_l_t>   (real_l_t    const & value) {return int_l_t(int_from_real(value._data));}
+#else
 template<> int_l_t convert<int_l_t, real_t>     (real_t      const & value) {return int_l_t(value._data);}
 template<> int_l_t convert<int_l_t, real_l_t>   (real_l_t    const & value) {return int_l_t(value._data);}
+#endif
 template<> int_l_t convert<int_l_t, string_t>   (string_t    const & value) {return num_from_string<int_l_t>(value.makeString());}
 template<> int_l_t convert<int_l_t, string8_t>  (string8_t   const & value) {return num_from_string<int_l_t>(value.makeString());}
 template<> int_l_t convert<int_l_t, string16_t> (string16_t  const & value) {return num_from_string<int_l_t>(value.makeString());}
@@ -419,8 +476,13 @@ template<> real_s_t convert<real_s_t, udword_t>   (udword_t    const & value) {r
 template<> real_t convert<real_t, any_t>      (any_t       const & value) {return value.toReal();}
 template<> real_t convert<real_t, bool_t>     (bool_t      const & value) {return real_t((int)value);}
 template<> real_t convert<real_t, int_s_t>    (int_s_t     const & value) {return real_t(value);}
+#if USE_GMPLIB
+template<> real_t convert<real_t, int_t>      (int_t       const & value) {return real_t(mpf_class(value._data.get_mpz()));}
+template<> real_t convert<real_t, int_l_t>    (int_l_t     const & value) {return real_t(mpf_class(value._data.get_mpz()));}
+#else
 template<> real_t convert<real_t, int_t>      (int_t       const & value) {return real_t(value._data);}
 template<> real_t convert<real_t, int_l_t>    (int_l_t     const & value) {return real_t(value._data);}
+#endif
 template<> real_t convert<real_t, obj_t>      (obj_t       const & value) {return from_obj_t<real_t>(value);}
 template<> real_t convert<real_t, real_s_t>   (real_s_t    const & value) {return real_t(value);}
 template<> real_t convert<real_t, real_t>     (real_t      const & value) {return value;}
@@ -434,14 +496,19 @@ template<> real_t convert<real_t, string320_t>(string320_t const & value) {retur
 template<> real_t convert<real_t, ubyte_t>    (ubyte_t     const & value) {return real_t(value.makeInt());}
 template<> real_t convert<real_t, sword_t>    (sword_t     const & value) {return real_t(value.makeInt());}
 template<> real_t convert<real_t, uword_t>    (uword_t     const & value) {return real_t(value.makeInt());}
-template<> real_t convert<real_t, sdword_t>   (sdword_t    const & value) {return real_t(value.makeInt());}
-template<> real_t convert<real_t, udword_t>   (udword_t    const & value) {return real_t(value.makeInt());}
+template<> real_t convert<real_t, sdword_t>   (sdword_t    const & value) {return real_t((int_s_t)value.makeInt());}
+template<> real_t convert<real_t, udword_t>   (udword_t    const & value) {return real_t((int_s_t)value.makeInt());}
 
 template<> real_l_t convert<real_l_t, any_t>      (any_t       const & value) {return value.toRealLong();}
 template<> real_l_t convert<real_l_t, bool_t>     (bool_t      const & value) {return real_l_t((int)value);}
 template<> real_l_t convert<real_l_t, int_s_t>    (int_s_t     const & value) {return real_l_t(value);}
+#if USE_GMPLIB
+template<> real_l_t convert<real_l_t, int_t>      (int_t       const & value) {return real_l_t(mpq_class(value._data.get_mpz()));}
+template<> real_l_t convert<real_l_t, int_l_t>    (int_l_t     const & value) {return real_l_t(mpq_class(value._data.get_mpz()));}
+#else
 template<> real_l_t convert<real_l_t, int_t>      (int_t       const & value) {return real_l_t(value._data);}
 template<> real_l_t convert<real_l_t, int_l_t>    (int_l_t     const & value) {return real_l_t(value._data);}
+#endif
 template<> real_l_t convert<real_l_t, obj_t>      (obj_t       const & value) {return from_obj_t<real_l_t>(value);}
 template<> real_l_t convert<real_l_t, real_s_t>   (real_s_t    const & value) {return real_l_t(value);}
 template<> real_l_t convert<real_l_t, real_t>     (real_t      const & value) {return real_l_t(value._data);}
@@ -455,8 +522,8 @@ template<> real_l_t convert<real_l_t, string320_t>(string320_t const & value) {r
 template<> real_l_t convert<real_l_t, ubyte_t>    (ubyte_t     const & value) {return real_l_t(value.makeInt());}
 template<> real_l_t convert<real_l_t, sword_t>    (sword_t     const & value) {return real_l_t(value.makeInt());}
 template<> real_l_t convert<real_l_t, uword_t>    (uword_t     const & value) {return real_l_t(value.makeInt());}
-template<> real_l_t convert<real_l_t, sdword_t>   (sdword_t    const & value) {return real_l_t(value.makeInt());}
-template<> real_l_t convert<real_l_t, udword_t>   (udword_t    const & value) {return real_l_t(value.makeInt());}
+template<> real_l_t convert<real_l_t, sdword_t>   (sdword_t    const & value) {return real_l_t((int_s_t)value.makeInt());}
+template<> real_l_t convert<real_l_t, udword_t>   (udword_t    const & value) {return real_l_t((int_s_t)value.makeInt());}
 
 template<> string_t convert<string_t, any_t>      (any_t       const & value) {return value.toString();}
 template<> string_t convert<string_t, bool_t>     (bool_t      const & value) {return string_t(make_string(value));}
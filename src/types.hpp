@@ -32,11 +32,15 @@
 	2010/05/05 - Moved int_t to its own file.
 	2010/05/06 - No more inline functions here, mostly because of the new
 		types. (Circular dependencies make me weep.)
+	2026/10/17 - Added USE_THREADS.
+	2026/10/17 - make_string is counted for --debug-stats.
 */
 
 #ifndef TYPES_H
 #define TYPES_H
 
+#include "stats.hpp"
+
 #include <cfloat>
 #include <climits>
 #include <sstream>
@@ -44,6 +48,18 @@
 
 
 
+// Output is encoded, and nodes, BLOCKMAP, and REJECT built, on several
+// threads, if std::thread is available.
+#ifndef USE_THREADS
+#if __cplusplus >= 201103L && defined(__GNUC__)
+#define USE_THREADS 1
+#else
+#define USE_THREADS 0
+#endif
+#endif
+
+
+
 #define  int_s_t_MAX  LLONG_MAX
 #define  int_s_t_MIN  LLONG_MIN
 #define uint_s_t_MAX ULLONG_MAX
@@ -118,9 +134,13 @@ typedef LevelObjectType type_t;
 
 
 
+extern StatsCounter stats_make_string;
+
 template<class T>
 std::string make_string(T const & in)
 {
+	stats_make_string.add();
+
 	std::ostringstream oss;
 
 	oss.precision(255);
@@ -132,6 +152,8 @@ std::string make_string(T const & in)
 template<>
 std::string make_string<bool_t>(bool_t const & in);
 template<>
+std::string make_string<int_s_t>(int_s_t const & in);
+template<>
 std::string make_string<string_t>(string_t const & in);
 template<>
 std::string make_string<string8_t>(string8_t const & in);
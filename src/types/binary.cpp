@@ -19,10 +19,13 @@
 
 /*
 	2010/05/09 - Original version.
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #include "binary.hpp"
 
+#include "../TextWriter.hpp"
+
 
 
 template <size_t S>
@@ -93,6 +96,11 @@ void stringf_t<S>::encodeText(std::ostream & out)
 
 	out.put('"');
 }
+template <size_t S>
+void stringf_t<S>::encodeText(TextWriter & out)
+{
+	out.writeQuoted(_data, S);
+}
 
 template <size_t S>
 stringf_t<S> & stringf_t<S>::operator += (stringf_t<S> const & value)
@@ -134,6 +142,10 @@ void ubyte_t::encodeText(std::ostream & out)
 {
 	out << _data;
 }
+void ubyte_t::encodeText(TextWriter & out)
+{
+	out.writeUInt(_data);
+}
 
 sword_t::sword_t() : _data(0) {}
 sword_t::sword_t(sword_t const & value) : _data(value._data) {}
@@ -148,6 +160,10 @@ void sword_t::encodeText(std::ostream & out)
 {
 	out << _data;
 }
+void sword_t::encodeText(TextWriter & out)
+{
+	out.writeInt(_data);
+}
 
 uword_t::uword_t() : _data(0) {}
 uword_t::uword_t(uword_t const & value) : _data(value._data) {}
@@ -162,6 +178,10 @@ void uword_t::encodeText(std::ostream & out)
 {
 	out << _data;
 }
+void uword_t::encodeText(TextWriter & out)
+{
+	out.writeUInt(_data);
+}
 
 sdword_t::sdword_t() : _data(0) {}
 sdword_t::sdword_t(sdword_t const & value) : _data(value._data) {}
@@ -178,6 +198,10 @@ void sdword_t::encodeText(std::ostream & out)
 {
 	out << _data;
 }
+void sdword_t::encodeText(TextWriter & out)
+{
+	out.writeInt(_data);
+}
 
 udword_t::udword_t() : _data(0) {}
 udword_t::udword_t(udword_t const & value) : _data(value._data) {}
@@ -194,6 +218,10 @@ void udword_t::encodeText(std::ostream & out)
 {
 	out << _data;
 }
+void udword_t::encodeText(TextWriter & out)
+{
+	out.writeUInt(_data);
+}
 
 
 
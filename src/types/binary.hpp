@@ -30,6 +30,7 @@
 	2010/05/09 - Original version.
 	2010/06/24 - Added abs, sqrt, and hypot for the numeric classes so that
 		they can be treated like the other int classes.
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #ifndef TYPES__BINARY_H
@@ -39,6 +40,8 @@
 #include <ostream>
 #include <string>
 
+class TextWriter;
+
 
 
 /*
@@ -57,6 +60,7 @@ class stringf_t
 
 		void encodeBinary(std::ostream & out);
 		void encodeText  (std::ostream & out);
+		void encodeText  (TextWriter   & out);
 
 		std::string makeString() const {return std::string(_data, S);}
 
@@ -102,6 +106,7 @@ class ubyte_t
 
 		void encodeBinary(std::ostream & out);
 		void encodeText  (std::ostream & out);
+		void encodeText  (TextWriter   & out);
 
 		unsigned char makeInt() const {return _data;}
 
@@ -136,6 +141,7 @@ class sword_t
 
 		void encodeBinary(std::ostream & out);
 		void encodeText  (std::ostream & out);
+		void encodeText  (TextWriter   & out);
 
 		signed short int makeInt() const {return _data;}
 
@@ -170,6 +176,7 @@ class uword_t
 
 		void encodeBinary(std::ostream & out);
 		void encodeText  (std::ostream & out);
+		void encodeText  (TextWriter   & out);
 
 		unsigned short int makeInt() const {return _data;}
 
@@ -204,6 +211,7 @@ class sdword_t
 
 		void encodeBinary(std::ostream & out);
 		void encodeText  (std::ostream & out);
+		void encodeText  (TextWriter   & out);
 
 		signed long int makeInt() const {return _data;}
 
@@ -238,6 +246,7 @@ class udword_t
 
 		void encodeBinary(std::ostream & out);
 		void encodeText  (std::ostream & out);
+		void encodeText  (TextWriter   & out);
 
 		unsigned long int makeInt() const {return _data;}
 
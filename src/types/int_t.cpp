@@ -19,16 +19,80 @@
 
 /*
 	2010/05/05 - Original version.
+	2026/10/17 - Added int_gmp_t.
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #include "int_t.hpp"
 
 #include "../options.hpp"
+#include "../TextWriter.hpp"
+
+
+
+#if USE_GMPLIB
+mpz_class int_gmp_t::get_mpz() const
+{
+	if (_big) return *_big;
+
+	if (_small >= LONG_MIN && _small <= LONG_MAX)
+		return mpz_class(long(_small));
+
+	// long is smaller than long long, so build it in two halves.
+	mpz_class value(long(_small >> 32));
+
+	value <<= 32;
+	value += (unsigned long)(_small & 0xFFFFFFFFLL);
+
+	return value;
+}
+
+void int_gmp_t::set(mpz_class const & v)
+{
+	if (v.fits_slong_p())
+	{
+		delete _big;
+		_big   = NULL;
+		_small = v.get_si();
+	}
+	else if (_big)
+		*_big = v;
+	else
+		_big = new mpz_class(v);
+}
+
+int_gmp_t abs(int_gmp_t const & value)
+{
+	if (value._big || value._small == LLONG_MIN)
+		return int_gmp_t(mpz_class(abs(value.get_mpz())));
+
+	return int_gmp_t(value._small < 0 ? -value._small : value._small);
+}
+
+int_gmp_t sqrt(int_gmp_t const & value)
+{
+	return int_gmp_t(mpz_class(sqrt(value.get_mpz())));
+}
+#endif
 
 void int_t::encodeText(std::ostream & out)
 {
 	out << _data;
 }
+void int_t::encodeText(TextWriter & out)
+{
+	#if USE_GMPLIB
+	if (!_data.fits_sll())
+	{
+		out.stream() << _data;
+		return;
+	}
+
+	out.writeInt(_data.get_sll());
+	#else
+	out.writeInt(_data);
+	#endif
+}
 
 long double int_t::makeFloat() const
 {
@@ -54,6 +118,20 @@ void int_l_t::encodeText(std::ostream & out)
 {
 	out << _data;
 }
+void int_l_t::encodeText(TextWriter & out)
+{
+	#if USE_GMPLIB
+	if (!_data.fits_sll())
+	{
+		out.stream() << _data;
+		return;
+	}
+
+	out.writeInt(_data.get_sll());
+	#else
+	out.writeInt(_data);
+	#endif
+}
 
 long double int_l_t::makeFloat() const
 {
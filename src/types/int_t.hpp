@@ -19,6 +19,9 @@
 
 /*
 	2010/05/05 - Original version.
+	2026/10/17 - With GMP, values are kept in a long long until they
+		overflow it (int_gmp_t).
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #ifndef INT_T_H
@@ -29,6 +32,7 @@
 
 #include <ostream>
 #if USE_GMPLIB
+#include <climits>
 #include <gmpxx.h>
 #else
 #include <cmath>
@@ -42,6 +46,157 @@ class int_l_t;
 typedef double real_s_t;
 class real_t;
 class real_l_t;
+class TextWriter;
+
+
+
+#if USE_GMPLIB
+/*
+	An integer of unlimited size that only uses GMP when it has to. Values
+	that fit in a long long are kept there, and every operation on them is
+	checked for overflow. A result that does not fit is made with mpz_class
+	instead, and goes back to a long long when it fits again.
+*/
+class int_gmp_t
+{
+	public:
+		int_gmp_t() : _small(0), _big(NULL) {}
+		int_gmp_t(int_gmp_t     const & v) : _small(v._small), _big(v._big ? new mpz_class(*v._big) : NULL) {}
+		int_gmp_t(long long int const & v) : _small(v), _big(NULL) {}
+		int_gmp_t(mpz_class     const & v) : _small(0), _big(NULL) {set(v);}
+		int_gmp_t(mpf_class     const & v) : _small(0), _big(NULL) {set(mpz_class(v));}
+		int_gmp_t(mpq_class     const & v) : _small(0), _big(NULL) {set(mpz_class(v));}
+		~int_gmp_t() {delete _big;}
+
+		double get_d() const {return _big ? _big->get_d() : double(_small);}
+		long get_si() const {return _big ? _big->get_si() : long(_small);}
+		// Only meaningful if fits_sll().
+		long long int get_sll() const {return _small;}
+		bool fits_sll() const {return !_big;}
+		mpz_class get_mpz() const;
+
+		int_gmp_t & operator &= (int_gmp_t const & v);
+		int_gmp_t & operator |= (int_gmp_t const & v);
+		int_gmp_t & operator *= (int_gmp_t const & v);
+		int_gmp_t & operator /= (int_gmp_t const & v);
+		int_gmp_t & operator %= (int_gmp_t const & v);
+		int_gmp_t & operator += (int_gmp_t const & v);
+		int_gmp_t & operator -= (int_gmp_t const & v);
+		int_gmp_t & operator  = (int_gmp_t const & v);
+
+		friend int_gmp_t abs(int_gmp_t const &);
+
+		friend int cmp(int_gmp_t const &, int_gmp_t const &);
+
+		friend std::ostream & operator << (std::ostream &, int_gmp_t const &);
+
+	private:
+		void set(mpz_class const & v);
+
+		long long int _small;
+
+		// Only used when the value does not fit in _small.
+		mpz_class * _big;
+};
+
+int_gmp_t abs(int_gmp_t const &);
+
+int cmp(int_gmp_t const &, int_gmp_t const &);
+
+int_gmp_t sqrt(int_gmp_t const &);
+
+std::ostream & operator << (std::ostream &, int_gmp_t const &);
+
+
+
+inline int_gmp_t & int_gmp_t::operator &= (int_gmp_t const & v)
+{
+	if (!_big && !v._big) _small &= v._small; else set(get_mpz() & v.get_mpz());
+
+	return *this;
+}
+inline int_gmp_t & int_gmp_t::operator |= (int_gmp_t const & v)
+{
+	if (!_big && !v._big) _small |= v._small; else set(get_mpz() | v.get_mpz());
+
+	return *this;
+}
+inline int_gmp_t & int_gmp_t::operator *= (int_gmp_t const & v)
+{
+	long long int result;
+
+	if (_big || v._big || __builtin_mul_overflow(_small, v._small, &result))
+		set(get_mpz() * v.get_mpz());
+	else
+		_small = result;
+
+	return *this;
+}
+inline int_gmp_t & int_gmp_t::operator /= (int_gmp_t const & v)
+{
+	// LLONG_MIN / -1 is the only quotient that can overflow.
+	if (!_big && !v._big && !(_small == LLONG_MIN && v._small == -1))
+		_small /= v._small;
+	else
+		set(get_mpz() / v.get_mpz());
+
+	return *this;
+}
+inline int_gmp_t & int_gmp_t::operator %= (int_gmp_t const & v)
+{
+	if (!_big && !v._big)
+		_small = v._small == -1 ? 0 : _small % v._small;
+	else
+		set(get_mpz() % v.get_mpz());
+
+	return *this;
+}
+inline int_gmp_t & int_gmp_t::operator += (int_gmp_t const & v)
+{
+	long long int result;
+
+	if (_big || v._big || __builtin_add_overflow(_small, v._small, &result))
+		set(get_mpz() + v.get_mpz());
+	else
+		_small = result;
+
+	return *this;
+}
+inline int_gmp_t & int_gmp_t::operator -= (int_gmp_t const & v)
+{
+	long long int result;
+
+	if (_big || v._big || __builtin_sub_overflow(_small, v._small, &result))
+		set(get_mpz() - v.get_mpz());
+	else
+		_small = result;
+
+	return *this;
+}
+inline int_gmp_t & int_gmp_t::operator = (int_gmp_t const & v)
+{
+	if (v._big) set(*v._big); else {delete _big; _big = NULL; _small = v._small;}
+
+	return *this;
+}
+
+inline int cmp(int_gmp_t const & l, int_gmp_t const & r)
+{
+	if (l._big || r._big) return cmp(l.get_mpz(), r.get_mpz());
+
+	if (l._small > r._small) return +1;
+	if (l._small < r._small) return -1;
+
+	return 0;
+}
+
+inline std::ostream & operator << (std::ostream & out, int_gmp_t const & in)
+{
+	if (in._big) return out << *in._big;
+
+	return out << in._small;
+}
+#endif
 
 
 
@@ -50,13 +205,13 @@ class int_t
 	public:
 		explicit int_t() : _data(0) {}
 		         int_t(int_t         const & v) : _data(v._data) {}
-		#if USE_GMPLIB
-		explicit int_t(mpz_class     const & v) : _data(v) {}
-		#else
 		explicit int_t(long long int const & v) : _data(v) {}
+		#if USE_GMPLIB
+		explicit int_t(int_gmp_t     const & v) : _data(v) {}
 		#endif
 
 		void encodeText(std::ostream & out);
+		void encodeText(TextWriter   & out);
 
 		long double makeFloat() const;
 		long long int makeInt() const;
@@ -88,7 +243,7 @@ class int_t
 
 	private:
 		#if USE_GMPLIB
-		mpz_class _data;
+		int_gmp_t _data;
 		#else
 		long long int _data;
 		#endif
@@ -99,13 +254,13 @@ class int_l_t
 	public:
 		explicit int_l_t() : _data(0) {}
 		         int_l_t(int_l_t       const & v) : _data(v._data) {}
-		#if USE_GMPLIB
-		explicit int_l_t(mpz_class     const & v) : _data(v) {}
-		#else
 		explicit int_l_t(long long int const & v) : _data(v) {}
+		#if USE_GMPLIB
+		explicit int_l_t(int_gmp_t     const & v) : _data(v) {}
 		#endif
 
 		void encodeText(std::ostream & out);
+		void encodeText(TextWriter   & out);
 
 		long double makeFloat() const;
 		long long int makeInt() const;
@@ -136,7 +291,7 @@ class int_l_t
 
 	private:
 		#if USE_GMPLIB
-		mpz_class _data;
+		int_gmp_t _data;
 		#else
 		long long int _data;
 		#endif
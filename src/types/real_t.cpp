@@ -19,18 +19,136 @@
 
 /*
 	2010/05/06 - Original version.
+	2026/10/17 - Added real_gmp_t.
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #include <cmath>
 
 #include "real_t.hpp"
 
+#include "../TextWriter.hpp"
 
 
+
+#if USE_GMPLIB
+template <typename T>
+static real_gmp_t<T> real_gmp_from_sll(long long int v)
+{
+	double d(v);
+
+	if (d < 9007199254740992.0 && d > -9007199254740992.0)
+		return real_gmp_t<T>(d);
+
+	// Too many bits for a double, so build it in two halves.
+	T big(double(v >> 32));
+
+	big *= 4294967296.0;
+	big += double(v & 0xFFFFFFFFLL);
+
+	return real_gmp_t<T>(big);
+}
+
+template<> bool real_gmp_t<mpf_class>::fits(mpf_class const & v, double & d)
+{
+	d = v.get_d();
+
+	// get_d truncates, so it is only the same value if the value fits.
+	return __builtin_isfinite(d) && cmp(v, d) == 0;
+}
+template<> bool real_gmp_t<mpq_class>::fits(mpq_class const & v, double & d)
+{
+	mpz_srcptr num(v.get_num_mpz_t());
+	mpz_srcptr den(v.get_den_mpz_t());
+
+	size_t denBits(mpz_sizeinbase(den, 2));
+
+	// A double is at most 53 bits over a power of two.
+	if (mpz_sizeinbase(num, 2) > 53 || denBits > 1022 || mpz_scan1(den, 0) != denBits - 1)
+		return false;
+
+	d = v.get_d();
+
+	return true;
+}
+
+template <typename T>
+void real_gmp_t<T>::set(T const & v)
+{
+	double d;
+
+	if (fits(v, d))
+	{
+		delete _big;
+		_big   = NULL;
+		_small = d;
+	}
+	else if (_big)
+		*_big = v;
+	else
+		_big = new T(v);
+}
+
+template <typename T>
+void real_gmp_t<T>::shrink()
+{
+	double d;
+
+	if (!fits(*_big, d)) return;
+
+	delete _big;
+	_big   = NULL;
+	_small = d;
+}
+
+template class real_gmp_t<mpf_class>;
+template class real_gmp_t<mpq_class>;
+
+real_t::real_t(long long int const & v) : _data(real_gmp_from_sll<mpf_class>(v))
+{
+
+}
+
+real_l_t::real_l_t(long long int const & v) : _data(real_gmp_from_sll<mpq_class>(v))
+{
+
+}
+#endif
+
+#if USE_GMPLIB
+/*
+	Exact integers that a double can hold print the same from GMP as they do
+	as integers, so those do not need to go through the stream.
+*/
+template <typename T>
+static bool real_gmp_write(real_gmp_t<T> const & v, TextWriter & out)
+{
+	if (!v.is_small()) return false;
+
+	double d(v.get_d());
+
+	if (d != std::floor(d) || d >= 9007199254740992.0 || d <= -9007199254740992.0)
+		return false;
+
+	out.writeInt(static_cast<long long int>(d));
+
+	return true;
+}
+#endif
+
 void real_t::encodeText(std::ostream & out)
 {
 	out.precision(256);
-	out << _data;
+	out << *this;
+}
+void real_t::encodeText(TextWriter & out)
+{
+	#if USE_GMPLIB
+	if (!real_gmp_write(_data, out))
+		encodeText(out.stream());
+	#else
+	out.writeReal(_data);
+	#endif
 }
 
 long double real_t::makeFloat() const
@@ -45,7 +163,9 @@ long double real_t::makeFloat() const
 long long int real_t::makeInt() const
 {
 	#if USE_GMPLIB
-	return _data.get_si();
+	if (_data.fits_sll()) return (long long int)_data.get_d();
+
+	return _data.get_big().get_si();
 	#else
 	return _data;
 	#endif
@@ -56,10 +176,15 @@ long long int real_t::makeInt() const
 void real_l_t::encodeText(std::ostream & out)
 {
 	out.precision(256);
+	out << *this;
+}
+void real_l_t::encodeText(TextWriter & out)
+{
 	#if USE_GMPLIB
-	out << mpf_class(_data);
+	if (!real_gmp_write(_data, out))
+		encodeText(out.stream());
 	#else
-	out << _data;
+	out.writeReal(_data);
 	#endif
 }
 
@@ -75,7 +200,9 @@ long double real_l_t::makeFloat() const
 long long int real_l_t::makeInt() const
 {
 	#if USE_GMPLIB
-	return mpf_class(_data).get_si();
+	if (_data.fits_sll()) return (long long int)_data.get_d();
+
+	return mpf_class(_data.get_big()).get_si();
 	#else
 	return _data;
 	#endif
@@ -127,10 +254,25 @@ int cmp(real_l_t const & l, real_l_t const & r)
 	#endif
 }
 
+#if USE_GMPLIB
+real_t floor(real_t const & x)
+{
+	if (x._data.is_small())
+		return real_t(std::floor(x._data.get_d()));
+
+	return real_t(mpf_class(floor(x._data.get_big())));
+}
+#endif
 real_l_t floor(real_l_t const & x)
 {
 	#if USE_GMPLIB
-	return real_l_t(mpz_class(x._data));
+	// This truncates, the same as mpz_class.
+	double d(x._data.get_d());
+
+	if (x._data.is_small())
+		return real_l_t(d < 0 ? std::ceil(d) : std::floor(d));
+
+	return real_l_t(mpq_class(mpz_class(x._data.get_big())));
 	#else
 	return real_l_t(floor(x._data));
 	#endif
@@ -138,21 +280,41 @@ real_l_t floor(real_l_t const & x)
 
 std::ostream & operator << (std::ostream & out, real_t const & in)
 {
+	#if USE_GMPLIB
+	return out << in._data.get_big();
+	#else
 	return out << in._data;
+	#endif
 }
 std::ostream & operator << (std::ostream & out, real_l_t const & in)
 {
 	#if USE_GMPLIB
-	return out << mpf_class(in._data);
+	return out << mpf_class(in._data.get_big());
 	#else
 	return out << in._data;
 	#endif
 }
 
+#if USE_GMPLIB
+real_t sqrt(real_t const & x)
+{
+	double d(x._data.get_d());
+
+	if (x._data.is_small() && real_gmp_sqrt(d))
+		return real_t(d);
+
+	return real_t(mpf_class(sqrt(x._data.get_big())));
+}
+#endif
 real_l_t sqrt(const real_l_t& x)
 {
 	#if USE_GMPLIB
-	return real_l_t(sqrt(mpf_class(x._data)));
+	double d(x._data.get_d());
+
+	if (x._data.is_small() && real_gmp_sqrt(d))
+		return real_l_t(d);
+
+	return real_l_t(mpq_class(mpf_class(sqrt(mpf_class(x._data.get_big())))));
 
 	/*
 	real_t epsilon(1, option_precision * 8);
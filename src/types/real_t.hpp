@@ -19,6 +19,9 @@
 
 /*
 	2010/05/06 - Original version.
+	2026/10/17 - With GMP, values are kept in a double for as long as they
+		are exact (real_gmp_t).
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #ifndef REAL_T_H
@@ -29,6 +32,7 @@
 #include "../types.hpp"
 
 #if USE_GMPLIB
+#include <cfloat>
 #include <gmpxx.h>
 #else
 #include <cmath>
@@ -42,6 +46,211 @@ class int_l_t;
 typedef double real_s_t;
 class real_t;
 class real_l_t;
+class TextWriter;
+
+
+
+#if USE_GMPLIB
+// Results under this may have lost bits to underflow.
+double const real_gmp_min = DBL_MIN * 9007199254740992.0;
+
+// Doubles under this are known to fit in a long long.
+double const real_gmp_sll = 4611686018427387904.0;
+
+/*
+	Each of these does the operation on l and returns true if the result was
+	exact, leaving l unchanged if it was not. Results under real_gmp_min are
+	never counted as exact.
+*/
+inline bool real_gmp_add(double & l, double r)
+{
+	// Knuth's two-sum. err is the part of the sum that was rounded off.
+	double sum = l + r;
+	double tmp = sum - l;
+	double err = (l - (sum - tmp)) + (r - tmp);
+
+	// Also false for an overflow, which makes err NaN.
+	if (!(err == 0)) return false;
+
+	l = sum;
+
+	return true;
+}
+inline bool real_gmp_div(double & l, double r)
+{
+	if (r == 0) return false;
+
+	double quo = l / r;
+
+	if (quo == 0 ? l != 0 : (__builtin_fabs(quo) < real_gmp_min || __builtin_fabs(l) < real_gmp_min || !(__builtin_fma(quo, r, -l) == 0)))
+		return false;
+
+	l = quo;
+
+	return true;
+}
+inline bool real_gmp_mul(double & l, double r)
+{
+	double pro = l * r;
+
+	if (pro == 0 ? l != 0 && r != 0 : (__builtin_fabs(pro) < real_gmp_min || !(__builtin_fma(l, r, -pro) == 0)))
+		return false;
+
+	l = pro;
+
+	return true;
+}
+inline bool real_gmp_sqrt(double & l)
+{
+	if (l == 0) return true;
+
+	if (!(l >= real_gmp_min)) return false;
+
+	double root = __builtin_sqrt(l);
+
+	if (!(__builtin_fma(root, root, -l) == 0)) return false;
+
+	l = root;
+
+	return true;
+}
+inline bool real_gmp_sub(double & l, double r)
+{
+	return real_gmp_add(l, -r);
+}
+
+/*
+	A real number that only uses GMP when it has to. Values are kept in a
+	double for as long as every operation on them is exact, which is checked
+	after each one. A result that is not exact is made with T (mpf_class or
+	mpq_class) instead, and goes back to a double when it fits again. Since
+	the double is only ever exact, the value is always the one T would have
+	had.
+*/
+template <typename T>
+class real_gmp_t
+{
+	public:
+		real_gmp_t() : _small(0), _big(NULL) {}
+		real_gmp_t(real_gmp_t const & v) : _small(v._small), _big(v._big ? new T(*v._big) : NULL) {}
+		template <typename U>
+		explicit real_gmp_t(real_gmp_t<U> const & v) : _small(v._small), _big(v._big ? new T(*v._big) : NULL) {}
+		real_gmp_t(double    const & v) : _small(v), _big(NULL) {}
+		real_gmp_t(T         const & v) : _small(0), _big(NULL) {set(v);}
+		~real_gmp_t() {delete _big;}
+
+		bool is_small() const {return !_big;}
+		bool fits_sll() const {return !_big && _small < real_gmp_sll && _small > -real_gmp_sll;}
+
+		T get_big() const {return _big ? *_big : T(_small);}
+		double get_d() const {return _big ? _big->get_d() : _small;}
+		mpz_class get_mpz() const {return _big ? mpz_class(*_big) : mpz_class(_small);}
+
+		real_gmp_t & operator *= (real_gmp_t const & v);
+		real_gmp_t & operator /= (real_gmp_t const & v);
+		real_gmp_t & operator += (real_gmp_t const & v);
+		real_gmp_t & operator -= (real_gmp_t const & v);
+		real_gmp_t & operator  = (real_gmp_t const & v);
+
+		friend real_gmp_t abs(real_gmp_t const & x)
+		{
+			if (x._big) return real_gmp_t(T(abs(*x._big)));
+
+			return real_gmp_t(x._small < 0 ? -x._small : x._small);
+		}
+
+		friend int cmp(real_gmp_t const & l, real_gmp_t const & r)
+		{
+			if (l._big && r._big) return cmp(*l._big, *r._big);
+			if (l._big) return  cmp(*l._big, r._small);
+			if (r._big) return -cmp(*r._big, l._small);
+
+			if (l._small > r._small) return +1;
+			if (l._small < r._small) return -1;
+
+			return 0;
+		}
+
+		template <typename U> friend class real_gmp_t;
+
+	private:
+		// Makes _big from _small, for an operation that was not exact.
+		void grow() {if (!_big) _big = new T(_small);}
+
+		// Whether v can be a double, which is put in d if so.
+		static bool fits(T const & v, double & d);
+
+		void set(T const & v);
+
+		// Goes back to _small if _big can be a double.
+		void shrink();
+
+		double _small;
+
+		// Only used when the value is not exactly a double.
+		T * _big;
+};
+
+template <typename T>
+inline real_gmp_t<T> & real_gmp_t<T>::operator *= (real_gmp_t const & v)
+{
+	if (!_big && !v._big && real_gmp_mul(_small, v._small)) return *this;
+
+	grow();
+
+	if (v._big) *_big *= *v._big; else *_big *= T(v._small);
+
+	shrink();
+
+	return *this;
+}
+template <typename T>
+inline real_gmp_t<T> & real_gmp_t<T>::operator /= (real_gmp_t const & v)
+{
+	if (!_big && !v._big && real_gmp_div(_small, v._small)) return *this;
+
+	grow();
+
+	if (v._big) *_big /= *v._big; else *_big /= T(v._small);
+
+	shrink();
+
+	return *this;
+}
+template <typename T>
+inline real_gmp_t<T> & real_gmp_t<T>::operator += (real_gmp_t const & v)
+{
+	if (!_big && !v._big && real_gmp_add(_small, v._small)) return *this;
+
+	grow();
+
+	if (v._big) *_big += *v._big; else *_big += T(v._small);
+
+	shrink();
+
+	return *this;
+}
+template <typename T>
+inline real_gmp_t<T> & real_gmp_t<T>::operator -= (real_gmp_t const & v)
+{
+	if (!_big && !v._big && real_gmp_sub(_small, v._small)) return *this;
+
+	grow();
+
+	if (v._big) *_big -= *v._big; else *_big -= T(v._small);
+
+	shrink();
+
+	return *this;
+}
+template <typename T>
+inline real_gmp_t<T> & real_gmp_t<T>::operator = (real_gmp_t const & v)
+{
+	if (v._big) set(*v._big); else {delete _big; _big = NULL; _small = v._small;}
+
+	return *this;
+}
+#endif
 
 
 
@@ -51,12 +260,18 @@ class real_t
 		explicit real_t() : _data(0) {}
 		         real_t(real_t      const & v) : _data(v._data) {}
 		#if USE_GMPLIB
-		explicit real_t(mpf_class   const & v) : _data(v) {}
+		explicit real_t(int                    const & v) : _data(double(v)) {}
+		explicit real_t(long long int          const & v);
+		explicit real_t(double                 const & v) : _data(v) {}
+		explicit real_t(mpf_class              const & v) : _data(v) {}
+		explicit real_t(real_gmp_t<mpf_class> const & v) : _data(v) {}
+		explicit real_t(real_gmp_t<mpq_class> const & v) : _data(v) {}
 		#else
 		explicit real_t(long double const & v) : _data(v) {}
 		#endif
 
 		void encodeText(std::ostream & out);
+		void encodeText(TextWriter   & out);
 
 		long double makeFloat() const;
 		long long int makeInt() const;
@@ -91,7 +306,7 @@ class real_t
 
 	private:
 		#if USE_GMPLIB
-		mpf_class _data;
+		real_gmp_t<mpf_class> _data;
 		#else
 		long double _data;
 		#endif
@@ -103,12 +318,18 @@ class real_l_t
 		explicit real_l_t() : _data(0) {}
 		         real_l_t(real_l_t    const & v) : _data(v._data) {}
 		#if USE_GMPLIB
-		explicit real_l_t(mpq_class   const & v) : _data(v) {}
+		explicit real_l_t(int                    const & v) : _data(double(v)) {}
+		explicit real_l_t(long long int          const & v);
+		explicit real_l_t(double                 const & v) : _data(v) {}
+		explicit real_l_t(mpq_class              const & v) : _data(v) {}
+		explicit real_l_t(real_gmp_t<mpf_class> const & v) : _data(v) {}
+		explicit real_l_t(real_gmp_t<mpq_class> const & v) : _data(v) {}
 		#else
 		explicit real_l_t(long double const & v) : _data(v) {}
 		#endif
 
 		void encodeText(std::ostream & out);
+		void encodeText(TextWriter   & out);
 
 		long double makeFloat() const;
 		long long int makeInt() const;
@@ -143,7 +364,7 @@ class real_l_t
 
 	private:
 		#if USE_GMPLIB
-		mpq_class _data;
+		real_gmp_t<mpq_class> _data;
 		#else
 		long double _data;
 		#endif
@@ -206,7 +427,9 @@ real_l_t  tan(real_l_t const &);
 
 
 
+#if !USE_GMPLIB
 inline real_t   floor(real_t   const & x) {return real_t  (floor(x._data));}
+#endif
 
 inline real_t   hypot(real_t   const & x, real_t   const & y) {return sqrt((x*x) + (y*y));}
 inline real_l_t hypot(real_l_t const & x, real_l_t const & y) {return sqrt((x*x) + (y*y));}
@@ -233,7 +456,9 @@ inline real_l_t operator + (real_l_t const & l, real_l_t const & r) {return real
 inline real_t   operator - (real_t   const & l, real_t   const & r) {return real_t  (l) -= r;}
 inline real_l_t operator - (real_l_t const & l, real_l_t const & r) {return real_l_t(l) -= r;}
 
+#if !USE_GMPLIB
 inline real_t sqrt(real_t const & x) {return real_t(sqrt(x._data));}
+#endif
 
 
 
@@ -19,10 +19,13 @@
 
 /*
 	2010/05/04 - Original version.
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #include "string_t.hpp"
 
+#include "../TextWriter.hpp"
+
 
 
 string_t::string_t()                         : _data()           {}
@@ -68,6 +71,10 @@ void string_t::encodeText(std::ostream & out)
 
 	out.put('"');
 }
+void string_t::encodeText(TextWriter & out)
+{
+	out.writeQuoted(_data.data(), _data.size());
+}
 
 std::string const & string_t::makeString() const
 {
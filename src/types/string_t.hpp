@@ -19,6 +19,7 @@
 
 /*
 	2010/05/04 - Original version.
+	2026/10/17 - Added encodeText for TextWriter.
 */
 
 #ifndef STRING_T_H
@@ -27,6 +28,8 @@
 #include <ostream>
 #include <string>
 
+class TextWriter;
+
 
 
 class string_t
@@ -43,6 +46,7 @@ class string_t
 		bool empty() const;
 
 		void encodeText(std::ostream & out);
+		void encodeText(TextWriter   & out);
 
 		std::string const & makeString() const;
 